@@ -1,16 +1,16 @@
-#include <algorithm>
-#include <cctype>
+#include <atomic>
 #include <chrono>
 #include <cstdlib>
-#include <cstring>
-#include <functional>
+#include <string>
 #include <thread>
 
+#include <lib/libvirt.hpp>
 #include <lib/signal.hpp>
 #include <log/record.hpp>
+#include <registry/registry.hpp>
 
-#include "domain/domain.hpp"
 #include "pcpu/pcpu.hpp"
+#include "sys/scheduler.hpp"
 #include "vcpu/vcpu.hpp"
 
 #include "cpuman.hpp"
@@ -19,11 +19,15 @@
 // Global state required between load balancer iterations
 static libvirt::vCPU::table_t prev_vCPU_table;
 static util::stat::ulong_t    balancer_iteration = 0;
-    
 
 /**
  *  @brief Physical CPU Usage Manager
  *
+ *  @param parameters:  load balancer interval and failures allowed
+ *  @param connection:  hypervisor connection via libvirt
+ *  @param registry:    domain snapshot shared with other managers
+ *  @param exit signal: flag raised to stop the manager
+ *
  *  @details Operating systems running atop a hypervisor have virtualized 
  *  CPUs (vCPUs) mapped to physical hardware CPUs (pCPUs) which actually 
  *  execute task of and on the operating system.
@@ -35,94 +39,25 @@ static util::stat::ulong_t    balancer_iteration = 0;
  *  To balance the changing loads placed on any pCPU caused any or many of 
  *  changing loads of it's vCPUs, cpuman analyzes the spread of utilization
  *  amongst all pCPUs, and remaps vCPUs to pCPUs if necessary.
+ *
+ *  @return execution status code
  */
-int
-main(int argc, char *argv[])  
+manager::cpu::status_code
+manager::cpu::run
+(
+    const manager::cpu::parameters_t        &parameters,
+    const libvirt::connection_t             &connection,
+          libvirt::registry::registry_t     &registry,
+    const std::atomic<os::signal::signal_t> &exit_signal
+) noexcept
 {
-    /**************************** VALIDATE COMMAND ****************************/
-
-    // Command should be provided with single interval argument
-    if (argc != 2)
-    {
-        util::log::record
-        (
-            "Usage follows as ./cpuman <interval (ms)>", 
-            util::log::type::ABORT
-        );
-
-        return EXIT_FAILURE;
-    } 
-   
-    // Interval argument must be a positive integer
-    std::function<bool(const char *)> is_interval = [](const char *string) 
-    {
-        return std::all_of
-        (
-            string, string + std::strlen(string), 
-            [](unsigned char character) 
-            {
-                return std::isdigit(character);
-            }
-        );
-    };
-    if (!is_interval(argv[1]))
-    {
-        util::log::record
-        (
-            "Interval argument must be a positive integer", 
-            util::log::type::ABORT
-        );
-
-        return EXIT_FAILURE;
-    }
-    std::chrono::milliseconds interval(std::atoi(argv[1]));
-    
-
-    /********************** CONNECT TO VIRTUALIZATION HOST ********************/
-
-    // Make connection to hypervisor using libvirt
-    libvirt::connection_t connection
-    (
-        libvirt::virConnectOpen("qemu:///system"),
-        [](libvirt::virConnect *connection)
-        {
-            if (connection != nullptr)
-                libvirt::virConnectClose(connection);
-        }
-    );
-    if (connection == nullptr)
-    {
-        util::log::record
-        (
-            "Unable to make connection to QEMU", 
-            util::log::type::ABORT
-        );
-
-        return EXIT_FAILURE;
-    }
-
-
-    /************************* ASSIGN INTERRUPT HANDLER ***********************/
-
-    // Interrupt sets accessible exit flag
-    static os::signal::signal_t exit_signal = os::signal::SIG_DEF;
-    os::signal::signal
-    (
-        os::signal::SIG_INT,
-        [](os::signal::signal_t interrupt)
-        {
-            exit_signal = os::signal::SIG_EXT;
-        }
-    );
-
-    /************************** LAUNCH LOAD BALANCER **************************/
-
     // Run pCPU load balancer at every interval
-    util::stat::ulong_t failures = 0, maximum_failures = 3;
-    while (!static_cast<bool>(exit_signal))
+    util::stat::ulong_t failures = 0;
+    while (!static_cast<bool>(exit_signal.load()))
     {
         // Launch load balancer
-        manager::status_code status = manager::load_balancer(connection);
+        manager::cpu::status_code status 
+            = manager::cpu::load_balancer(connection, registry);
         if (static_cast<bool>(status))
         {
             util::log::record
@@ -134,7 +69,7 @@ main(int argc, char *argv[])
             );
             
             // Abort on too many failures
-            if (++failures >= maximum_failures)
+            if (++failures >= parameters.maximum_failures)
             {
                 util::log::record
                 (
@@ -148,7 +83,7 @@ main(int argc, char *argv[])
         }
         
         // Sleep until next interval
-        std::this_thread::sleep_for(interval);
+        std::this_thread::sleep_for(parameters.interval);
         ++balancer_iteration;
     }
 
@@ -160,6 +95,7 @@ main(int argc, char *argv[])
  *  @brief pCPU Load Balancer
  *
  *  @param connection: hypervisor connection via libvirt
+ *  @param registry:   domain snapshot shared with other managers
  *
  *  @details Balances pCPU loads from its vCPUs' demands by collecting data 
  *  about each domain and its vCPUs as well as data about hardware's active
@@ -168,20 +104,22 @@ main(int argc, char *argv[])
  *
  *  @return execution status code
  */
-manager::status_code
-static manager::load_balancer
+manager::cpu::status_code
+manager::cpu::load_balancer
 (
-    const libvirt::connection_t &connection
+    const libvirt::connection_t         &connection,
+          libvirt::registry::registry_t &registry
 ) noexcept
 {
     libvirt::status_code status;
 
     /*************************** DOMAIN INFORMATION ***************************/
 
-    // Get list of domains
+    // Get list of domains from this tick's snapshot
     libvirt::domain::table_t curr_domain_table;
-    status = libvirt::domain::table
+    status = libvirt::registry::acquire
     (
+        registry,
         connection, 
         curr_domain_table
     );
@@ -218,7 +156,7 @@ static manager::load_balancer
     }
 
     // Save and exit iteration if first
-    if (balancer_iteration == 0)
+    if (prev_vCPU_table.empty())
     {
         prev_vCPU_table = curr_vCPU_table;
 
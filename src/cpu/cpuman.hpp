@@ -1,18 +1,57 @@
 #pragma once
 
-#include <lib/libvirt.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 
-#include "sys/scheduler.hpp"
+#include <lib/libvirt.hpp>
+#include <lib/signal.hpp>
+#include <registry/registry.hpp>
+#include <stat/statistics.hpp>
 
 
+/**
+ *  @brief CPU Manager Header
+ *
+ *  @details Defines the pCPU load balancing module, run on its own by cpuman
+ *  or next to the memory manager by hypman
+ */
 namespace manager
 {
 
+namespace cpu
+{
+
+using status_code = std::uint8_t;
+
+// Tunables; load balancer runs every interval and gives up after as many
+// failures
+typedef struct parameters_t
+{
+    std::chrono::milliseconds interval = std::chrono::milliseconds(1000);
+    util::stat::ulong_t       maximum_failures = 3;
+} parameters_t;
+
+// Module routines
+[[nodiscard("CPU manager exit status must be checked")]]
+status_code
+run
+(
+    const parameters_t                      &parameters,
+    const libvirt::connection_t             &connection,
+          libvirt::registry::registry_t     &registry,
+    const std::atomic<os::signal::signal_t> &exit_signal
+) noexcept;
+
+// Single iteration of the module, run on its own when driving a backend
 [[nodiscard("Load balancer exit status must be checked")]]
-status_code 
-static load_balancer
+status_code
+load_balancer
 (
-    const libvirt::connection_t &connection
+    const libvirt::connection_t         &connection,
+          libvirt::registry::registry_t &registry
 ) noexcept;
 
+} // cpu namespace
+
 } // manager namespace
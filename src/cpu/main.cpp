@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+
+#include <lib/libvirt.hpp>
+#include <lib/signal.hpp>
+#include <log/record.hpp>
+#include <registry/registry.hpp>
+
+#include "cpuman.hpp"
+
+
+// Interrupt flag raised to stop manager
+static std::atomic<os::signal::signal_t> exit_signal = os::signal::SIG_DEF;
+
+
+/**
+ *  @brief Standalone CPU Manager
+ *
+ *  @details Runs the CPU manager module on its own connection, enumerating
+ *  domains every iteration; hypman runs it next to the memory manager
+ */
+int
+main(int argc, char *argv[])
+{
+    /**************************** VALIDATE COMMAND ****************************/
+
+    // Command should be provided with single interval argument
+    if (argc != 2)
+    {
+        util::log::record
+        (
+            "Usage follows as ./cpuman <interval (ms)>",
+            util::log::type::ABORT
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Interval argument must be a positive integer
+    std::function<bool(const char *)> is_interval = [](const char *string)
+    {
+        return std::all_of
+        (
+            string, string + std::strlen(string),
+            [](unsigned char character)
+            {
+                return std::isdigit(character);
+            }
+        );
+    };
+    if (!is_interval(argv[1]))
+    {
+        util::log::record
+        (
+            "Interval argument must be a positive integer",
+            util::log::type::ABORT
+        );
+
+        return EXIT_FAILURE;
+    }
+    manager::cpu::parameters_t parameters;
+    parameters.interval = std::chrono::milliseconds(std::atoi(argv[1]));
+
+
+    /********************** CONNECT TO VIRTUALIZATION HOST ********************/
+
+    // Make connection to hypervisor using libvirt
+    libvirt::connection_t connection
+    (
+        libvirt::virConnectOpen("qemu:///system"),
+        [](libvirt::virConnect *connection)
+        {
+            if (connection != nullptr)
+                libvirt::virConnectClose(connection);
+        }
+    );
+    if (connection == nullptr)
+    {
+        util::log::record
+        (
+            "Unable to make connection to QEMU",
+            util::log::type::ABORT
+        );
+
+        return EXIT_FAILURE;
+    }
+
+
+    /************************* ASSIGN INTERRUPT HANDLER ***********************/
+
+    // Interrupt sets accessible exit flag
+    os::signal::signal
+    (
+        os::signal::SIG_INT,
+        [](os::signal::signal_t /* interrupt */)
+        {
+            exit_signal.store(os::signal::SIG_EXT);
+        }
+    );
+
+
+    /*************************** LAUNCH CPU MANAGER ***************************/
+
+    // Domains are enumerated afresh every iteration
+    libvirt::registry::registry_t registry;
+
+    return manager::cpu::run(parameters, connection, registry, exit_signal);
+}
@@ -1,6 +1,8 @@
 #include <cstdlib>
+#include <new>
 #include <string>
 
+#include <backend/backend.hpp>
 #include <log/record.hpp>
 #include <stat/statistics.hpp>
 
@@ -26,12 +28,12 @@ libvirt::hardware::node_count
 {
     status_code status;
 
-    // Get hardware node handle
-    libvirt::hardware::node_t node;
-    status = libvirt::virNodeGetInfo
+    // Get hardware node information
+    libvirt::virNodeInfo node = {};
+    status = libvirt::backend::current().node_information
     (
         connection.get(),
-        node.get()
+        &node
     );
     if (static_cast<bool>(status))
     {
@@ -45,7 +47,7 @@ libvirt::hardware::node_count
     }
 
     // Get number of pCPUs in hardware
-    number_of_pCPUs = node.get()->cpus;
+    number_of_pCPUs = node.cpus;
     
     return EXIT_SUCCESS;
 }
@@ -70,8 +72,20 @@ libvirt::hardware::map
 {
     libvirt::status_code status;
 
-    // Create mapping
-    libvirt::hardware::mapping_t mapping;
+    // Create mapping with no pCPUs set
+    const util::stat::uint_t length
+        = libvirt::hardware::map_length(number_of_pCPUs);
+    libvirt::hardware::mapping_t mapping(new (std::nothrow) byte_t[length]());
+    if (mapping == nullptr || datum.pCPU_rank >= number_of_pCPUs)
+    {
+        util::log::record
+        (
+            "Unable to create map of pCPU " + std::to_string(datum.pCPU_rank),
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
     libvirt::hardware::map_to_pCPU
     (
         datum.pCPU_rank,
@@ -79,12 +93,12 @@ libvirt::hardware::map
     );
 
     // Execute mapping
-    status = libvirt::virDomainPinVcpu
+    status = libvirt::backend::current().pin
     (
         datum.domain.get(),
-        datum.vCPU_rank,
+        static_cast<util::stat::uint_t>(datum.vCPU_rank),
         mapping.get(), 
-        libvirt::hardware::map_length(number_of_pCPUs)
+        static_cast<util::stat::sint_t>(length)
     );
     if (static_cast<bool>(status))
     {
@@ -21,9 +21,8 @@ namespace hardware
 {
 
 // data types
-using node_t    = std::unique_ptr<virNodeInfo>;
 using byte_t    = unsigned char;
-using mapping_t = std::unique_ptr<byte_t>;
+using mapping_t = std::unique_ptr<byte_t[]>;
 
 // Data collection routines
 [[maybe_unused]]
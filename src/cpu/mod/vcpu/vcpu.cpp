@@ -2,10 +2,11 @@
 #include <cstdlib>
 #include <string>
 
+#include <backend/backend.hpp>
 #include <lib/libvirt.hpp>
 #include <log/record.hpp>
+#include <registry/registry.hpp>
 
-#include "domain/domain.hpp"
 #include "stat/statistics.hpp"
 
 #include "vcpu.hpp"
@@ -29,7 +30,7 @@ libvirt::vCPU::table
           libvirt::vCPU::table_t   &vCPU_table
 ) noexcept
 {
-    libvirt::status_code status;
+    const libvirt::backend::backend_t &backend = libvirt::backend::current();
 
     // Validate table is filled
     if (domain_table.empty())
@@ -48,7 +49,7 @@ libvirt::vCPU::table
     {
         // Get domain's number of vCPUs
         util::stat::sint_t number_of_vCPUs 
-            = libvirt::virDomainGetMaxVcpus(domain.get());
+            = backend.vCPUs_maximum(domain.get());
         if (number_of_vCPUs < 1)
         {
             util::log::record
@@ -63,8 +64,8 @@ libvirt::vCPU::table
             static_cast<std::size_t>(number_of_vCPUs)
         );
 
-        // Get domain's vCPUs' information
-        status = libvirt::virDomainGetVcpus
+        // Get domain's vCPUs' information; count returned on success
+        number_of_vCPUs = backend.vCPUs
         (
             domain.get(), 
             vCPU_list.data(),
@@ -72,7 +73,7 @@ libvirt::vCPU::table
             nullptr,
             libvirt::FLAG_DEF
         );
-        if (static_cast<bool>(status))
+        if (number_of_vCPUs < 1)
         {
             util::log::record
             (
@@ -80,7 +81,10 @@ libvirt::vCPU::table
                     + domain_uuid,
                 util::log::type::ERROR
             );
+
+            continue;
         }
+        vCPU_list.resize(static_cast<std::size_t>(number_of_vCPUs));
 
         // Add domain-id-vCPU-information key-value pair to table
         vCPU_table.emplace(domain_uuid, vCPU_list);
@@ -175,6 +179,10 @@ libvirt::vCPU::comparable_state
             diff.emplace(curr_domain_uuid);
     }
 
+    // New domains require another iteration
+    if (diff_number_of_domains)
+        return libvirt::vCPU::table_diff_t(false, {});
+
     // A filled diff set requires a note
     if (!diff.empty())
     {
@@ -292,13 +300,16 @@ libvirt::vCPU::data
                 usage_time_norm = 0;
             }
 
-            // Set data and move over domain control to data
+            // Set data with a domain reference of its own per vCPU
             curr_vCPU_data.emplace_back
             (
                 curr_vCPU_info.number,
                 curr_vCPU_info.cpu,
                 curr_domain_uuid,
-                std::move(curr_domain_table[curr_domain_uuid]),
+                libvirt::domain::reference
+                (
+                    curr_domain_table[curr_domain_uuid].get()
+                ),
                 usage_time_norm
             );
         }
@@ -8,8 +8,7 @@
 #include <vector>
 
 #include <lib/libvirt.hpp>
-
-#include "domain/domain.hpp"
+#include <registry/registry.hpp>
 
 
 /**
@@ -99,7 +99,7 @@ manager::scheduler
     )
     {
         util::stat::ulong_t usage_A = datum_A.usage_time;
-        util::stat::ulong_t usage_B = datum_A.usage_time;
+        util::stat::ulong_t usage_B = datum_B.usage_time;
 
         if (usage_A < usage_B)
             return true;
@@ -128,6 +128,8 @@ manager::scheduler
     // usage time to pCPUs from lowest to highest usage time
     std::size_t number_of_pCPUs = curr_pCPU_data.size();
     libvirt::pCPU::data_t pred_pCPU_data(number_of_pCPUs); 
+    for (libvirt::pCPU::rank_t rank = 0; rank < number_of_pCPUs; ++rank)
+        pred_pCPU_data[rank].pCPU_rank = rank;
     
     // When pCPU set size greater than reasonable cache, it's faster to search 
     // with a minimum heap rather than a linear search on an array 
@@ -239,6 +241,9 @@ manager::scheduler
     for (const libvirt::vCPU::datum_t &datum: curr_vCPU_data)
     {
         status = libvirt::hardware::map(datum, number_of_pCPUs);
+        if (!static_cast<bool>(status))
+            continue;
+
         util::log::record
         (
             "Error incurred while remapping vCPUs to pCPUs; will continue "
@@ -0,0 +1,82 @@
+#include <utility>
+
+#include <lib/libvirt.hpp>
+
+#include "backend.hpp"
+
+
+/**
+ *  @brief Installed Backend
+ *
+ *  @details Native backend unless another was installed
+ *
+ *  @return backend reference to call through or install into
+ */
+static libvirt::backend::backend_t &
+installed() noexcept
+{
+    static libvirt::backend::backend_t backend = libvirt::backend::native();
+
+    return backend;
+}
+
+
+/**
+ *  @brief Native Backend Builder
+ *
+ *  @details Calls straight through to libvirt
+ *
+ *  @return backend calling libvirt
+ */
+libvirt::backend::backend_t
+libvirt::backend::native() noexcept
+{
+    libvirt::backend::backend_t backend;
+
+    backend.list_domains           = libvirt::virConnectListAllDomains;
+    backend.uuid                   = libvirt::virDomainGetUUIDString;
+    backend.reference              = libvirt::virDomainRef;
+    backend.release                = libvirt::virDomainFree;
+    backend.node_information       = libvirt::virNodeGetInfo;
+    backend.node_memory_statistics = libvirt::virNodeGetMemoryStats;
+    backend.vCPUs_maximum          = libvirt::virDomainGetMaxVcpus;
+    backend.vCPUs                  = libvirt::virDomainGetVcpus;
+    backend.pin                    = libvirt::virDomainPinVcpu;
+    backend.numa_parameters        = libvirt::virDomainGetNumaParameters;
+    backend.memory_statistics      = libvirt::virDomainMemoryStats;
+    backend.information            = libvirt::virDomainGetInfo;
+    backend.statistics_period      = libvirt::virDomainSetMemoryStatsPeriod;
+    backend.balloon                = libvirt::virDomainSetMemory;
+
+    return backend;
+}
+
+
+/**
+ *  @brief Current Backend
+ *
+ *  @return backend collection and actuation calls are made through
+ */
+const libvirt::backend::backend_t &
+libvirt::backend::current() noexcept
+{
+    return installed();
+}
+
+
+/**
+ *  @brief Backend Installer
+ *
+ *  @param backend: backend to make calls through from now on
+ *
+ *  @details Must be installed before either manager starts, as calls in
+ *  flight are not waited on
+ */
+void
+libvirt::backend::install
+(
+    libvirt::backend::backend_t backend
+) noexcept
+{
+    installed() = std::move(backend);
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <functional>
+
+#include <lib/libvirt.hpp>
+#include <stat/statistics.hpp>
+
+
+/**
+ *  @brief Hypervisor Backend Header
+ *
+ *  @details Defines the hypervisor calls both managers collect and actuate
+ *  through, such that a host other than libvirt's may stand in for it
+ */
+namespace libvirt
+{
+
+namespace backend
+{
+
+// Hypervisor calls, following the libvirt calls they stand in for; domain
+// handles are opaque to the managers and only passed back to the backend
+typedef struct backend_t
+{
+    // Domain enumeration and handle references
+    std::function
+    <
+        util::stat::sint_t (virConnectPtr, virDomainPtr **, util::stat::uint_t)
+    > list_domains;
+    std::function<util::stat::sint_t (virDomainPtr, char *)> uuid;
+    std::function<util::stat::sint_t (virDomainPtr)>         reference;
+    std::function<util::stat::sint_t (virDomainPtr)>         release;
+
+    // Host information
+    std::function
+    <
+        util::stat::sint_t (virConnectPtr, virNodeInfo *)
+    > node_information;
+    std::function
+    <
+        util::stat::sint_t
+        (
+            virConnectPtr, util::stat::sint_t, virNodeMemoryStats *,
+            util::stat::sint_t *, util::stat::uint_t
+        )
+    > node_memory_statistics;
+
+    // vCPU information and pinning
+    std::function<util::stat::sint_t (virDomainPtr)> vCPUs_maximum;
+    std::function
+    <
+        util::stat::sint_t
+        (
+            virDomainPtr, virVcpuInfo *, util::stat::sint_t,
+            unsigned char *, util::stat::sint_t
+        )
+    > vCPUs;
+    std::function
+    <
+        util::stat::sint_t
+        (
+            virDomainPtr, util::stat::uint_t, unsigned char *,
+            util::stat::sint_t
+        )
+    > pin;
+
+    // NUMA tunables
+    std::function
+    <
+        util::stat::sint_t
+        (
+            virDomainPtr, virTypedParameterPtr, util::stat::sint_t *,
+            util::stat::uint_t
+        )
+    > numa_parameters;
+
+    // Memory statistics and balloon
+    std::function
+    <
+        util::stat::sint_t
+        (
+            virDomainPtr, virDomainMemoryStatStruct *, util::stat::uint_t,
+            util::stat::uint_t
+        )
+    > memory_statistics;
+    std::function
+    <
+        util::stat::sint_t (virDomainPtr, virDomainInfo *)
+    > information;
+    std::function
+    <
+        util::stat::sint_t
+        (
+            virDomainPtr, util::stat::sint_t, util::stat::uint_t
+        )
+    > statistics_period;
+    std::function
+    <
+        util::stat::sint_t (virDomainPtr, util::stat::ulong_t)
+    > balloon;
+} backend_t;
+
+// Backend routines
+[[nodiscard("Native backend must be installed to be used")]]
+backend_t
+native() noexcept;
+
+[[nodiscard("Backend calls must be made through")]]
+const backend_t &
+current() noexcept;
+
+void
+install
+(
+    backend_t backend
+) noexcept;
+
+} // backend namespace
+
+} // libvirt namespace
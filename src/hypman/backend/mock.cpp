@@ -0,0 +1,529 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <lib/libvirt.hpp>
+#include <log/record.hpp>
+#include <stat/statistics.hpp>
+
+#include "backend.hpp"
+#include "mock.hpp"
+
+
+// Guest page size faults are counted in; memory in KiB
+static constexpr util::stat::ulong_t PAGE_SIZE = 4;
+
+
+/**
+ *  @brief Simulated Domain Lookup
+ *
+ *  @param handle: handle handed out for the domain
+ *
+ *  @return simulated domain, or nullptr for an empty handle
+ */
+static libvirt::mock::domain_t *
+lookup
+(
+    libvirt::virDomainPtr handle
+) noexcept
+{
+    return reinterpret_cast<libvirt::mock::domain_t *>(handle);
+}
+
+
+/**
+ *  @brief Mock Host Creator
+ *
+ *  @param host:       structure reference to write to
+ *  @param parameters: host tunables and load script
+ *
+ *  @details Creates every domain with its initial balloon and spreads vCPUs
+ *  over pCPUs in turn, then runs the script's first step; without a script
+ *  each domain steadily uses half its initial memory and half of each pCPU
+ *  its vCPUs are on. Host memory left at zero fits every domain's limit.
+ *
+ *  @return execution status code
+ */
+libvirt::mock::status_code
+libvirt::mock::create
+(
+          libvirt::mock::host_t       &host,
+    const libvirt::mock::parameters_t &parameters
+) noexcept
+{
+    if (parameters.number_of_domains == 0 || parameters.number_of_pCPUs == 0
+        || parameters.number_of_vCPUs == 0
+        || parameters.initial_memory > parameters.memory_limit)
+    {
+        util::log::record
+        (
+            "Mock host needs domains, pCPUs and vCPUs with initial memory "
+            "within the domain memory limit",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        host.parameters = parameters;
+        if (host.parameters.host_memory == 0)
+        {
+            host.parameters.host_memory
+                = parameters.memory_limit * parameters.number_of_domains;
+        }
+        if (!host.parameters.script)
+        {
+            const util::stat::ulong_t memory_used
+                = parameters.initial_memory / 2;
+            host.parameters.script
+                = [memory_used](std::size_t, util::stat::ulong_t)
+            {
+                return libvirt::mock::load_t{memory_used, 0.5};
+            };
+        }
+
+        // Domains are never moved, as their addresses are their handles
+        host.domains = std::vector<libvirt::mock::domain_t>
+        (
+            parameters.number_of_domains
+        );
+        std::size_t pCPU = 0;
+        for (std::size_t rank = 0; rank < host.domains.size(); ++rank)
+        {
+            libvirt::mock::domain_t &domain = host.domains[rank];
+
+            char uuid[VIR_UUID_STRING_BUFLEN];
+            std::snprintf
+            (
+                uuid, sizeof(uuid), "00000000-0000-4000-8000-%012llx",
+                static_cast<unsigned long long>(rank & 0xffffffffffff)
+            );
+            domain.uuid    = std::string(uuid);
+            domain.balloon = parameters.initial_memory;
+            domain.pinning.resize(parameters.number_of_vCPUs);
+            domain.cpu_times.resize(parameters.number_of_vCPUs, 0);
+            for (util::stat::sint_t &pinning: domain.pinning)
+            {
+                pinning = static_cast<util::stat::sint_t>(pCPU);
+                pCPU = (pCPU + 1) % parameters.number_of_pCPUs;
+            }
+        }
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Unable to allocate mock host",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    host.step = 0;
+    libvirt::mock::advance(host);
+
+    return EXIT_SUCCESS;
+}
+
+
+/**
+ *  @brief Mock Host Stepper
+ *
+ *  @param host: host to step
+ *
+ *  @details Applies the script's load for the next step. Domains using more
+ *  than their balloon swap and fault the shortfall in, and vCPUs accrue CPU
+ *  time for their share of the step period.
+ */
+void
+libvirt::mock::advance
+(
+    libvirt::mock::host_t &host
+) noexcept
+{
+    using std::chrono::nanoseconds;
+
+    const std::double_t step_time = static_cast<std::double_t>
+    (
+        std::chrono::duration_cast<nanoseconds>
+        (
+            host.parameters.step_period
+        ).count()
+    );
+    for (std::size_t rank = 0; rank < host.domains.size(); ++rank)
+    {
+        const libvirt::mock::load_t load
+            = host.parameters.script(rank, host.step);
+
+        libvirt::mock::domain_t &domain = host.domains[rank];
+        std::lock_guard<std::mutex> lock(domain.mutex);
+
+        domain.memory_used = load.memory_used;
+        if (domain.memory_used > domain.balloon)
+        {
+            const util::stat::ulong_t shortfall
+                = domain.memory_used - domain.balloon;
+
+            domain.swap_in      += shortfall;
+            domain.major_faults += shortfall / PAGE_SIZE;
+        }
+
+        const std::double_t share = std::clamp(load.cpu_share, 0.0, 1.0);
+        for (util::stat::ulong_t &cpu_time: domain.cpu_times)
+            cpu_time += static_cast<util::stat::ulong_t>(share * step_time);
+    }
+    ++host.step;
+}
+
+
+/**
+ *  @brief Mock Backend Builder
+ *
+ *  @param host: host calls are answered from; must outlive the backend
+ *
+ *  @details Answers calls the way libvirt would for running domains. Handles
+ *  stay valid for the host's lifetime, so references are not counted, and
+ *  connections are ignored.
+ *
+ *  @return backend answering from host
+ */
+libvirt::backend::backend_t
+libvirt::mock::backend
+(
+    libvirt::mock::host_t &host
+) noexcept
+{
+    libvirt::backend::backend_t backend;
+    libvirt::mock::host_t *mock = &host;
+
+    // Domain enumeration and handle references
+    backend.list_domains = [mock]
+    (
+        libvirt::virConnectPtr,
+        libvirt::virDomainPtr **domains,
+        util::stat::uint_t
+    ) -> util::stat::sint_t
+    {
+        ++mock->calls;
+
+        const std::size_t number_of_domains = mock->domains.size();
+        *domains = static_cast<libvirt::virDomainPtr *>
+        (
+            std::malloc(number_of_domains * sizeof(libvirt::virDomainPtr))
+        );
+        if (*domains == nullptr)
+            return -1;
+
+        for (std::size_t rank = 0; rank < number_of_domains; ++rank)
+        {
+            (*domains)[rank]
+                = reinterpret_cast<libvirt::virDomainPtr>(&mock->domains[rank]);
+        }
+
+        return static_cast<util::stat::sint_t>(number_of_domains);
+    };
+    backend.uuid = [mock]
+    (
+        libvirt::virDomainPtr handle,
+        char                 *uuid
+    ) -> util::stat::sint_t
+    {
+        ++mock->calls;
+
+        const libvirt::mock::domain_t *domain = lookup(handle);
+        if (domain == nullptr)
+            return -1;
+
+        std::snprintf(uuid, VIR_UUID_STRING_BUFLEN, "%s", domain->uuid.c_str());
+
+        return 0;
+    };
+    backend.reference = [](libvirt::virDomainPtr handle) -> util::stat::sint_t
+    {
+        return handle == nullptr ? -1 : 0;
+    };
+    backend.release = [](libvirt::virDomainPtr handle) -> util::stat::sint_t
+    {
+        return handle == nullptr ? -1 : 0;
+    };
+
+    // Host information
+    backend.node_information = [mock]
+    (
+        libvirt::virConnectPtr,
+        libvirt::virNodeInfo *information
+    ) -> util::stat::sint_t
+    {
+        ++mock->calls;
+
+        *information        = {};
+        information->cpus   = static_cast<util::stat::uint_t>
+        (
+            mock->parameters.number_of_pCPUs
+        );
+        information->memory = static_cast<unsigned long>
+        (
+            mock->parameters.host_memory
+        );
+        information->nodes  = 1;
+
+        return 0;
+    };
+    backend.node_memory_statistics = [mock]
+    (
+        libvirt::virConnectPtr,
+        util::stat::sint_t,
+        libvirt::virNodeMemoryStats *statistics,
+        util::stat::sint_t          *number_of_statistics,
+        util::stat::uint_t
+    ) -> util::stat::sint_t
+    {
+        ++mock->calls;
+
+        // Count asked for first
+        if (statistics == nullptr)
+        {
+            *number_of_statistics = 2;
+            return 0;
+        }
+        if (*number_of_statistics < 2)
+            return -1;
+
+        util::stat::ulong_t used = 0;
+        for (libvirt::mock::domain_t &domain: mock->domains)
+        {
+            std::lock_guard<std::mutex> lock(domain.mutex);
+            used += domain.balloon;
+        }
+        const util::stat::ulong_t total = mock->parameters.host_memory;
+
+        std::snprintf
+        (
+            statistics[0].field, VIR_NODE_MEMORY_STATS_FIELD_LENGTH, "%s",
+            VIR_NODE_MEMORY_STATS_TOTAL
+        );
+        statistics[0].value = total;
+        std::snprintf
+        (
+            statistics[1].field, VIR_NODE_MEMORY_STATS_FIELD_LENGTH, "%s",
+            VIR_NODE_MEMORY_STATS_FREE
+        );
+        statistics[1].value = used < total ? total - used : 0;
+        *number_of_statistics = 2;
+
+        return 0;
+    };
+
+    // vCPU information and pinning
+    backend.vCPUs_maximum = [mock]
+    (
+        libvirt::virDomainPtr handle
+    ) -> util::stat::sint_t
+    {
+        ++mock->calls;
+
+        if (lookup(handle) == nullptr)
+            return -1;
+
+        return static_cast<util::stat::sint_t>
+        (
+            mock->parameters.number_of_vCPUs
+        );
+    };
+    backend.vCPUs = [mock]
+    (
+        libvirt::virDomainPtr  handle,
+        libvirt::virVcpuInfo  *information,
+        util::stat::sint_t     maximum_information,
+        unsigned char         *,
+        util::stat::sint_t
+    ) -> util::stat::sint_t
+    {
+        ++mock->calls;
+
+        libvirt::mock::domain_t *domain = lookup(handle);
+        if (domain == nullptr || maximum_information < 0)
+            return -1;
+
+        std::lock_guard<std::mutex> lock(domain->mutex);
+        const std::size_t number_of_vCPUs = std::min
+        (
+            domain->pinning.size(),
+            static_cast<std::size_t>(maximum_information)
+        );
+        for (std::size_t rank = 0; rank < number_of_vCPUs; ++rank)
+        {
+            information[rank].number  = static_cast<util::stat::uint_t>(rank);
+            information[rank].state   = VIR_VCPU_RUNNING;
+            information[rank].cpuTime = domain->cpu_times[rank];
+            information[rank].cpu     = domain->pinning[rank];
+        }
+
+        return static_cast<util::stat::sint_t>(number_of_vCPUs);
+    };
+    backend.pin = [mock]
+    (
+        libvirt::virDomainPtr  handle,
+        util::stat::uint_t     vCPU,
+        unsigned char         *map,
+        util::stat::sint_t     map_length
+    ) -> util::stat::sint_t
+    {
+        ++mock->calls;
+
+        libvirt::mock::domain_t *domain = lookup(handle);
+        if (domain == nullptr || map == nullptr || map_length < 1)
+            return -1;
+
+        // Pin to first pCPU of map
+        std::size_t pCPU = 0;
+        const std::size_t number_of_bits
+            = static_cast<std::size_t>(map_length) * 8;
+        while (pCPU < number_of_bits && !(map[pCPU / 8] & (1 << pCPU % 8)))
+            ++pCPU;
+        if (pCPU >= mock->parameters.number_of_pCPUs)
+            return -1;
+
+        std::lock_guard<std::mutex> lock(domain->mutex);
+        if (vCPU >= domain->pinning.size())
+            return -1;
+
+        domain->pinning[vCPU] = static_cast<util::stat::sint_t>(pCPU);
+        ++mock->pins;
+
+        return 0;
+    };
+
+    // NUMA tunables; domains have no numatune
+    backend.numa_parameters = [mock]
+    (
+        libvirt::virDomainPtr          handle,
+        libvirt::virTypedParameterPtr,
+        util::stat::sint_t            *number_of_parameters,
+        util::stat::uint_t
+    ) -> util::stat::sint_t
+    {
+        ++mock->calls;
+
+        if (lookup(handle) == nullptr || number_of_parameters == nullptr)
+            return -1;
+
+        *number_of_parameters = 0;
+
+        return 0;
+    };
+
+    // Memory statistics and balloon
+    backend.memory_statistics = [mock]
+    (
+        libvirt::virDomainPtr               handle,
+        libvirt::virDomainMemoryStatStruct *statistics,
+        util::stat::uint_t                  number_of_statistics,
+        util::stat::uint_t
+    ) -> util::stat::sint_t
+    {
+        ++mock->calls;
+
+        libvirt::mock::domain_t *domain = lookup(handle);
+        if (domain == nullptr)
+            return -1;
+
+        std::lock_guard<std::mutex> lock(domain->mutex);
+        const util::stat::ulong_t unused = domain->balloon > domain->memory_used
+            ? domain->balloon - domain->memory_used
+            : 0;
+        const libvirt::virDomainMemoryStatStruct reported[] =
+        {
+            {VIR_DOMAIN_MEMORY_STAT_ACTUAL_BALLOON, domain->balloon},
+            {VIR_DOMAIN_MEMORY_STAT_UNUSED,         unused},
+            {VIR_DOMAIN_MEMORY_STAT_USABLE,         unused},
+            {
+                VIR_DOMAIN_MEMORY_STAT_RSS,
+                std::min(domain->balloon, domain->memory_used)
+            },
+            {VIR_DOMAIN_MEMORY_STAT_SWAP_IN,        domain->swap_in},
+            {VIR_DOMAIN_MEMORY_STAT_MAJOR_FAULT,    domain->major_faults}
+        };
+
+        const std::size_t number_reported = std::min
+        (
+            sizeof(reported) / sizeof(reported[0]),
+            static_cast<std::size_t>(number_of_statistics)
+        );
+        std::copy(reported, reported + number_reported, statistics);
+
+        return static_cast<util::stat::sint_t>(number_reported);
+    };
+    backend.information = [mock]
+    (
+        libvirt::virDomainPtr  handle,
+        libvirt::virDomainInfo *information
+    ) -> util::stat::sint_t
+    {
+        ++mock->calls;
+
+        libvirt::mock::domain_t *domain = lookup(handle);
+        if (domain == nullptr)
+            return -1;
+
+        std::lock_guard<std::mutex> lock(domain->mutex);
+        *information           = {};
+        information->state     = VIR_DOMAIN_RUNNING;
+        information->maxMem    = static_cast<unsigned long>
+        (
+            mock->parameters.memory_limit
+        );
+        information->memory    = static_cast<unsigned long>(domain->balloon);
+        information->nrVirtCpu = static_cast<unsigned short>
+        (
+            domain->pinning.size()
+        );
+        for (const util::stat::ulong_t cpu_time: domain->cpu_times)
+            information->cpuTime += cpu_time;
+
+        return 0;
+    };
+    backend.statistics_period = [mock]
+    (
+        libvirt::virDomainPtr handle,
+        util::stat::sint_t    period,
+        util::stat::uint_t
+    ) -> util::stat::sint_t
+    {
+        ++mock->calls;
+
+        return lookup(handle) == nullptr || period < 0 ? -1 : 0;
+    };
+    backend.balloon = [mock]
+    (
+        libvirt::virDomainPtr handle,
+        util::stat::ulong_t   memory
+    ) -> util::stat::sint_t
+    {
+        ++mock->calls;
+
+        libvirt::mock::domain_t *domain = lookup(handle);
+        if (domain == nullptr || memory > mock->parameters.memory_limit)
+            return -1;
+
+        std::lock_guard<std::mutex> lock(domain->mutex);
+        domain->balloon = memory;
+        ++mock->balloons;
+
+        return 0;
+    };
+
+    return backend;
+}
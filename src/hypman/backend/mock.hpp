@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <lib/libvirt.hpp>
+#include <stat/statistics.hpp>
+
+#include "backend.hpp"
+
+
+/**
+ *  @brief Mock Hypervisor Header
+ *
+ *  @details Defines an in-process host of simulated domains installed as
+ *  the hypervisor backend, such that both managers can be run end to end at
+ *  scale without real guests
+ */
+namespace libvirt
+{
+
+namespace mock
+{
+
+using status_code = std::uint8_t;
+
+// Load a domain places on the host at a step; memory in KiB, and share of a
+// pCPU each of its vCPUs keeps busy
+typedef struct load_t
+{
+    util::stat::ulong_t memory_used = 0;
+    std::double_t       cpu_share   = 0.0;
+} load_t;
+
+// Scripted load of a domain by its rank at a step
+using script_t = std::function
+<
+    load_t (std::size_t domain_rank, util::stat::ulong_t step)
+>;
+
+// Tunables; memory in KiB, and each step lasts the step period of CPU time
+typedef struct parameters_t
+{
+    std::size_t               number_of_domains = 10000;
+    std::size_t               number_of_pCPUs   = 256;
+    util::stat::uint_t        number_of_vCPUs   = 2;
+    util::stat::ulong_t       memory_limit      = 4 << 20;
+    util::stat::ulong_t       initial_memory    = 2 << 20;
+    util::stat::ulong_t       host_memory       = 0;
+    std::chrono::milliseconds step_period = std::chrono::milliseconds(1000);
+    script_t                  script;
+} parameters_t;
+
+// Simulated domain; its address is the handle handed to the managers
+typedef struct domain_t
+{
+    std::mutex                       mutex;
+    std::string                      uuid;
+    util::stat::ulong_t              balloon      = 0;
+    util::stat::ulong_t              memory_used  = 0;
+    util::stat::ulong_t              swap_in      = 0;
+    util::stat::ulong_t              major_faults = 0;
+    std::vector<util::stat::sint_t>  pinning;
+    std::vector<util::stat::ulong_t> cpu_times;
+} domain_t;
+
+// Simulated host and counts of calls made on it
+typedef struct host_t
+{
+    parameters_t                     parameters;
+    std::vector<domain_t>            domains;
+    util::stat::ulong_t              step = 0;
+    std::atomic<util::stat::ulong_t> calls    = 0;
+    std::atomic<util::stat::ulong_t> pins     = 0;
+    std::atomic<util::stat::ulong_t> balloons = 0;
+} host_t;
+
+// Host routines
+[[nodiscard("Mock host creation status must be checked")]]
+status_code
+create
+(
+          host_t       &host,
+    const parameters_t &parameters
+) noexcept;
+
+void
+advance
+(
+    host_t &host
+) noexcept;
+
+[[nodiscard("Mock backend must be installed to be used")]]
+backend::backend_t
+backend
+(
+    host_t &host
+) noexcept;
+
+} // mock namespace
+
+} // libvirt namespace
@@ -0,0 +1,213 @@
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <string>
+#include <thread>
+
+#include <lib/libvirt.hpp>
+#include <lib/signal.hpp>
+#include <log/record.hpp>
+#include <registry/registry.hpp>
+
+#include "cpuman.hpp"
+#include "memoryman.hpp"
+
+
+// Flag raised on interrupt, or by either manager aborting to stop the other
+static std::atomic<os::signal::signal_t> exit_signal = os::signal::SIG_DEF;
+
+
+/**
+ *  @brief Hypervisor Manager
+ *
+ *  @details Runs the CPU and memory managers as modules on threads of their
+ *  own within one process. Both share a single hypervisor connection, and
+ *  a domain registry enumerating domains once per tick, the shorter of the
+ *  two intervals, rather than once per manager iteration.
+ *
+ *  Either manager aborting stops the other, such that the daemon fails as
+ *  one and is restarted as one.
+ */
+int
+main(int argc, char *argv[])
+{
+    /**************************** VALIDATE COMMAND ****************************/
+
+    // Command should be provided with intervals and optional configuration
+    if (argc != 3 && argc != 4)
+    {
+        util::log::record
+        (
+            "Usage follows as ./hypman <CPU interval (ms)> "
+            "<memory interval (ms)> [configuration]",
+            util::log::type::ABORT
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Interval arguments must be positive integers of milliseconds within
+    // range of an interval; signs and whitespace are not accepted
+    using interval_t = std::chrono::milliseconds;
+    std::function<bool(const char *, interval_t &)> parse_interval 
+        = [](const char *string, interval_t &interval)
+    {
+        const bool digits = *string != '\0' && std::all_of
+        (
+            string, string + std::strlen(string),
+            [](unsigned char character)
+            {
+                return std::isdigit(character);
+            }
+        );
+        if (!digits)
+            return false;
+
+        char *end = nullptr;
+        errno = 0;
+        const unsigned long value = std::strtoul(string, &end, 10);
+        if (errno == ERANGE || *end != '\0' || value == 0
+            || value > static_cast<unsigned long>
+               (
+                   std::numeric_limits<interval_t::rep>::max()
+               ))
+            return false;
+
+        interval = interval_t(value);
+
+        return true;
+    };
+    manager::cpu::parameters_t    cpu_parameters;
+    manager::memory::parameters_t memory_parameters;
+    if (!parse_interval(argv[1], cpu_parameters.interval) 
+        || !parse_interval(argv[2], memory_parameters.interval))
+    {
+        util::log::record
+        (
+            "Interval arguments must be positive integers",
+            util::log::type::ABORT
+        );
+
+        return EXIT_FAILURE;
+    }
+    if (argc == 4)
+        memory_parameters.configuration = std::string(argv[3]);
+
+    manager::memory::status_code status
+        = manager::memory::configure(memory_parameters);
+    if (static_cast<bool>(status))
+        return EXIT_FAILURE;
+
+
+    /********************** CONNECT TO VIRTUALIZATION HOST ********************/
+
+    // Make single connection to hypervisor shared by both managers
+    libvirt::connection_t connection
+    (
+        libvirt::virConnectOpen("qemu:///system"),
+        [](libvirt::virConnect *connection)
+        {
+            if (connection != nullptr)
+                libvirt::virConnectClose(connection);
+        }
+    );
+    if (connection == nullptr)
+    {
+        util::log::record
+        (
+            "Unable to make connection to QEMU",
+            util::log::type::ABORT
+        );
+
+        return EXIT_FAILURE;
+    }
+
+
+    /************************* ASSIGN INTERRUPT HANDLER ***********************/
+
+    // Interrupt sets accessible exit flag
+    os::signal::signal
+    (
+        os::signal::SIG_INT,
+        [](os::signal::signal_t /* interrupt */)
+        {
+            exit_signal.store(os::signal::SIG_EXT);
+        }
+    );
+
+
+    /**************************** LAUNCH MANAGERS *****************************/
+
+    // Snapshot serves both managers within half the shorter interval, so
+    // managers on one interval share every enumeration
+    libvirt::registry::registry_t registry;
+    registry.maximum_age
+        = std::min(cpu_parameters.interval, memory_parameters.interval) / 2;
+
+    std::atomic<manager::cpu::status_code>    cpu_status    = EXIT_SUCCESS;
+    std::atomic<manager::memory::status_code> memory_status = EXIT_SUCCESS;
+    std::thread cpu_manager, memory_manager;
+    try
+    {
+        cpu_manager = std::thread
+        (
+            [&]()
+            {
+                cpu_status = manager::cpu::run
+                (
+                    cpu_parameters, connection, registry, exit_signal
+                );
+                if (static_cast<bool>(cpu_status.load()))
+                    exit_signal.store(os::signal::SIG_EXT);
+            }
+        );
+        memory_manager = std::thread
+        (
+            [&]()
+            {
+                memory_status = manager::memory::run
+                (
+                    memory_parameters, connection, registry, exit_signal
+                );
+                if (static_cast<bool>(memory_status.load()))
+                    exit_signal.store(os::signal::SIG_EXT);
+            }
+        );
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Unable to launch manager threads",
+            util::log::type::ABORT
+        );
+
+        exit_signal.store(os::signal::SIG_EXT);
+        if (cpu_manager.joinable())
+            cpu_manager.join();
+
+        return EXIT_FAILURE;
+    }
+    cpu_manager.join();
+    memory_manager.join();
+
+    util::log::record
+    (
+        "Managers stopped after " + std::to_string(registry.snapshots)
+            + " domain enumerations for "
+            + std::to_string(registry.acquisitions) + " acquisitions"
+    );
+    if (static_cast<bool>(cpu_status.load())
+        || static_cast<bool>(memory_status.load()))
+        return EXIT_FAILURE;
+
+    return EXIT_SUCCESS;
+}
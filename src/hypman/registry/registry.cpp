@@ -0,0 +1,207 @@
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <backend/backend.hpp>
+#include <lib/libvirt.hpp>
+#include <log/record.hpp>
+#include <stat/statistics.hpp>
+
+#include "registry.hpp"
+
+
+/**
+ *  @brief Domain ID to Domain Handle Table Producer
+ *
+ *  @param connection:   hypervisor connection via libvirt
+ *  @param domain table: structure reference to write to
+ *
+ *  @details Creates a table mapping universally unique identifiers (uuid)
+ *  of a domain to it's associated libvirt API domain handle
+ *
+ *  @return execution status code
+ */
+libvirt::status_code
+libvirt::domain::table
+(
+    const libvirt::connection_t    &connection,
+          libvirt::domain::table_t &domain_table
+) noexcept
+{
+    const libvirt::backend::backend_t &backend = libvirt::backend::current();
+
+    // Use hypervisor backend to get the collection of domains
+    libvirt::virDomain **domains = nullptr;
+    util::stat::sint_t number_of_domains = backend.list_domains
+    (
+        connection.get(), &domains,
+        libvirt::domain::domains_active_running_flag
+    );
+    if (number_of_domains < 0)
+    {
+        util::log::record
+        (
+            "Unable to retrieve domain data through libvirt API",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Transfer control of domain handles to table structure paired to uuids
+    for
+    (
+        libvirt::domain::rank_t rank = 0;
+        rank < static_cast<libvirt::domain::rank_t>(number_of_domains);
+        ++rank
+    )
+    {
+        // Get UUID defined by libvirt
+        char uuid[libvirt::domain::uuid_length];
+        libvirt::status_code status = backend.uuid(domains[rank], uuid);
+        if (static_cast<bool>(status))
+        {
+            util::log::record
+            (
+                "Unable to retrieve domain id through libvirt API",
+                util::log::type::FLAG
+            );
+
+            backend.release(domains[rank]);
+            continue;
+        }
+
+        // Add UUID-domain-handle key-value pair to table
+        domain_table[std::string(uuid)] = domain_t
+        (
+            domains[rank],
+            [](libvirt::virDomain *domain)
+            {
+                if (domain != nullptr)
+                    libvirt::backend::current().release(domain);
+            }
+        );
+    }
+
+    // Free API collection
+    std::free(domains);
+
+    return EXIT_SUCCESS;
+}
+
+
+/**
+ *  @brief Domain Handle Referencer
+ *
+ *  @param domain: domain handle to take a reference on
+ *
+ *  @details Takes a reference of its own on a domain handle, released as the
+ *  returned handle is, such that holders can outlive one another
+ *
+ *  @return referenced handle, or an empty handle if none could be taken
+ */
+libvirt::domain::domain_t
+libvirt::domain::reference
+(
+    libvirt::virDomainPtr domain
+) noexcept
+{
+    const libvirt::backend::backend_t &backend = libvirt::backend::current();
+    if (domain != nullptr && backend.reference(domain) < 0)
+        domain = nullptr;
+
+    return libvirt::domain::domain_t
+    (
+        domain,
+        [](libvirt::virDomain *domain)
+        {
+            if (domain != nullptr)
+                libvirt::backend::current().release(domain);
+        }
+    );
+}
+
+
+/**
+ *  @brief Domain Snapshot Acquirer
+ *
+ *  @param registry:     snapshot shared between managers
+ *  @param connection:   hypervisor connection via libvirt
+ *  @param domain table: structure reference to write to
+ *
+ *  @details Enumerates domains once per tick, such that managers asking
+ *  within the snapshot's maximum age share one enumeration. Each manager is
+ *  handed its own references on the snapshot's domains, so tables can be
+ *  consumed and released apart.
+ *
+ *  @return execution status code
+ */
+libvirt::status_code
+libvirt::registry::acquire
+(
+          libvirt::registry::registry_t &registry,
+    const libvirt::connection_t         &connection,
+          libvirt::domain::table_t      &domain_table
+) noexcept
+{
+    using std::chrono::steady_clock;
+
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    ++registry.acquisitions;
+
+    // Enumerate domains unless snapshot is recent enough
+    const steady_clock::time_point now = steady_clock::now();
+    if (!registry.taken || now - registry.taken_at >= registry.maximum_age)
+    {
+        libvirt::domain::table_t snapshot;
+        libvirt::status_code status
+            = libvirt::domain::table(connection, snapshot);
+        if (static_cast<bool>(status))
+            return EXIT_FAILURE;
+
+        registry.table    = std::move(snapshot);
+        registry.taken    = true;
+        registry.taken_at = now;
+        ++registry.snapshots;
+    }
+
+    // Hand out references of snapshot's domains
+    try
+    {
+        domain_table.reserve(domain_table.size() + registry.table.size());
+        for (const auto &[uuid, domain]: registry.table)
+        {
+            libvirt::domain::domain_t reference
+                = libvirt::domain::reference(domain.get());
+            if (reference == nullptr)
+            {
+                util::log::record
+                (
+                    "Unable to reference domain " + uuid
+                        + " through libvirt API",
+                    util::log::type::FLAG
+                );
+
+                continue;
+            }
+
+            domain_table[uuid] = std::move(reference);
+        }
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Unable to allocate domain table from registry",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <backend/backend.hpp>
+#include <lib/libvirt.hpp>
+#include <stat/statistics.hpp>
+
+
+/**
+ *  @brief Domain Registry Header
+ *
+ *  @details Defines the domain handle table shared by the CPU and memory
+ *  managers, and the registry serving one snapshot of it to every manager
+ *  running within a tick
+ */
+namespace libvirt
+{
+
+namespace domain
+{
+
+// Domain data constants
+static constexpr util::stat::uint_t
+domains_active_running_flag = static_cast<util::stat::uint_t>
+(
+    VIR_CONNECT_LIST_DOMAINS_ACTIVE | VIR_CONNECT_LIST_DOMAINS_RUNNING
+);
+
+static constexpr std::size_t
+uuid_length = static_cast<std::size_t>(VIR_UUID_STRING_BUFLEN);
+
+// data types and structure types
+using rank_t   = std::size_t;
+using uuid_t   = std::string;
+using domain_t = std::unique_ptr
+<
+    virDomain,
+    std::function<void (virDomain *)>
+>;
+using table_t  = std::unordered_map<uuid_t, domain_t>;
+
+// Structure creation routines
+[[maybe_unused]]
+status_code
+table
+(
+    const connection_t &connection,
+          table_t      &domain_table
+) noexcept;
+
+// Handle routines
+[[nodiscard("Referenced domain handle must be kept to be released")]]
+domain_t
+reference
+(
+    virDomainPtr domain
+) noexcept;
+
+} // domain namespace
+
+namespace registry
+{
+
+// Snapshot of running domains; snapshots younger than the maximum age are
+// served as they are, where zero enumerates domains on every acquisition
+typedef struct registry_t
+{
+    std::chrono::milliseconds             maximum_age
+        = std::chrono::milliseconds(0);
+    std::mutex                            mutex;
+    domain::table_t                       table;
+    bool                                  taken = false;
+    std::chrono::steady_clock::time_point taken_at;
+    util::stat::ulong_t                   snapshots    = 0;
+    util::stat::ulong_t                   acquisitions = 0;
+} registry_t;
+
+// Snapshot routines
+[[nodiscard("Registry acquisition status must be checked")]]
+status_code
+acquire
+(
+          registry_t      &registry,
+    const connection_t    &connection,
+          domain::table_t &domain_table
+) noexcept;
+
+} // registry namespace
+
+} // libvirt namespace
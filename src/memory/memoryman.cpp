@@ -1,16 +1,24 @@
-#include <algorithm>
-#include <cctype>
+#include <atomic>
 #include <chrono>
+#include <cmath>
 #include <cstdlib>
-#include <cstring>
-#include <functional>
-#include <thread>
+#include <memory>
+#include <string>
 
+#include <conf/config.hpp>
+#include <lib/libvirt.hpp>
 #include <lib/signal.hpp>
 #include <log/record.hpp>
+#include <metric/registry.hpp>
+#include <registry/registry.hpp>
 
+#include "attribute/attribute.hpp"
 #include "domain/domain.hpp"
 #include "hardware/hardware.hpp"
+#include "psi/psi.hpp"
+#include "sys/collector.hpp"
+#include "sys/policy.hpp"
+#include "sys/sampler.hpp"
 #include "sys/scheduler.hpp"
 
 #include "memoryman.hpp"
@@ -20,112 +28,204 @@
 static libvirt::domain::uuid_set_t prev_domain_uuids;
 static util::stat::ulong_t         balancer_iteration = 0;
 
+// Scheduler tunables and state required between iterations
+static manager::policy_t scheduler_policy;
+static manager::state_t  scheduler_state;
+
+// Domain statistics sampled between iterations
+static manager::sampler::sampler_t statistics_sampler;
+
+// Domain attributes cached between iterations, shared with collection calls
+// given up on, and libvirt collection calls made up to the previous iteration
+static const libvirt::attribute::handle_t attribute_cache
+    = std::make_shared<libvirt::attribute::cache_t>();
+static util::stat::ulong_t collection_calls = 0;
+
+// NUMA cell of each pCPU, read from hypervisor capabilities once
+static libvirt::hardware::cpu_cells_t cpu_cells;
+static bool                           cpu_cells_read = false;
+
 
 /**
- *  @brief Physical CPU Usage Manager
+ *  @brief Memory Manager Configuration
+ *
+ *  @param parameters: load balancer interval and configuration file
  *
- *  @details Operating systems running atop a hypervisor have virtualized 
- *  CPUs (vCPUs) mapped to physical hardware CPUs (pCPUs) which actually 
- *  execute task of and on the operating system.
+ *  @details Reads scheduler tunables, overriding defaults with any found in
+ *  the configuration file, and registers the event loop domain events are
+ *  delivered through
  *
- *  A hypervisor will spread the multiple vCPUs requested to be supported 
- *  by any single OS across many pCPUs available in the hardware for all 
- *  the OS's, often leading to many vCPUs on any single pCPU.
- *  
- *  To balance the changing loads placed on any pCPU caused any or many of 
- *  changing loads of it's vCPUs, cpuman analyzes the spread of utilization
- *  amongst all pCPUs, and remaps vCPUs to pCPUs if necessary.
+ *  @return execution status code
  */
-int
-main(int argc, char *argv[])  
+manager::memory::status_code
+manager::memory::configure
+(
+    const manager::memory::parameters_t &parameters
+) noexcept
 {
-    /**************************** VALIDATE COMMAND ****************************/
+    // Configuration file overrides default scheduler tunables
+    util::conf::table_t configuration;
+    if (!parameters.configuration.empty())
+    {
+        manager::status_code status = util::conf::load
+        (
+            parameters.configuration, 
+            configuration
+        );
+        if (static_cast<bool>(status))
+        {
+            util::log::record
+            (
+                "Unable to read configuration file", 
+                util::log::type::ABORT
+            );
 
-    // Command should be provided with single interval argument
-    if (argc != 2)
+            return EXIT_FAILURE;
+        }
+    }
+    manager::status_code status = manager::configure
+    (
+        configuration, 
+        scheduler_policy
+    );
+    if (static_cast<bool>(status))
     {
         util::log::record
         (
-            "Usage follows as ./cpuman <interval (ms)>", 
+            "Invalid scheduler configuration", 
             util::log::type::ABORT
         );
 
         return EXIT_FAILURE;
-    } 
-   
-    // Interval argument must be a positive integer
-    std::function<bool(const char *)> is_interval = [](const char *string) 
+    }
+
+    // Domain events are only delivered on connections opened after an event
+    // loop is registered
+    attribute_cache->parameters = scheduler_policy.attributes;
+    if (attribute_cache->parameters.enabled
+        && attribute_cache->parameters.events)
     {
-        return std::all_of
-        (
-            string, string + std::strlen(string), 
-            [](unsigned char character) 
-            {
-                return std::isdigit(character);
-            }
-        );
-    };
-    if (!is_interval(argv[1]))
+        status = libvirt::attribute::register_loop();
+        if (static_cast<bool>(status))
+        {
+            util::log::record
+            (
+                "Unable to watch domain events; attributes refresh by age only",
+                util::log::type::FLAG
+            );
+
+            attribute_cache->parameters.events = false;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/**
+ *  @brief Domain Memory Manager
+ *
+ *  @param parameters:  load balancer interval and failures allowed
+ *  @param connection:  hypervisor connection via libvirt
+ *  @param registry:    domain snapshot shared with other managers
+ *  @param exit signal: flag raised to stop the manager
+ *
+ *  @details Watches host memory pressure and domain events, samples domain
+ *  statistics, and runs the memory load balancer every interval, reclaiming
+ *  memory in between whenever host memory pressure is raised
+ *
+ *  @return execution status code
+ */
+manager::memory::status_code
+manager::memory::run
+(
+    const manager::memory::parameters_t     &parameters,
+    const libvirt::connection_t             &connection,
+          libvirt::registry::registry_t     &registry,
+    const std::atomic<os::signal::signal_t> &exit_signal
+) noexcept
+{
+    /************************ LAUNCH PRESSURE WATCHER *************************/
+
+    // Watch host memory pressure to reclaim memory between intervals
+    os::psi::watcher_t pressure_watcher;
+    manager::status_code status = os::psi::watch
+    (
+        pressure_watcher, 
+        scheduler_policy.psi
+    );
+    if (static_cast<bool>(status))
     {
         util::log::record
         (
-            "Interval argument must be a positive integer", 
+            "Unable to watch host memory pressure", 
             util::log::type::ABORT
         );
 
         return EXIT_FAILURE;
     }
-    std::chrono::milliseconds interval(std::atoi(argv[1]));
     
 
-    /********************** CONNECT TO VIRTUALIZATION HOST ********************/
+    /************************ LAUNCH ATTRIBUTE WATCHER ************************/
 
-    // Make connection to hypervisor using libvirt
-    libvirt::connection_t connection
+    // Refetch domain attributes as soon as domains change
+    status = libvirt::attribute::watch
     (
-        libvirt::virConnectOpen("qemu:///system"),
-        [](libvirt::virConnect *connection)
-        {
-            if (connection != nullptr)
-                libvirt::virConnectClose(connection);
-        }
+        *attribute_cache, 
+        connection
     );
-    if (connection == nullptr)
+    if (static_cast<bool>(status))
     {
         util::log::record
         (
-            "Unable to make connection to QEMU", 
+            "Unable to watch domain events", 
             util::log::type::ABORT
         );
 
+        os::psi::stop(pressure_watcher);
         return EXIT_FAILURE;
     }
 
 
-    /************************* ASSIGN INTERRUPT HANDLER ***********************/
+    /*********************** LAUNCH STATISTICS SAMPLER ************************/
 
-    // Interrupt sets accessible exit flag
-    static os::signal::signal_t exit_signal = os::signal::SIG_DEF;
-    os::signal::signal
+    // Sample domain statistics at their own rate for balancer to aggregate
+    status = manager::sampler::start
     (
-        os::signal::SIG_INT,
-        [](os::signal::signal_t interrupt)
-        {
-            exit_signal = os::signal::SIG_EXT;
-        }
+        statistics_sampler, 
+        scheduler_policy.sampling,
+        scheduler_policy.collection,
+        connection,
+        attribute_cache
     );
+    if (static_cast<bool>(status))
+    {
+        util::log::record
+        (
+            "Unable to sample domain statistics", 
+            util::log::type::ABORT
+        );
+
+        libvirt::attribute::stop(*attribute_cache);
+        os::psi::stop(pressure_watcher);
+        return EXIT_FAILURE;
+    }
+
 
     /************************** LAUNCH LOAD BALANCER **************************/
 
-    // Run pCPU load balancer at every interval
-    util::stat::ulong_t failures = 0, maximum_failures = 3;
-    while (!static_cast<bool>(exit_signal))
+    // Run memory load balancer at every interval
+    using std::chrono::steady_clock;
+    steady_clock::time_point last_emergency;
+    util::stat::ulong_t failures = 0;
+    while (!static_cast<bool>(exit_signal.load()))
     {
         // Launch load balancer
-        manager::status_code status = manager::load_balancer
+        manager::memory::status_code status = manager::memory::load_balancer
         (
             connection, 
-            interval
+            registry,
+            parameters.interval
         );
         if (static_cast<bool>(status))
         {
@@ -138,7 +238,7 @@ main(int argc, char *argv[])
             );
             
             // Abort on too many failures
-            if (++failures >= maximum_failures)
+            if (++failures >= parameters.maximum_failures)
             {
                 util::log::record
                 (
@@ -147,14 +247,42 @@ main(int argc, char *argv[])
                     util::log::type::ABORT
                 );
 
+                manager::sampler::stop(statistics_sampler);
+                libvirt::attribute::stop(*attribute_cache);
+                os::psi::stop(pressure_watcher);
                 return EXIT_FAILURE;
             }
         }
         
-        // Sleep until next interval
-        std::this_thread::sleep_for(interval);
+        // Sleep until next interval, reclaiming memory whenever host memory 
+        // pressure is raised in between without shifting the interval
+        const steady_clock::time_point deadline 
+            = steady_clock::now() + parameters.interval;
+        while (os::psi::wait_until(pressure_watcher, deadline))
+        {
+            // Give previous emergency reclaim time to take effect
+            const steady_clock::time_point now = steady_clock::now();
+            if (now - last_emergency < scheduler_policy.psi.cooldown)
+                continue;
+            last_emergency = now;
+
+            status = manager::memory::emergency_balancer(connection, registry);
+            if (static_cast<bool>(status))
+            {
+                util::log::record
+                (
+                    "Emergency balancer exited on terminating error after "
+                        + std::to_string(balancer_iteration + 1) 
+                        + " iterations", 
+                    util::log::type::ERROR
+                );
+            }
+        }
         ++balancer_iteration;
     }
+    manager::sampler::stop(statistics_sampler);
+    libvirt::attribute::stop(*attribute_cache);
+    os::psi::stop(pressure_watcher);
 
     return EXIT_SUCCESS;
 }
@@ -164,7 +292,9 @@ main(int argc, char *argv[])
  *  @brief Domain Memory Load Balancer
  *
  *  @param connection: hypervisor connection via libvirt
- *  @param interval:   load balancer launching interval and collection period
+ *  @param registry:   domain snapshot shared with other managers
+ *  @param interval:   load balancer launching interval and default statistics
+ *                     collection period
  *
  *  @detials Balances domains' memory pressures from tasks consuming hypervisor
  *  provided memory pools by reallocating memory provided to domain balloon 
@@ -173,21 +303,23 @@ main(int argc, char *argv[])
  *
  *  @return execution status code
  */
-manager::status_code
-static manager::load_balancer
+manager::memory::status_code
+manager::memory::load_balancer
 (
-    const libvirt::connection_t     &connection, 
-    const std::chrono::milliseconds &interval
+    const libvirt::connection_t         &connection, 
+          libvirt::registry::registry_t &registry,
+    const std::chrono::milliseconds     &interval
 ) noexcept
 {
     libvirt::status_code status;
 
     /*************************** DOMAIN INFORMATION ***************************/
 
-    // Get list of domains
+    // Get list of domains from this tick's snapshot
     libvirt::domain::table_t curr_domain_table;
-    status = libvirt::domain::table
+    status = libvirt::registry::acquire
     (
+        registry,
         connection, 
         curr_domain_table
     );
@@ -202,12 +334,18 @@ static manager::load_balancer
         return EXIT_FAILURE;
     }
 
-    // Set statistics collection period for each domain if not previously set
+    // Set statistics collection period for each domain if not previously set;
+    // unless configured apart, the period follows the interval rounded up
+    const std::chrono::seconds stats_period 
+        = scheduler_policy.sampling.stats_period.count() > 0
+        ? scheduler_policy.sampling.stats_period
+        : std::chrono::ceil<std::chrono::seconds>(interval);
     status = libvirt::domain::set_collection_period
     (
         curr_domain_table, 
         prev_domain_uuids,
-        interval
+        stats_period,
+        *attribute_cache
     );
     if (static_cast<bool>(status))
     {
@@ -240,11 +378,22 @@ static manager::load_balancer
     // Get memory statistics for each domain
     libvirt::domain::data_t curr_domain_data;
     curr_domain_data.reserve(curr_domain_table.size());
-    status = libvirt::domain::data
-    (
-        curr_domain_table,
-        curr_domain_data
-    );
+    status = scheduler_policy.collection.enabled
+        ? manager::collector::collect
+          (
+              scheduler_state.collector,
+              scheduler_policy.collection,
+              curr_domain_table,
+              curr_domain_data,
+              attribute_cache,
+              scheduler_state.metrics
+          )
+        : libvirt::domain::data
+          (
+              curr_domain_table,
+              curr_domain_data,
+              *attribute_cache
+          );
     if (static_cast<bool>(status))
     {
         util::log::record
@@ -257,14 +406,27 @@ static manager::load_balancer
     }
 
 
+    // Balance on aggregates of sampled window rather than a single snapshot
+    if (scheduler_policy.sampling.enabled)
+    {
+        manager::sampler::aggregate_into
+        (
+            statistics_sampler,
+            scheduler_policy.sampling,
+            curr_domain_data
+        );
+    }
+
+
     /*************************** SYSTEM INFORMATION ***************************/
     
     // Get hardware memory statistics
-    util::stat::slong_t system_memory_limit;
+    libvirt::hardware::datum_t hardware_datum;
     status = libvirt::hardware::memory_limit
     (
         connection, 
-        system_memory_limit
+        hardware_datum.memory_limit,
+        *attribute_cache
     );
     if (static_cast<bool>(status))
     {
@@ -277,6 +439,49 @@ static manager::load_balancer
         return EXIT_FAILURE;
     }
 
+    // Get NUMA topology and domains' placement on it
+    if (scheduler_policy.numa_enabled)
+    {
+        status = libvirt::hardware::cells_memory_free
+        (
+            connection, 
+            hardware_datum.cells_memory_free,
+            *attribute_cache
+        );
+
+        // pCPUs' cells are fixed for the host's lifetime, thus read once
+        if (!static_cast<bool>(status) && !cpu_cells_read)
+        {
+            status = libvirt::hardware::cpu_cells
+            (
+                connection, 
+                cpu_cells,
+                *attribute_cache
+            );
+            cpu_cells_read = !static_cast<bool>(status);
+        }
+        hardware_datum.cpu_cells = cpu_cells;
+        if (!static_cast<bool>(status))
+        {
+            status = libvirt::domain::placement
+            (
+                curr_domain_data, 
+                hardware_datum.cpu_cells,
+                *attribute_cache
+            );
+        }
+        if (static_cast<bool>(status))
+        {
+            util::log::record
+            (
+                "Unable to retrieve NUMA topology; balancing across nodes only",
+                util::log::type::FLAG
+            );
+
+            hardware_datum.cells_memory_free.clear();
+        }
+    }
+
     
     /*********************** MEMORY MOVEMENT SCHEDULER ************************/
     
@@ -284,7 +489,9 @@ static manager::load_balancer
     status = manager::scheduler
     (
         curr_domain_data, 
-        system_memory_limit
+        hardware_datum,
+        scheduler_policy,
+        scheduler_state
     );
     if (static_cast<bool>(status))
     {
@@ -297,5 +504,142 @@ static manager::load_balancer
         return EXIT_FAILURE;
     }
 
+
+    /***************************** METRIC EXPORT ******************************/
+
+    // Collection calls made since previous iteration, sampler's and host
+    // topology's included; steady iterations make one per domain and sample
+    const util::stat::ulong_t calls 
+        = libvirt::attribute::calls(*attribute_cache);
+    util::metric::set
+    (
+        scheduler_state.metrics, "memoryman_libvirt_collection_calls",
+        "Libvirt calls collecting domain data since previous iteration", {},
+        static_cast<std::double_t>(calls - collection_calls)
+    );
+    collection_calls = calls;
+    libvirt::attribute::advance(*attribute_cache);
+
+    // Publish scheduler metrics for textfile collection
+    if (!scheduler_policy.metrics_path.empty())
+    {
+        status = util::metric::write
+        (
+            scheduler_state.metrics, 
+            scheduler_policy.metrics_path
+        );
+        if (static_cast<bool>(status))
+        {
+            util::log::record
+            (
+                "Unable to export scheduler metrics",
+                util::log::type::FLAG
+            );
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/**
+ *  @brief Domain Memory Emergency Balancer
+ *
+ *  @param connection: hypervisor connection via libvirt
+ *  @param registry:   domain snapshot shared with other managers
+ *
+ *  @detials Reclaims memory from the largest supplying domains as soon as the 
+ *  host comes under memory pressure, without waiting for the next load 
+ *  balancer iteration and without providing memory to any domain.
+ *
+ *  @return execution status code
+ */
+manager::memory::status_code
+manager::memory::emergency_balancer
+(
+    const libvirt::connection_t         &connection,
+          libvirt::registry::registry_t &registry
+) noexcept
+{
+    libvirt::status_code status;
+
+    /*************************** DOMAIN INFORMATION ***************************/
+
+    // Get list of domains from this tick's snapshot
+    libvirt::domain::table_t curr_domain_table;
+    status = libvirt::registry::acquire
+    (
+        registry,
+        connection, 
+        curr_domain_table
+    );
+    if (static_cast<bool>(status))
+    {
+        util::log::record
+        (
+            "Unable to retrieve data structure for domains",
+            util::log::type::ABORT
+        );
+
+        return EXIT_FAILURE;
+    }
+    
+    // Get memory statistics for each domain
+    libvirt::domain::data_t curr_domain_data;
+    curr_domain_data.reserve(curr_domain_table.size());
+    status = scheduler_policy.collection.enabled
+        ? manager::collector::collect
+          (
+              scheduler_state.collector,
+              scheduler_policy.collection,
+              curr_domain_table,
+              curr_domain_data,
+              attribute_cache,
+              scheduler_state.metrics
+          )
+        : libvirt::domain::data
+          (
+              curr_domain_table,
+              curr_domain_data,
+              *attribute_cache
+          );
+    if (static_cast<bool>(status))
+    {
+        util::log::record
+        (
+            "Unable to retrieve memory statistics for domains",
+            util::log::type::ABORT
+        );
+
+        return EXIT_FAILURE;
+    }
+
+
+    /************************* EMERGENCY MEMORY RECLAIM ***********************/
+
+    util::log::record
+    (
+        "Host memory pressure raised; reclaiming from largest suppliers",
+        util::log::type::FLAG
+    );
+
+    // Run reclaimer on largest suppliers only
+    status = manager::reclaimer
+    (
+        curr_domain_data, 
+        scheduler_policy,
+        scheduler_state
+    );
+    if (static_cast<bool>(status))
+    {
+        util::log::record
+        (
+            "Fault incurred in emergency reclaimer processing",
+            util::log::type::ABORT
+        );
+
+        return EXIT_FAILURE;
+    }
+
     return EXIT_SUCCESS;
 }
@@ -1,27 +1,77 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <string>
 
 #include <lib/libvirt.hpp>
+#include <lib/signal.hpp>
+#include <registry/registry.hpp>
+#include <stat/statistics.hpp>
 
 
 /**
  *  @brief Memory Manager Header
  *
- *  @details Defines manager's status code and load balancer
+ *  @details Defines the domain memory balancing module, run on its own by
+ *  memoryman or next to the CPU manager by hypman
  */
 namespace manager
 {
 
+namespace memory
+{
+
 using status_code = std::uint8_t;
 
+// Tunables; load balancer runs every interval and gives up after as many
+// failures, and an empty configuration keeps default scheduler tunables
+typedef struct parameters_t
+{
+    std::chrono::milliseconds interval = std::chrono::milliseconds(1000);
+    std::string               configuration;
+    util::stat::ulong_t       maximum_failures = 3;
+} parameters_t;
+
+// Module routines; configuration precedes opening the connection, as domain
+// events are only delivered on connections opened after it
+[[nodiscard("Memory manager configuration status must be checked")]]
+status_code
+configure
+(
+    const parameters_t &parameters
+) noexcept;
+
+[[nodiscard("Memory manager exit status must be checked")]]
+status_code
+run
+(
+    const parameters_t                      &parameters,
+    const libvirt::connection_t             &connection,
+          libvirt::registry::registry_t     &registry,
+    const std::atomic<os::signal::signal_t> &exit_signal
+) noexcept;
+
+// Single iterations of the module, run on their own when driving a backend
+// after configuration
 [[nodiscard("Load balancer exit status must be checked")]]
-status_code 
-static load_balancer
+status_code
+load_balancer
 (
-    const libvirt::connection_t     &connection,
-    const std::chrono::milliseconds &interval
+    const libvirt::connection_t         &connection,
+          libvirt::registry::registry_t &registry,
+    const std::chrono::milliseconds     &interval
 ) noexcept;
 
+[[nodiscard("Emergency balancer exit status must be checked")]]
+status_code
+emergency_balancer
+(
+    const libvirt::connection_t         &connection,
+          libvirt::registry::registry_t &registry
+) noexcept;
+
+} // memory namespace
+
 } // manager namespace
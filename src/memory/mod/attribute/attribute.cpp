@@ -0,0 +1,549 @@
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <lib/libvirt.hpp>
+#include <log/record.hpp>
+#include <stat/statistics.hpp>
+
+#include "attribute.hpp"
+
+
+/**
+ *  @brief Domain Event Invalidator
+ *
+ *  @param domain:    domain an event was raised for
+ *  @param opaque:    attribute cache
+ *  @param placement: whether the domain's NUMA placement may have changed
+ *
+ *  @details Drops the domain's cached attributes, and its placement when
+ *  asked, so they are refetched on the next collection
+ */
+void
+static invalidate_domain
+(
+    libvirt::virDomainPtr  domain,
+    void                  *opaque,
+    bool                   placement
+) noexcept
+{
+    libvirt::attribute::cache_t &cache
+        = *static_cast<libvirt::attribute::cache_t *>(opaque);
+
+    char uuid[VIR_UUID_STRING_BUFLEN];
+    const std::string domain_uuid
+        = libvirt::virDomainGetUUIDString(domain, uuid) < 0
+        ? std::string()
+        : std::string(uuid);
+
+    libvirt::attribute::invalidate(cache, domain_uuid);
+    if (placement)
+        libvirt::attribute::invalidate_placement(cache, domain_uuid);
+}
+
+
+// Event callbacks by event signature; each invalidates its domain, and only
+// lifecycle and tunable changes such as numatune updates its placement
+void
+static lifecycle_event
+(
+    libvirt::virConnectPtr  /* connection */,
+    libvirt::virDomainPtr   domain,
+    int                     /* event */,
+    int                     /* detail */,
+    void                   *opaque
+) noexcept
+{
+    invalidate_domain(domain, opaque, true);
+}
+
+void
+static device_event
+(
+    libvirt::virConnectPtr  /* connection */,
+    libvirt::virDomainPtr   domain,
+    const char             * /* alias */,
+    void                   *opaque
+) noexcept
+{
+    invalidate_domain(domain, opaque, false);
+}
+
+void
+static tunable_event
+(
+    libvirt::virConnectPtr        /* connection */,
+    libvirt::virDomainPtr         domain,
+    libvirt::virTypedParameterPtr /* parameters */,
+    int                           /* number_of_parameters */,
+    void                         *opaque
+) noexcept
+{
+    invalidate_domain(domain, opaque, true);
+}
+
+void
+static memory_device_event
+(
+    libvirt::virConnectPtr  /* connection */,
+    libvirt::virDomainPtr   domain,
+    const char             * /* alias */,
+    unsigned long long      /* size */,
+    void                   *opaque
+) noexcept
+{
+    invalidate_domain(domain, opaque, false);
+}
+
+
+/**
+ *  @brief Event Loop
+ *
+ *  @param cache: attribute cache whose callbacks the loop dispatches
+ *
+ *  @details Runs libvirt's default event loop until stopped; stopping fires
+ *  the cache's wake timer so the loop returns promptly
+ */
+void
+static run_loop
+(
+    libvirt::attribute::cache_t &cache
+) noexcept
+{
+    while (cache.running)
+    {
+        if (libvirt::virEventRunDefaultImpl() < 0)
+        {
+            util::log::record
+            (
+                "Domain event loop failed; attributes refresh by age only",
+                util::log::type::FLAG
+            );
+
+            return;
+        }
+    }
+}
+
+
+/**
+ *  @brief Cached Attribute Lookup
+ *
+ *  @param cache:      attribute cache
+ *  @param UUID:       domain to look up
+ *  @param attributes: variable reference to write to
+ *
+ *  @return whether domain has attributes fetched within refresh iterations
+ */
+bool
+libvirt::attribute::lookup
+(
+          libvirt::attribute::cache_t      &cache,
+    const std::string                      &uuid,
+          libvirt::attribute::attributes_t &attributes
+) noexcept
+{
+    if (!cache.parameters.enabled)
+        return false;
+
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    const auto entry = cache.entries.find(uuid);
+    if (entry == cache.entries.end()
+        || cache.iteration - entry->second.fetched_at
+            >= cache.parameters.refresh)
+        return false;
+
+    attributes = entry->second;
+
+    return true;
+}
+
+
+/**
+ *  @brief Attribute Store
+ *
+ *  @param cache:      attribute cache
+ *  @param UUID:       domain attributes were fetched for
+ *  @param attributes: attributes fetched
+ */
+void
+libvirt::attribute::store
+(
+          libvirt::attribute::cache_t      &cache,
+    const std::string                      &uuid,
+          libvirt::attribute::attributes_t  attributes
+) noexcept
+{
+    if (!cache.parameters.enabled)
+        return;
+
+    try
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        attributes.fetched_at = cache.iteration;
+        cache.entries[uuid]   = attributes;
+    }
+
+    catch (const std::exception &exception)
+    {
+        return;
+    }
+}
+
+
+/**
+ *  @brief Attribute Invalidator
+ *
+ *  @param cache: attribute cache
+ *  @param UUID:  domain to drop attributes of; empty drops all
+ */
+void
+libvirt::attribute::invalidate
+(
+          libvirt::attribute::cache_t &cache,
+    const std::string                 &uuid
+) noexcept
+{
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (uuid.empty())
+        cache.entries.clear();
+    else
+        cache.entries.erase(uuid);
+}
+
+
+/**
+ *  @brief Cached Placement Lookup
+ *
+ *  @param cache:     attribute cache
+ *  @param UUID:      domain to look up
+ *  @param placement: variable reference to write to
+ *
+ *  @return whether domain has a nodeset fetched within refresh iterations
+ */
+bool
+libvirt::attribute::lookup
+(
+          libvirt::attribute::cache_t     &cache,
+    const std::string                     &uuid,
+          libvirt::attribute::placement_t &placement
+) noexcept
+{
+    if (!cache.parameters.enabled)
+        return false;
+
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    const auto entry = cache.placements.find(uuid);
+    if (entry == cache.placements.end()
+        || cache.iteration - entry->second.fetched_at
+            >= cache.parameters.refresh)
+        return false;
+
+    placement = entry->second;
+
+    return true;
+}
+
+
+/**
+ *  @brief Placement Store
+ *
+ *  @param cache:     attribute cache
+ *  @param UUID:      domain nodeset was fetched for
+ *  @param placement: nodeset fetched
+ */
+void
+libvirt::attribute::store
+(
+          libvirt::attribute::cache_t     &cache,
+    const std::string                     &uuid,
+          libvirt::attribute::placement_t  placement
+) noexcept
+{
+    if (!cache.parameters.enabled)
+        return;
+
+    try
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        placement.fetched_at   = cache.iteration;
+        cache.placements[uuid] = std::move(placement);
+    }
+
+    catch (const std::exception &exception)
+    {
+        return;
+    }
+}
+
+
+/**
+ *  @brief Placement Invalidator
+ *
+ *  @param cache: attribute cache
+ *  @param UUID:  domain to drop nodeset of; empty drops all
+ */
+void
+libvirt::attribute::invalidate_placement
+(
+          libvirt::attribute::cache_t &cache,
+    const std::string                 &uuid
+) noexcept
+{
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (uuid.empty())
+        cache.placements.clear();
+    else
+        cache.placements.erase(uuid);
+}
+
+
+/**
+ *  @brief Iteration Advancer
+ *
+ *  @param cache: attribute cache
+ *
+ *  @details Ages cached attributes and placements by one load balancer
+ *  iteration and drops those due for refetching, including those of domains
+ *  no longer running
+ */
+void
+libvirt::attribute::advance
+(
+    libvirt::attribute::cache_t &cache
+) noexcept
+{
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    ++cache.iteration;
+
+    auto entry = cache.entries.begin();
+    while (entry != cache.entries.end())
+    {
+        if (cache.iteration - entry->second.fetched_at
+            >= cache.parameters.refresh)
+            entry = cache.entries.erase(entry);
+        else
+            ++entry;
+    }
+
+    auto placement = cache.placements.begin();
+    while (placement != cache.placements.end())
+    {
+        if (cache.iteration - placement->second.fetched_at
+            >= cache.parameters.refresh)
+            placement = cache.placements.erase(placement);
+        else
+            ++placement;
+    }
+}
+
+
+/**
+ *  @brief Call Counter
+ *
+ *  @param cache: attribute cache
+ *  @param calls: libvirt calls made
+ */
+void
+libvirt::attribute::count
+(
+    libvirt::attribute::cache_t &cache,
+    util::stat::ulong_t          calls
+) noexcept
+{
+    cache.calls += calls;
+}
+
+
+/**
+ *  @brief Call Total
+ *
+ *  @param cache: attribute cache
+ *
+ *  @return libvirt calls made by collectors since start
+ */
+util::stat::ulong_t
+libvirt::attribute::calls
+(
+    const libvirt::attribute::cache_t &cache
+) noexcept
+{
+    return cache.calls;
+}
+
+
+/**
+ *  @brief Event Loop Registration
+ *
+ *  @details Must precede opening the connection events are watched on
+ *
+ *  @return execution status code
+ */
+libvirt::status_code
+libvirt::attribute::register_loop() noexcept
+{
+    if (libvirt::virEventRegisterDefaultImpl() < 0)
+    {
+        util::log::record
+        (
+            "Unable to register libvirt's default event loop",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/**
+ *  @brief Domain Event Watcher Starter
+ *
+ *  @param cache:      attribute cache to invalidate on events
+ *  @param connection: hypervisor connection via libvirt, which must outlive
+ *                     the watcher
+ *
+ *  @details Invalidates a domain's attributes on lifecycle events such as
+ *  being defined, on device and tunable changes such as vCPU and memory
+ *  hotplug, and on memory device resizes. Placements are only invalidated
+ *  on lifecycle and tunable events. Events a hypervisor does not support are
+ *  flagged and left to the refresh period.
+ *
+ *  @return execution status code
+ */
+libvirt::status_code
+libvirt::attribute::watch
+(
+          libvirt::attribute::cache_t &cache,
+    const libvirt::connection_t       &connection
+) noexcept
+{
+    if (!cache.parameters.enabled || !cache.parameters.events)
+        return EXIT_SUCCESS;
+
+    const std::pair<int, libvirt::virConnectDomainEventGenericCallback>
+    events[] =
+    {
+        {
+            VIR_DOMAIN_EVENT_ID_LIFECYCLE,
+            VIR_DOMAIN_EVENT_CALLBACK(lifecycle_event)
+        },
+        {
+            VIR_DOMAIN_EVENT_ID_DEVICE_ADDED,
+            VIR_DOMAIN_EVENT_CALLBACK(device_event)
+        },
+        {
+            VIR_DOMAIN_EVENT_ID_DEVICE_REMOVED,
+            VIR_DOMAIN_EVENT_CALLBACK(device_event)
+        },
+        {
+            VIR_DOMAIN_EVENT_ID_TUNABLE,
+            VIR_DOMAIN_EVENT_CALLBACK(tunable_event)
+        },
+        {
+            VIR_DOMAIN_EVENT_ID_MEMORY_DEVICE_SIZE_CHANGE,
+            VIR_DOMAIN_EVENT_CALLBACK(memory_device_event)
+        }
+    };
+
+    try
+    {
+        cache.connection = connection.get();
+        for (const auto &[event, callback]: events)
+        {
+            const util::stat::sint_t identifier
+                = libvirt::virConnectDomainEventRegisterAny
+                  (
+                      cache.connection, nullptr, event, callback,
+                      &cache, nullptr
+                  );
+            if (identifier < 0)
+            {
+                util::log::record
+                (
+                    "Unable to watch domain event " + std::to_string(event)
+                        + "; attributes refresh by age only",
+                    util::log::type::FLAG
+                );
+
+                continue;
+            }
+
+            cache.callbacks.push_back(identifier);
+        }
+
+        // Disabled timer fired to wake loop when stopping
+        cache.timer = libvirt::virEventAddTimeout
+        (
+            -1, [](int /* timer */, void * /* opaque */) {}, nullptr, nullptr
+        );
+        if (cache.timer < 0)
+        {
+            util::log::record
+            (
+                "Unable to add domain event loop wake timer",
+                util::log::type::ERROR
+            );
+
+            libvirt::attribute::stop(cache);
+            return EXIT_FAILURE;
+        }
+
+        cache.running = true;
+        cache.thread  = std::thread(run_loop, std::ref(cache));
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Unable to launch domain event loop thread",
+            util::log::type::ERROR
+        );
+
+        libvirt::attribute::stop(cache);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/**
+ *  @brief Domain Event Watcher Stopper
+ *
+ *  @param cache: attribute cache watched
+ *
+ *  @details Wakes and joins the event loop, then drops event callbacks
+ */
+void
+libvirt::attribute::stop
+(
+    libvirt::attribute::cache_t &cache
+) noexcept
+{
+    cache.running = false;
+    if (cache.timer >= 0)
+        libvirt::virEventUpdateTimeout(cache.timer, 0);
+
+    if (cache.thread.joinable())
+        cache.thread.join();
+
+    for (const util::stat::sint_t identifier: cache.callbacks)
+    {
+        libvirt::virConnectDomainEventDeregisterAny
+        (
+            cache.connection, identifier
+        );
+    }
+    cache.callbacks.clear();
+
+    if (cache.timer >= 0)
+        libvirt::virEventRemoveTimeout(cache.timer);
+    cache.timer = -1;
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <lib/libvirt.hpp>
+#include <stat/statistics.hpp>
+
+
+/**
+ *  @brief Domain Attribute Cache Header
+ *
+ *  @details Defines the cache of slowly changing domain attributes, such as
+ *  maximum memory and number of vCPUs, kept between load balancer iterations
+ *  so steady iterations make a single statistics call per domain
+ */
+namespace libvirt
+{
+
+namespace attribute
+{
+
+// Tunables; attributes are refetched after refresh iterations, and on
+// domain events when watched. Memory backing is read from definitions only
+// when asked for, costing another call per refetch, and CPU time, which
+// cannot be cached, costs another call every iteration when asked for.
+typedef struct parameters_t
+{
+    bool                enabled        = true;
+    util::stat::ulong_t refresh        = 60;
+    bool                events         = true;
+    bool                memory_backing = false;
+    bool                cpu_time       = false;
+} parameters_t;
+
+// Cached attributes of a single domain; memory in KiB
+typedef struct attributes_t
+{
+    util::stat::slong_t domain_memory_limit = 0;
+    std::size_t         number_of_vCPUs     = 0;
+    util::stat::slong_t hugepage_size       = 0;
+    util::stat::ulong_t fetched_at          = 0;
+} attributes_t;
+
+// Cached numatune nodeset of a single domain; empty when it has none
+typedef struct placement_t
+{
+    std::string         nodeset;
+    util::stat::ulong_t fetched_at = 0;
+} placement_t;
+
+// Attribute cache shared by collectors, and the event loop invalidating it
+typedef struct cache_t
+{
+    parameters_t                                  parameters;
+    std::mutex                                    mutex;
+    std::unordered_map<std::string, attributes_t> entries;
+    std::unordered_map<std::string, placement_t>  placements;
+    util::stat::ulong_t                           iteration  = 0;
+    std::atomic<util::stat::ulong_t>              calls      = 0;
+
+    // Event loop
+    std::thread                                   thread;
+    std::atomic<bool>                             running    = false;
+    virConnectPtr                                 connection = nullptr;
+    std::vector<util::stat::sint_t>               callbacks;
+    util::stat::sint_t                            timer      = -1;
+} cache_t;
+
+// Cache shared with collection calls that may outlive their caller
+using handle_t = std::shared_ptr<cache_t>;
+
+// Attribute cache routines
+[[nodiscard("Must use whether attributes were cached to call")]]
+bool
+lookup
+(
+          cache_t      &cache,
+    const std::string  &uuid,
+          attributes_t &attributes
+) noexcept;
+
+void
+store
+(
+          cache_t      &cache,
+    const std::string  &uuid,
+          attributes_t  attributes
+) noexcept;
+
+[[nodiscard("Must use whether placement was cached to call")]]
+bool
+lookup
+(
+          cache_t     &cache,
+    const std::string &uuid,
+          placement_t &placement
+) noexcept;
+
+void
+store
+(
+          cache_t     &cache,
+    const std::string &uuid,
+          placement_t  placement
+) noexcept;
+
+void
+invalidate
+(
+          cache_t     &cache,
+    const std::string &uuid
+) noexcept;
+
+void
+invalidate_placement
+(
+          cache_t     &cache,
+    const std::string &uuid
+) noexcept;
+
+void
+advance
+(
+    cache_t &cache
+) noexcept;
+
+void
+count
+(
+    cache_t             &cache,
+    util::stat::ulong_t  calls
+) noexcept;
+
+[[nodiscard("Must use number of calls made to call")]]
+util::stat::ulong_t
+calls
+(
+    const cache_t &cache
+) noexcept;
+
+// Event routines
+[[nodiscard("Event loop registration status must be checked")]]
+status_code
+register_loop() noexcept;
+
+[[nodiscard("Watcher start status must be checked")]]
+status_code
+watch
+(
+          cache_t      &cache,
+    const connection_t &connection
+) noexcept;
+
+void
+stop
+(
+    cache_t &cache
+) noexcept;
+
+} // attribute namespace
+
+} // libvirt namespace
@@ -0,0 +1,166 @@
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <log/record.hpp>
+#include <stat/statistics.hpp>
+
+#include "buddy.hpp"
+
+
+/**
+ *  @brief Buddy Information Reader
+ *
+ *  @param path:  buddy information file, usually /proc/buddyinfo
+ *  @param zones: structure reference to write to
+ *
+ *  @details Reads lines such as
+ *
+ *      Node 0, zone   Normal   1204    837    512 ...
+ *
+ *  holding the free blocks of each order, lowest order first
+ *
+ *  @return execution status code
+ */
+os::buddy::status_code
+os::buddy::read
+(
+    const std::string        &path,
+          os::buddy::zones_t &zones
+) noexcept
+{
+    zones.clear();
+
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        util::log::record
+        (
+            "Unable to open " + path,
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        std::string line;
+        while (std::getline(file, line))
+        {
+            std::istringstream stream(line);
+            std::string node_label, node, zone_label;
+
+            os::buddy::zone_t zone;
+            if (!(stream >> node_label >> node >> zone_label >> zone.name)
+                || node_label != "Node" || zone_label != "zone")
+                continue;
+
+            zone.node = std::stoi(node);
+
+            util::stat::ulong_t blocks;
+            while (stream >> blocks)
+                zone.free_blocks.push_back(blocks);
+
+            zones.push_back(std::move(zone));
+        }
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Malformed buddy information in " + path,
+            util::log::type::ERROR
+        );
+
+        zones.clear();
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/**
+ *  @brief Unusable Free Space Index
+ *
+ *  @param zones: free blocks of every zone
+ *  @param node:  node to index
+ *  @param order: order of blocks wanted
+ *
+ *  @details The share of the node's free memory held in blocks smaller than
+ *  the given order, which cannot serve allocations of that order without
+ *  compaction. Zero when nothing is free, as compaction frees nothing then.
+ *
+ *  @return fragmentation index within [0, 1]
+ */
+std::double_t
+os::buddy::unusable_index
+(
+    const os::buddy::zones_t &zones,
+          util::stat::sint_t  node,
+          std::size_t         order
+) noexcept
+{
+    std::double_t pages_free   = 0.0;
+    std::double_t pages_usable = 0.0;
+    for (const os::buddy::zone_t &zone: zones)
+    {
+        if (zone.node != node)
+            continue;
+
+        for (std::size_t block = 0; block < zone.free_blocks.size(); ++block)
+        {
+            const std::double_t pages = std::ldexp
+            (
+                static_cast<std::double_t>(zone.free_blocks[block]),
+                static_cast<int>(block)
+            );
+            pages_free += pages;
+            if (block >= order)
+                pages_usable += pages;
+        }
+    }
+
+    if (pages_free <= 0.0)
+        return 0.0;
+
+    return (pages_free - pages_usable) / pages_free;
+}
+
+
+/**
+ *  @brief Compaction Trigger
+ *
+ *  @param path: compaction file, such as /proc/sys/vm/compact_memory or a
+ *               node's compact file under /sys/devices/system/node
+ *
+ *  @details The write returns once the kernel has compacted memory, which
+ *  may take a while on large nodes
+ *
+ *  @return execution status code
+ */
+os::buddy::status_code
+os::buddy::compact
+(
+    const std::string &path
+) noexcept
+{
+    std::ofstream file(path);
+    if (!file.is_open() || !(file << 1 << std::endl))
+    {
+        util::log::record
+        (
+            "Unable to trigger compaction through " + path,
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <stat/statistics.hpp>
+
+
+/**
+ *  @brief Buddy Allocator Header
+ *
+ *  @details Defines routines to read the free blocks of each order the host's
+ *  buddy allocator holds from procfs, and to ask the kernel to compact memory
+ */
+namespace os
+{
+
+namespace buddy
+{
+
+using status_code = std::uint8_t;
+
+// Free blocks of a single zone by order; a block of order n spans 2^n pages
+typedef struct zone_t
+{
+    util::stat::sint_t               node = 0;
+    std::string                      name;
+    std::vector<util::stat::ulong_t> free_blocks;
+} zone_t;
+
+using zones_t = std::vector<zone_t>;
+
+// Buddy allocator routines
+[[nodiscard("Buddy allocator read status must be checked")]]
+status_code
+read
+(
+    const std::string &path,
+          zones_t     &zones
+) noexcept;
+
+[[nodiscard("Must use fragmentation index to call")]]
+std::double_t
+unusable_index
+(
+    const zones_t            &zones,
+          util::stat::sint_t  node,
+          std::size_t         order
+) noexcept;
+
+[[nodiscard("Compaction trigger status must be checked")]]
+status_code
+compact
+(
+    const std::string &path
+) noexcept;
+
+} // buddy namespace
+
+} // os namespace
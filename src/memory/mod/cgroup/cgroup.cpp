@@ -0,0 +1,129 @@
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+#include <log/record.hpp>
+#include <stat/statistics.hpp>
+
+#include "cgroup.hpp"
+
+
+/**
+ *  @brief QEMU Scope Finder
+ *
+ *  @param root:  cgroup v2 mount, usually /sys/fs/cgroup
+ *  @param slice: slice holding domains, usually machine.slice
+ *  @param id:    domain's libvirt ID
+ *  @param path:  variable reference to write scope directory to
+ *
+ *  @details Libvirt places each running QEMU domain in a scope named
+ *  machine-qemu\x2d<ID>\x2d<name>.scope, whose name may be shortened, so
+ *  scopes are matched by ID alone
+ *
+ *  @return execution status code
+ */
+os::cgroup::status_code
+os::cgroup::scope
+(
+    const std::string        &root,
+    const std::string        &slice,
+          util::stat::uint_t  id,
+          std::string        &path
+) noexcept
+{
+    path.clear();
+
+    try
+    {
+        const std::string prefix
+            = "machine-qemu\\x2d" + std::to_string(id) + "\\x2d";
+        const std::string suffix = ".scope";
+
+        std::error_code error;
+        for (const std::filesystem::directory_entry &entry:
+             std::filesystem::directory_iterator(root + "/" + slice, error))
+        {
+            const std::string name = entry.path().filename().string();
+            if (name.size() > prefix.size() + suffix.size()
+                && name.compare(0, prefix.size(), prefix) == 0
+                && name.compare
+                   (
+                       name.size() - suffix.size(), suffix.size(), suffix
+                   ) == 0)
+            {
+                path = entry.path().string();
+                return EXIT_SUCCESS;
+            }
+        }
+        if (error)
+        {
+            util::log::record
+            (
+                "Unable to list scopes under " + root + "/" + slice,
+                util::log::type::ERROR
+            );
+
+            return EXIT_FAILURE;
+        }
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Unable to search scopes under " + root + "/" + slice,
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    util::log::record
+    (
+        "No QEMU scope of domain ID " + std::to_string(id) + " under "
+            + root + "/" + slice,
+        util::log::type::ERROR
+    );
+
+    return EXIT_FAILURE;
+}
+
+
+/**
+ *  @brief Memory Limit Writer
+ *
+ *  @param path:   scope directory
+ *  @param file:   memory controller file, memory.high or memory.max
+ *  @param memory: limit in KiB, or unlimited to lift it
+ *
+ *  @return execution status code
+ */
+os::cgroup::status_code
+os::cgroup::limit
+(
+    const std::string         &path,
+    const std::string         &file,
+          util::stat::slong_t  memory
+) noexcept
+{
+    std::ofstream stream(path + "/" + file);
+    const bool written = stream.is_open()
+        && (memory < 0
+            ? static_cast<bool>(stream << "max" << std::endl)
+            : static_cast<bool>(stream << memory * 1024 << std::endl));
+    if (!written)
+    {
+        util::log::record
+        (
+            "Unable to write " + file + " of " + path,
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <stat/statistics.hpp>
+
+
+/**
+ *  @brief Control Group Header
+ *
+ *  @details Defines routines to find a domain's QEMU scope in the cgroup v2
+ *  hierarchy and to bound its memory through the scope's memory controller
+ */
+namespace os
+{
+
+namespace cgroup
+{
+
+using status_code = std::uint8_t;
+
+// Memory controller files; limits are written in bytes or as max
+static const std::string memory_high = "memory.high";
+static const std::string memory_max  = "memory.max";
+
+// Limit value lifting a bound
+static constexpr util::stat::slong_t unlimited = -1;
+
+// Control group routines
+[[nodiscard("Scope lookup status must be checked")]]
+status_code
+scope
+(
+    const std::string        &root,
+    const std::string        &slice,
+          util::stat::uint_t  id,
+          std::string        &path
+) noexcept;
+
+[[nodiscard("Memory limit status must be checked")]]
+status_code
+limit
+(
+    const std::string         &path,
+    const std::string         &file,
+          util::stat::slong_t  memory
+) noexcept;
+
+} // cgroup namespace
+
+} // os namespace
@@ -1,8 +1,13 @@
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdlib>
+#include <cstring>
+#include <exception>
 #include <string>
+#include <vector>
 
+#include <backend/backend.hpp>
 #include <lib/libvirt.hpp>
 #include <log/record.hpp>
 
@@ -11,89 +16,18 @@
 #include "domain.hpp"
 
 
-/**
- *  @brief Domain ID to Domain Handle Table Producer
- *
- *  @param connection:   hypervisor connection via libvirt
- *  @param domain table: structure reference to write to
- *
- *  @details Creates a table mapping universally unique identifiers (uuid)
- *  of a domain to it's associated libvirt API domain handle
- *
- *  @return execution status code
- */
-libvirt::status_code
-libvirt::domain::table
-(
-    const libvirt::connection_t    &connection, 
-          libvirt::domain::table_t &domain_table
-) noexcept
-{
-    // Use libvirt API to get the collection of domains
-    libvirt::virDomain **domains = nullptr;
-    std::size_t number_of_domains = libvirt::virConnectListAllDomains
-    (
-        connection.get(), &domains,
-        libvirt::domain::domains_active_running_flag
-    );
-    if (number_of_domains < 0)
-    {
-        util::log::record
-        (
-            "Unable to retrieve domain data through libvirt API",
-            util::log::type::ERROR
-        );
-
-        return EXIT_FAILURE;
-    }
-
-    // Transfer control of domain handles to table structure paired to uuids
-    for (libvirt::domain::rank_t rank = 0; rank < number_of_domains; ++rank)
-    {
-        // Get UUID defined by libvirt
-        char uuid[libvirt::domain::uuid_length];
-        libvirt::status_code status 
-            = libvirt::virDomainGetUUIDString(domains[rank], uuid);
-        if (static_cast<bool>(status))
-        {
-            util::log::record
-            (
-                "Unable to retrieve domain id through libvirt API",
-                util::log::type::FLAG
-            );
-
-            continue;
-        }
-
-        // Add UUID-domain-handle key-value pair to table
-        domain_table[std::string(uuid)] = domain_t
-        (
-            domains[rank],
-            [](libvirt::virDomain *domain)
-            {
-                if (domain != nullptr)
-                    libvirt::virDomainFree(domain);
-            }
-        ); 
-    }
-
-    // Free API collection
-    std::free(domains);
-
-    return EXIT_SUCCESS;
-}
-
-
 /**
  *  @brief Statistics Collection Period Setter
  *
  *  @param current domain table:  current iteration UUID-to-domain table
  *  @param previous domain UUIDs: previous iteration domain UUIDs
- *  @param interval:              load balancer launching interval and 
- *                                collection period
+ *  @param period:                guest balloon statistics collection 
+ *                                period
+ *  @param attribute cache:       cache to count calls made in
  *
  *  @details Sets statistics collection period for any domains which have
- *  had the period set yet
+ *  had the period set yet; a period of zero would disable collection, thus
+ *  periods are at least one second
  *
  *  @return execution status code
  */
@@ -102,7 +36,8 @@ libvirt::domain::set_collection_period
 (
           libvirt::domain::table_t    &curr_domain_table,
           libvirt::domain::uuid_set_t &prev_domain_uuids,
-    const std::chrono::milliseconds   &interval
+    const std::chrono::seconds        &period,
+          libvirt::attribute::cache_t &attribute_cache
 ) noexcept
 {
     // Validate tables are filled
@@ -117,8 +52,12 @@ libvirt::domain::set_collection_period
         return EXIT_FAILURE;
     }
 
+    const util::stat::sint_t collection_period = static_cast<util::stat::sint_t>
+    (
+        std::max<std::chrono::seconds::rep>(period.count(), 1)
+    );
+
     // Set all domains if none were set before
-    using std::chrono::duration_cast;
     if (prev_domain_uuids.empty())
     {
         util::log::record
@@ -131,10 +70,11 @@ libvirt::domain::set_collection_period
         // Set statistics collection period for all domains
         for (const auto &[uuid, domain]: curr_domain_table) 
         {
-            status_code status = libvirt::virDomainSetMemoryStatsPeriod
+            libvirt::attribute::count(attribute_cache, 1);
+            status_code status = libvirt::backend::current().statistics_period
             (
                 domain.get(), 
-                duration_cast<std::chrono::seconds>(interval).count(), 
+                collection_period, 
                 libvirt::domain::domain_affect_current_flag
             );
 
@@ -159,10 +99,11 @@ libvirt::domain::set_collection_period
         if (prev_domain_uuids.find(uuid) != prev_domain_uuids.end())
             continue; 
 
-        status_code status = libvirt::virDomainSetMemoryStatsPeriod
+        libvirt::attribute::count(attribute_cache, 1);
+        status_code status = libvirt::backend::current().statistics_period
         (
             domain.get(), 
-            duration_cast<std::chrono::seconds>(interval).count(), 
+            collection_period, 
             libvirt::domain::domain_affect_current_flag
         );
 
@@ -223,19 +164,24 @@ libvirt::domain::domain_uuids
 /**
  *  @brief Domain Memory Data Collector
  *
- *  @param domain table: UUID-to-domain table to use domain refernces from
- *  @param domain data:  structure reference to write to
+ *  @param domain table:    UUID-to-domain table to use domain refernces from
+ *  @param domain data:     structure reference to write to
+ *  @param attribute cache: slowly changing attributes kept between calls
  *
  *  @details Collect data about domain memory for all domains required by 
- *  scheduler to determine reallocation memory chunks 
+ *  scheduler to determine reallocation memory chunks. Maximum memory and
+ *  number of vCPUs, and hugepage backing when asked for, are taken from the
+ *  attribute cache when fresh, so a domain costs a single statistics call
+ *  unless its CPU time is asked for; calls made are counted on the cache.
  *
  *  @return execution status code
  */
 libvirt::status_code
 libvirt::domain::data
 (
-     libvirt::domain::table_t &domain_table, 
-     libvirt::domain::data_t  &domain_data
+     libvirt::domain::table_t    &domain_table, 
+     libvirt::domain::data_t     &domain_data,
+     libvirt::attribute::cache_t &attribute_cache
 ) noexcept
 {
     // Validate table is filled
@@ -267,104 +213,605 @@ libvirt::domain::data
     // Get memory statistics for each domain
     for (auto &[uuid, domain]: domain_table)
     { 
-        libvirt::status_code status;
-
         // Pass on domain reference 
         libvirt::domain::datum_t datum;
         datum.uuid   = uuid;
         datum.domain = std::move(domain);
 
-        // Get memory statistics for this domain 
-        libvirt::domain::memory_statistics_t memory_statistics;
-        status = libvirt::virDomainMemoryStats
+        libvirt::status_code status
+            = libvirt::domain::statistics(datum, attribute_cache);
+        if (static_cast<bool>(status))
+            return EXIT_FAILURE;
+
+        domain_data.emplace_back(std::move(datum));
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+
+/**
+ *  @brief Domain Memory Statistics Collector
+ *
+ *  @param datum:           domain to collect for, with its UUID and handle
+ *  @param attribute cache: slowly changing attributes kept between calls
+ *
+ *  @details Collects the statistics of a single domain, such that domains
+ *  can be collected apart; calls may block for as long as the guest does
+ *
+ *  @return execution status code
+ */
+libvirt::status_code
+libvirt::domain::statistics
+(
+    libvirt::domain::datum_t    &datum,
+    libvirt::attribute::cache_t &attribute_cache
+) noexcept
+{
+    libvirt::status_code status;
+
+    // Get memory statistics for this domain 
+    libvirt::domain::memory_statistics_t memory_statistics;
+    util::stat::sint_t number_of_memory_statistics 
+        = libvirt::backend::current().memory_statistics
+    (
+        datum.domain.get(),
+        memory_statistics.data(),
+        static_cast<util::stat::sint_t>
         (
-            datum.domain.get(),
-            memory_statistics.data(),
-            static_cast<util::stat::sint_t>
-            (
-                libvirt::domain::number_of_domain_memory_statistics
-            ),
-            libvirt::FLAG_DEF
+            libvirt::domain::number_of_domain_memory_statistics
+        ),
+        libvirt::FLAG_DEF
+    );
+    if (number_of_memory_statistics < 0)
+    {
+        util::log::record
+        (
+            "Unable to retrieve domain " + datum.uuid
+                + "'s memory statistics through libvirt API", 
+            util::log::type::FLAG
         );
-        if (static_cast<bool>(status))
-        {
-            util::log::record
-            (
-                "Unable to retrieve domain " + uuid
-                    + "'s memory statistics through libvirt API", 
-                util::log::type::FLAG
-            );
-        }
 
-        // Get domain's maxmimum memory limit and number of vCPUs
-        libvirt::virDomainInfo information; 
-        status = libvirt::virDomainGetInfo
+        number_of_memory_statistics = 0;
+    }
+
+    libvirt::attribute::count(attribute_cache, 1);
+
+    // Get domain's maxmimum memory limit and number of vCPUs unless
+    // cached recently, and its CPU time every iteration when asked for
+    libvirt::attribute::attributes_t attributes;
+    const bool cached 
+        = libvirt::attribute::lookup(attribute_cache, datum.uuid, attributes);
+    libvirt::virDomainInfo information = {};
+    status = EXIT_SUCCESS;
+    if (!cached || attribute_cache.parameters.cpu_time)
+    {
+        status = libvirt::backend::current().information
         (
             datum.domain.get(), 
             &information
         );
+        libvirt::attribute::count(attribute_cache, 1);
         if (static_cast<bool>(status))
         {
             util::log::record
             (
-                "Unable to retrieve domain " + uuid
+                "Unable to retrieve domain " + datum.uuid
                     + "'s maxmimum memory limit through libvirt API", 
                 util::log::type::FLAG
             );
         }
-        datum.domain_memory_limit = information.maxMem;
-        datum.number_of_vCPUs     = information.nrVirtCpu;
-
-        // Get remaining statistics 
-        bool domain_extra_found = false, balloon_used_found = false;
-        using memory_statistic_t = libvirt::virDomainMemoryStatStruct;
-        for (const memory_statistic_t &statistic: memory_statistics)
+        else
         {
-            libvirt::flag_code flag 
-                = static_cast<libvirt::flag_code>(statistic.tag);
+            datum.cpu_time 
+                = static_cast<util::stat::slong_t>(information.cpuTime);
+        }
+    }
+    if (!cached)
+    {
+        attributes.domain_memory_limit = information.maxMem;
+        attributes.number_of_vCPUs     = information.nrVirtCpu;
 
-            // Get the memory used up by balloon
-            if (flag == memory_statistic_balloon_used)
+        // Get domain's hugepage backing from its definition
+        if (attribute_cache.parameters.memory_backing)
+        {
+            char *xml = libvirt::virDomainGetXMLDesc(datum.domain.get(), 0);
+            libvirt::attribute::count(attribute_cache, 1);
+            if (xml == nullptr 
+                || static_cast<bool>
+                   (
+                       libvirt::domain::memory_backing
+                       (
+                           std::string(xml), attributes.hugepage_size
+                       )
+                   ))
             {
-                datum.balloon_memory_used
-                    = static_cast<util::stat::slong_t>(statistic.val);
+                util::log::record
+                (
+                    "Unable to retrieve domain " + datum.uuid
+                        + "'s memory backing through libvirt API", 
+                    util::log::type::FLAG
+                );
 
-                balloon_used_found = true;
+                status = EXIT_FAILURE;
             }
+            std::free(xml);
+        }
 
-            // Get the memory unused by domain
-            if (flag == memory_statistic_domain_extra)
-            {
-                datum.domain_memory_extra
-                    = static_cast<util::stat::slong_t>(statistic.val);
+        // Only attributes read successfully are kept
+        if (!static_cast<bool>(status))
+            libvirt::attribute::store(attribute_cache, datum.uuid, attributes);
+    }
+    datum.domain_memory_limit = attributes.domain_memory_limit;
+    datum.number_of_vCPUs     = attributes.number_of_vCPUs;
+    datum.hugepage_size       = attributes.hugepage_size;
+
+    // Get remaining statistics 
+    bool domain_extra_found = false, balloon_used_found = false;
+    using memory_statistic_t = libvirt::virDomainMemoryStatStruct;
+    for 
+    (
+        util::stat::sint_t index = 0; 
+        index < number_of_memory_statistics; 
+        ++index
+    )
+    {
+        const memory_statistic_t &statistic = memory_statistics[index];
+        libvirt::flag_code flag 
+            = static_cast<libvirt::flag_code>(statistic.tag);
 
-                domain_extra_found = true;
-            }
+        // Get the memory used up by balloon
+        if (flag == memory_statistic_balloon_used)
+        {
+            datum.balloon_memory_used
+                = static_cast<util::stat::slong_t>(statistic.val);
+
+            balloon_used_found = true;
         }
-        if (!balloon_used_found)
+
+        // Get the memory unused by domain
+        if (flag == memory_statistic_domain_extra)
         {
-            util::log::record
-            (
-                "Unable to retrieve domain " + uuid
-                    + "'s balloon driver's used memory through libvirt API", 
-                util::log::type::ERROR
-            );
+            datum.domain_memory_extra
+                = static_cast<util::stat::slong_t>(statistic.val);
 
-            return EXIT_FAILURE;
+            domain_extra_found = true;
+        }
+
+        // Get optional working set statistics
+        const util::stat::slong_t value
+            = static_cast<util::stat::slong_t>(statistic.val);
+
+        if (flag == memory_statistic_major_faults)
+            datum.major_faults = value;
+
+        if (flag == memory_statistic_swap_in)
+            datum.swap_in = value;
+
+        if (flag == memory_statistic_swap_out)
+            datum.swap_out = value;
+
+        if (flag == memory_statistic_memory_usable)
+            datum.memory_usable = value;
+
+        if (flag == memory_statistic_disk_caches)
+            datum.disk_caches = value;
+
+        if (flag == memory_statistic_resident)
+            datum.resident_memory = value;
+    }
+    if (!balloon_used_found)
+    {
+        util::log::record
+        (
+            "Unable to retrieve domain " + datum.uuid
+                + "'s balloon driver's used memory through libvirt API", 
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+    if (!domain_extra_found)
+    {
+        util::log::record
+        (
+            "Unable to retrieve domain " + datum.uuid
+                + "'s unused memory through libvirt API", 
+            util::log::type::ERROR
+        );
+        
+        return EXIT_FAILURE;
+    } 
+
+    return EXIT_SUCCESS;
+}
+
+
+
+/**
+ *  @brief NUMA Nodeset Parser
+ *
+ *  @param nodeset: nodeset string in libvirt format such as "0-1,3"
+ *  @param cells:   structure reference to write to
+ *
+ *  @return whether nodeset was parsed
+ */
+bool
+static parse_nodeset
+(
+    const std::string                 &nodeset,
+          libvirt::domain::cell_set_t &cells
+) noexcept
+{
+    try
+    {
+        std::size_t begin = 0;
+        while (begin < nodeset.size())
+        {
+            std::size_t end = nodeset.find(',', begin);
+            if (end == std::string::npos)
+                end = nodeset.size();
+
+            const std::string range = nodeset.substr(begin, end - begin);
+            const std::size_t dash  = range.find('-');
+
+            const libvirt::hardware::cell_t first = std::stoi(range);
+            const libvirt::hardware::cell_t last  = dash == std::string::npos
+                ? first
+                : std::stoi(range.substr(dash + 1));
+            for (libvirt::hardware::cell_t cell = first; cell <= last; ++cell)
+                cells.insert(cell);
+
+            begin = end + 1;
+        }
+    }
+
+    catch (const std::exception &exception)
+    {
+        cells.clear();
+        return false;
+    }
+
+    return !cells.empty();
+}
+
+
+/**
+ *  @brief Domain Numatune Nodeset Fetcher
+ *
+ *  @param domain:          domain to fetch nodeset of
+ *  @param attribute cache: cache to count calls made in
+ *  @param nodeset:         variable reference to write to; empty when the
+ *                          domain has no numatune
+ *
+ *  @return whether domain's NUMA parameters were read
+ */
+bool
+static numa_nodeset
+(
+    libvirt::virDomainPtr        domain,
+    libvirt::attribute::cache_t &attribute_cache,
+    std::string                 &nodeset
+) noexcept
+{
+    const libvirt::backend::backend_t &backend = libvirt::backend::current();
+
+    nodeset.clear();
+
+    // Number of parameters, then parameters themselves
+    util::stat::sint_t number_of_parameters = 0;
+    libvirt::attribute::count(attribute_cache, 1);
+    util::stat::sint_t status = backend.numa_parameters
+    (
+        domain, nullptr, &number_of_parameters, libvirt::FLAG_DEF
+    );
+    if (status < 0)
+        return false;
+    if (number_of_parameters <= 0)
+        return true;
+
+    std::vector<libvirt::virTypedParameter> parameters;
+    try
+    {
+        parameters.resize(static_cast<std::size_t>(number_of_parameters));
+    }
+
+    catch (const std::exception &exception)
+    {
+        return false;
+    }
+
+    libvirt::attribute::count(attribute_cache, 1);
+    status = backend.numa_parameters
+    (
+        domain, parameters.data(), &number_of_parameters, libvirt::FLAG_DEF
+    );
+    if (status < 0)
+        return false;
+
+    bool read = true;
+    for (util::stat::sint_t index = 0; index < number_of_parameters; ++index)
+    {
+        const libvirt::virTypedParameter &parameter = parameters[index];
+        if (libvirt::domain::numa_parameter_nodeset != parameter.field
+            || parameter.type != libvirt::VIR_TYPED_PARAM_STRING
+            || parameter.value.s == nullptr)
+            continue;
+
+        try
+        {
+            nodeset = parameter.value.s;
+        }
+
+        catch (const std::exception &exception)
+        {
+            read = false;
+        }
+    }
+    libvirt::virTypedParamsClear(parameters.data(), number_of_parameters);
+
+    return read;
+}
+
+
+/**
+ *  @brief Domain NUMA Placement Collector
+ *
+ *  @param domain data:     domain data to write cells to
+ *  @param cpu cells:       NUMA cell of each pCPU
+ *  @param attribute cache: cache of domains' numatune nodesets, and to count
+ *                          calls made in
+ *
+ *  @details Determines the NUMA cells each domain's memory is placed on from
+ *  its numatune nodeset, or when it has none, from the cells of the pCPUs its
+ *  vCPUs currently run on. Nodesets are kept in the attribute cache and only
+ *  fetched again once dropped by a lifecycle or tunable event or by age, so
+ *  steady iterations only call for domains without one. Domains whose
+ *  placement cannot be determined are left without cells.
+ *
+ *  @return execution status code
+ */
+libvirt::status_code
+libvirt::domain::placement
+(
+          libvirt::domain::data_t        &domain_data,
+    const libvirt::hardware::cpu_cells_t &cpu_cells,
+          libvirt::attribute::cache_t    &attribute_cache
+) noexcept
+{
+    const libvirt::backend::backend_t &backend = libvirt::backend::current();
+
+    for (libvirt::domain::datum_t &datum: domain_data)
+    {
+        datum.cells.clear();
+
+        // Get numatune nodeset, cached unless dropped
+        libvirt::attribute::placement_t placement;
+        if (!libvirt::attribute::lookup(attribute_cache, datum.uuid, placement)
+            && numa_nodeset
+               (
+                   datum.domain.get(), attribute_cache, placement.nodeset
+               ))
+            libvirt::attribute::store(attribute_cache, datum.uuid, placement);
+
+        if (!placement.nodeset.empty())
+            parse_nodeset(placement.nodeset, datum.cells);
+        if (!datum.cells.empty() || cpu_cells.empty())
+            continue;
+
+        // Fall back to cells of pCPUs domain's vCPUs run on
+        std::vector<libvirt::virVcpuInfo> vCPUs;
+        try
+        {
+            vCPUs.resize(datum.number_of_vCPUs);
         }
-        if (!domain_extra_found)
+
+        catch (const std::exception &exception)
+        {
+            continue;
+        }
+
+        libvirt::attribute::count(attribute_cache, 1);
+        const util::stat::sint_t number_of_vCPUs = backend.vCPUs
+        (
+            datum.domain.get(),
+            vCPUs.data(),
+            static_cast<util::stat::sint_t>(vCPUs.size()),
+            nullptr,
+            0
+        );
+        for (util::stat::sint_t rank = 0; rank < number_of_vCPUs; ++rank)
+        {
+            const util::stat::sint_t cpu = vCPUs[rank].cpu;
+            if (cpu >= 0 && static_cast<std::size_t>(cpu) < cpu_cells.size())
+                datum.cells.insert(cpu_cells[cpu]);
+        }
+        if (datum.cells.empty())
         {
             util::log::record
             (
-                "Unable to retrieve domain " + uuid
-                    + "'s unused memory through libvirt API", 
-                util::log::type::ERROR
+                "Unable to determine NUMA placement of domain " + datum.uuid,
+                util::log::type::FLAG
             );
-            
-            return EXIT_FAILURE;
-        } 
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ *  @brief XML Attribute Reader
+ *
+ *  @param element: opening tag of element to read
+ *  @param name:    attribute name
+ *  @param value:   variable reference to write to
+ *
+ *  @return whether attribute was found
+ */
+bool
+static xml_attribute
+(
+    const std::string &element,
+    const std::string &name,
+          std::string &value
+) noexcept
+{
+    const std::size_t position = element.find(" " + name + "=");
+    if (position == std::string::npos)
+        return false;
+
+    const std::size_t open = position + name.size() + 2;
+    if (open >= element.size())
+        return false;
+
+    const std::size_t close = element.find(element[open], open + 1);
+    if (close == std::string::npos)
+        return false;
+
+    value = element.substr(open + 1, close - open - 1);
+
+    return true;
+}
+
+
+/**
+ *  @brief Memory Backing Parser
+ *
+ *  @param XML:           domain definition
+ *  @param hugepage size: variable reference to write hugepage size in KiB
+ *                        to; zero when domain is not hugepage backed
+ *
+ *  @details Reads the hugepages element of the domain's memory backing, such
+ *  as
+ *
+ *      <memoryBacking>
+ *        <hugepages>
+ *          <page size='1' unit='GiB'/>
+ *        </hugepages>
+ *      </memoryBacking>
+ *
+ *  Hugepages without a page size are backed by the host's default hugepage
+ *  size. Only the first page size is read for domains mixing sizes across
+ *  guest nodes.
+ *
+ *  @return execution status code
+ */
+libvirt::status_code
+libvirt::domain::memory_backing
+(
+    const std::string         &xml,
+          util::stat::slong_t &hugepage_size
+) noexcept
+{
+    hugepage_size = 0;
+
+    const std::size_t begin = xml.find("<memoryBacking>");
+    if (begin == std::string::npos)
+        return EXIT_SUCCESS;
+
+    const std::size_t end = xml.find("</memoryBacking>", begin);
+    if (end == std::string::npos)
+    {
+        util::log::record
+        (
+            "Memory backing definition is not closed",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+    const std::string backing = xml.substr(begin, end - begin);
+
+    if (backing.find("<hugepages") == std::string::npos)
+        return EXIT_SUCCESS;
+
+    hugepage_size = hugepage_default_size;
+
+    const std::size_t page = backing.find("<page ");
+    if (page == std::string::npos)
+        return EXIT_SUCCESS;
+
+    const std::string element
+        = backing.substr(page, backing.find('>', page) - page);
+    std::string size, unit;
+    static_cast<void>(xml_attribute(element, "unit", unit));
+
+    util::stat::slong_t kibibytes_per_unit = 0;
+    if (unit.empty() || unit == "k" || unit == "KiB")
+        kibibytes_per_unit = 1;
+    else if (unit == "M" || unit == "MiB")
+        kibibytes_per_unit = 1LL << 10;
+    else if (unit == "G" || unit == "GiB")
+        kibibytes_per_unit = 1LL << 20;
+
+    util::stat::slong_t parsed = 0;
+    try
+    {
+        std::size_t length = 0;
+        if (xml_attribute(element, "size", size))
+            parsed = std::stoll(size, &length);
+        if (length != size.size())
+            parsed = 0;
+    }
+
+    catch (const std::exception &exception)
+    {
+        parsed = 0;
     }
 
+    // Domain stays hugepage backed at the default size when size is unread
+    if (parsed <= 0 || kibibytes_per_unit == 0)
+    {
+        util::log::record
+        (
+            "Hugepage backing has malformed page size",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    hugepage_size = parsed * kibibytes_per_unit;
+
+    return EXIT_SUCCESS;
+}
+
+
+/**
+ *  @brief Domain Metadata Retriever
+ *
+ *  @param datum: domain to read metadata of
+ *  @param URI:   namespace URI of metadata element
+ *  @param XML:   variable reference to write to
+ *
+ *  @details Reads the custom metadata element of the domain's definition
+ *  under the given namespace; domains without such an element are not an
+ *  error worth recording
+ *
+ *  @return execution status code
+ */
+libvirt::status_code
+libvirt::domain::metadata
+(
+    const libvirt::domain::datum_t &datum,
+    const std::string              &uri,
+          std::string              &xml
+) noexcept
+{
+    char *element = libvirt::virDomainGetMetadata
+    (
+        datum.domain.get(),
+        metadata_element,
+        uri.c_str(),
+        domain_affect_current_flag
+    );
+    if (element == nullptr)
+        return EXIT_FAILURE;
+
+    xml = std::string(element);
+    std::free(element);
+
     return EXIT_SUCCESS;
 }
 
@@ -375,7 +822,18 @@ libvirt::domain::data
  *  @details Create empty datum struct
  */
 libvirt::domain::datum_t::datum_t(): 
-    domain(nullptr) {}
+    domain(nullptr),
+    major_faults(memory_statistic_unreported),
+    swap_in(memory_statistic_unreported),
+    swap_out(memory_statistic_unreported),
+    memory_usable(memory_statistic_unreported),
+    disk_caches(memory_statistic_unreported),
+    resident_memory(memory_statistic_unreported),
+    hugepage_size(0),
+    cpu_time(memory_statistic_unreported),
+    domain_memory_delta(0.0),
+    domain_memory_pressure(0.0),
+    stale(false) {}
 
 
 /**
@@ -387,7 +845,19 @@ libvirt::domain::datum_t::datum_t():
  *  @param balloon memory used: memory used by domain's balloon driver in bytes
  *  @param domain memory extra: memory unused by domain in bytes
  *  @param domain memory limit: memory limit enforced by domain in bytes
+ *  @param major faults:        guest major page faults since boot
+ *  @param swap in:             memory swapped in by guest since boot
+ *  @param swap out:            memory swapped out by guest since boot
+ *  @param memory usable:       memory usable by guest without swapping
+ *  @param disk caches:         memory guest uses for reclaimable disk caches
+ *  @param resident memory:     memory of domain resident on host
+ *  @param hugepage size:       size of hugepages backing domain in KiB, if any
+ *  @param CPU time:            CPU time used by domain since boot in ns
  *  @param domain memory delta: memory change determined by scheduler in bytes
+ *  @param memory pressure:     pressure score determined by scheduler
+ *  @param cells:               NUMA cells domain memory is placed on
+ *  @param stale:               whether statistics are from an earlier
+ *                              iteration
  *
  *  @details Copy over simple values and move domain handle to new object
  */
@@ -401,7 +871,18 @@ libvirt::domain::datum_t::datum_t
     balloon_memory_used(other.balloon_memory_used),
     domain_memory_extra(other.domain_memory_extra),
     domain_memory_limit(other.domain_memory_limit),
-    domain_memory_delta(other.domain_memory_delta)
+    major_faults(other.major_faults),
+    swap_in(other.swap_in),
+    swap_out(other.swap_out),
+    memory_usable(other.memory_usable),
+    disk_caches(other.disk_caches),
+    resident_memory(other.resident_memory),
+    hugepage_size(other.hugepage_size),
+    cpu_time(other.cpu_time),
+    domain_memory_delta(other.domain_memory_delta),
+    domain_memory_pressure(other.domain_memory_pressure),
+    cells(std::move(other.cells)),
+    stale(other.stale)
 {}
 
 
@@ -418,15 +899,61 @@ libvirt::domain::datum_t::operator=
 {
     if (this != &other)
     {
-        this->uuid                = other.uuid;
-        this->domain              = std::move(other.domain);
-        this->number_of_vCPUs     = other.number_of_vCPUs; 
-        this->balloon_memory_used = other.balloon_memory_used; 
-        this->domain_memory_extra = other.domain_memory_extra; 
-        this->domain_memory_extra = other.domain_memory_extra; 
-        this->domain_memory_limit = other.domain_memory_limit; 
-        this->domain_memory_delta = other.domain_memory_delta; 
+        this->uuid                   = other.uuid;
+        this->domain                 = std::move(other.domain);
+        this->number_of_vCPUs        = other.number_of_vCPUs; 
+        this->balloon_memory_used    = other.balloon_memory_used; 
+        this->domain_memory_extra    = other.domain_memory_extra; 
+        this->domain_memory_limit    = other.domain_memory_limit; 
+        this->major_faults           = other.major_faults; 
+        this->swap_in                = other.swap_in; 
+        this->swap_out               = other.swap_out; 
+        this->memory_usable          = other.memory_usable; 
+        this->disk_caches            = other.disk_caches; 
+        this->resident_memory        = other.resident_memory; 
+        this->hugepage_size          = other.hugepage_size; 
+        this->cpu_time               = other.cpu_time; 
+        this->domain_memory_delta    = other.domain_memory_delta; 
+        this->domain_memory_pressure = other.domain_memory_pressure; 
+        this->cells                  = std::move(other.cells);
+        this->stale                  = other.stale;
     }
 
     return *this;
 }
+
+
+/**
+ *  @brief Domain Datum Copy
+ *
+ *  @param source:      datum to copy statistics from
+ *  @param destination: datum to copy statistics to
+ *
+ *  @details Copy over simple values, leaving the domain handle in place, as
+ *  when keeping a domain's last statistics
+ */
+void
+libvirt::domain::copy
+(
+    const libvirt::domain::datum_t &source,
+          libvirt::domain::datum_t &destination
+) noexcept
+{
+    destination.uuid                   = source.uuid;
+    destination.number_of_vCPUs        = source.number_of_vCPUs;
+    destination.balloon_memory_used    = source.balloon_memory_used;
+    destination.domain_memory_extra    = source.domain_memory_extra;
+    destination.domain_memory_limit    = source.domain_memory_limit;
+    destination.major_faults           = source.major_faults;
+    destination.swap_in                = source.swap_in;
+    destination.swap_out               = source.swap_out;
+    destination.memory_usable          = source.memory_usable;
+    destination.disk_caches            = source.disk_caches;
+    destination.resident_memory        = source.resident_memory;
+    destination.hugepage_size          = source.hugepage_size;
+    destination.cpu_time               = source.cpu_time;
+    destination.domain_memory_delta    = source.domain_memory_delta;
+    destination.domain_memory_pressure = source.domain_memory_pressure;
+    destination.cells                  = source.cells;
+    destination.stale                  = source.stale;
+}
@@ -6,13 +6,18 @@
 #include <cstddef>
 #include <functional>
 #include <memory>
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 
 #include <lib/libvirt.hpp>
+#include <registry/registry.hpp>
 #include <stat/statistics.hpp>
 
+#include "attribute/attribute.hpp"
+#include "hardware/hardware.hpp"
+
 
 /**
  *  @brief Domain Utility Header
@@ -26,15 +31,6 @@ namespace domain
 {
 
 // Domain data constants
-static constexpr util::stat::uint_t 
-domains_active_running_flag = static_cast<util::stat::uint_t>
-(
-    VIR_CONNECT_LIST_DOMAINS_ACTIVE | VIR_CONNECT_LIST_DOMAINS_RUNNING
-);
-
-static constexpr std::size_t 
-uuid_length = static_cast<std::size_t>(VIR_UUID_STRING_BUFLEN);
-
 static constexpr util::stat::uint_t 
 domain_affect_current_flag
     = static_cast<util::stat::uint_t>(VIR_DOMAIN_AFFECT_CURRENT);
@@ -48,21 +44,52 @@ static constexpr flag_code
 memory_statistic_domain_extra
     = static_cast<flag_code>(VIR_DOMAIN_MEMORY_STAT_UNUSED);
 
+static constexpr flag_code 
+memory_statistic_major_faults
+    = static_cast<flag_code>(VIR_DOMAIN_MEMORY_STAT_MAJOR_FAULT);
+
+static constexpr flag_code 
+memory_statistic_swap_in
+    = static_cast<flag_code>(VIR_DOMAIN_MEMORY_STAT_SWAP_IN);
+
+static constexpr flag_code 
+memory_statistic_swap_out
+    = static_cast<flag_code>(VIR_DOMAIN_MEMORY_STAT_SWAP_OUT);
+
+static constexpr flag_code 
+memory_statistic_memory_usable
+    = static_cast<flag_code>(VIR_DOMAIN_MEMORY_STAT_USABLE);
+
+static constexpr flag_code 
+memory_statistic_disk_caches
+    = static_cast<flag_code>(VIR_DOMAIN_MEMORY_STAT_DISK_CACHES);
+
+static constexpr flag_code 
+memory_statistic_resident
+    = static_cast<flag_code>(VIR_DOMAIN_MEMORY_STAT_RSS);
+
 static constexpr flag_code 
 number_of_domain_memory_statistics 
     = static_cast<flag_code>(VIR_DOMAIN_MEMORY_STAT_NR);
 
-// data types and structure types
-using rank_t   = std::size_t;
-using domain_t = std::unique_ptr
-<
-    virDomain,
-    std::function<void (virDomain *)>
->;
+// Value of optional statistics a guest does not report
+static constexpr util::stat::slong_t memory_statistic_unreported = -1;
+
+// Metadata constants
+static constexpr util::stat::sint_t
+metadata_element = static_cast<util::stat::sint_t>(VIR_DOMAIN_METADATA_ELEMENT);
+
+// Hugepage size of domains backed by the host's default hugepage size
+static constexpr util::stat::slong_t hugepage_default_size = -1;
+
+// NUMA parameter constants
+static const std::string 
+numa_parameter_nodeset = std::string(VIR_DOMAIN_NUMA_NODESET);
 
-using uuid_t     = std::string;
+// data types and structure types; domain handle tables are shared with the
+// CPU manager through the registry
 using uuid_set_t = std::unordered_set<uuid_t>;
-using table_t    = std::unordered_map<uuid_t, domain_t>;
+using cell_set_t = std::set<hardware::cell_t>;
 
 typedef struct datum_t
 {
@@ -87,7 +114,18 @@ typedef struct datum_t
     util::stat::slong_t balloon_memory_used;
     util::stat::slong_t domain_memory_extra;
     util::stat::slong_t domain_memory_limit;
+    util::stat::slong_t major_faults;
+    util::stat::slong_t swap_in;
+    util::stat::slong_t swap_out;
+    util::stat::slong_t memory_usable;
+    util::stat::slong_t disk_caches;
+    util::stat::slong_t resident_memory;
+    util::stat::slong_t hugepage_size;
+    util::stat::slong_t cpu_time;
     std::double_t       domain_memory_delta;
+    std::double_t       domain_memory_pressure;
+    cell_set_t          cells;
+    bool                stale;
 } datum_t;
 
 using data_t = std::vector<datum_t>;
@@ -99,27 +137,61 @@ using memory_statistics_t = std::array
 >;
 
 // Structure creation routines
+status_code
+domain_uuids
+(
+    table_t    &domain_table,
+    uuid_set_t &domain_uuids
+) noexcept;
+
 [[maybe_unused]]
 status_code
-table
+data
 (
-    const connection_t &connection,
-          table_t      &table
+    table_t            &domain_table,
+    data_t             &domain_data,
+    attribute::cache_t &attribute_cache
 ) noexcept;
 
+[[nodiscard("Domain statistics status must be checked")]]
 status_code
-domain_uuids
+statistics
 (
-    table_t    &domain_table,
-    uuid_set_t &domain_uuids
+    datum_t            &datum,
+    attribute::cache_t &attribute_cache
+) noexcept;
+
+void
+copy
+(
+    const datum_t &source,
+          datum_t &destination
 ) noexcept;
 
 [[maybe_unused]]
 status_code
-data
+placement
+(
+          data_t                 &domain_data,
+    const hardware::cpu_cells_t  &cpu_cells,
+          attribute::cache_t     &attribute_cache
+) noexcept;
+
+[[nodiscard("Memory backing parse status must be checked")]]
+status_code
+memory_backing
+(
+    const std::string         &xml,
+          util::stat::slong_t &hugepage_size
+) noexcept;
+
+[[nodiscard("Metadata retrieval status must be checked")]]
+status_code
+metadata
 (
-    table_t &domain_table,
-    data_t  &domain_data
+    const datum_t     &datum,
+    const std::string &uri,
+          std::string &xml
 ) noexcept;
 
 // State modfier rountines
@@ -127,9 +199,10 @@ data
 status_code
 set_collection_period
 (
-          table_t                   &curr_domain_table,
-          uuid_set_t                &prev_domain_uuids,
-    const std::chrono::milliseconds &interval
+          table_t              &curr_domain_table,
+          uuid_set_t           &prev_domain_uuids,
+    const std::chrono::seconds &period,
+          attribute::cache_t   &attribute_cache
 ) noexcept;
 
 } // domain namespace
@@ -1,17 +1,23 @@
 #include <cstdlib>
+#include <memory>
+#include <string>
 
+#include <backend/backend.hpp>
 #include <lib/libvirt.hpp>
 #include <log/record.hpp>
 #include <stat/statistics.hpp>
 
+#include "attribute/attribute.hpp"
+
 #include "hardware.hpp"
 
 
 /**
  *  @brief Hardware Memory Limit Determiner
  *
- *  @param connection:   hypervisor connection via libvirt
- *  @param memory limit: variable reference to write to
+ *  @param connection:      hypervisor connection via libvirt
+ *  @param memory limit:    variable reference to write to
+ *  @param attribute cache: cache to count calls made in
  *
  *  @details Determine hardware memory limit of system for scheduler's use
  *
@@ -20,15 +26,18 @@
 libvirt::status_code
 libvirt::hardware::memory_limit
 (
-    const connection_t        &connection, 
-          util::stat::slong_t &memory_limit
+    const connection_t                &connection, 
+          util::stat::slong_t         &memory_limit,
+          libvirt::attribute::cache_t &attribute_cache
 ) noexcept
 {
     libvirt::status_code status;
+    const libvirt::backend::backend_t &backend = libvirt::backend::current();
 
     // Get number of memory statistics
     util::stat::sint_t number_of_node_memory_statistics = 0;
-    libvirt::virNodeGetMemoryStats
+    libvirt::attribute::count(attribute_cache, 1);
+    backend.node_memory_statistics
     (
         connection.get(), 
         libvirt::hardware::node_memory_all_statistics,
@@ -53,7 +62,8 @@ libvirt::hardware::memory_limit
     (
         number_of_node_memory_statistics
     );
-    status = libvirt::virNodeGetMemoryStats
+    libvirt::attribute::count(attribute_cache, 1);
+    status = backend.node_memory_statistics
     (
         connection.get(), 
         libvirt::hardware::node_memory_all_statistics,
@@ -76,23 +86,208 @@ libvirt::hardware::memory_limit
     bool memory_limit_found = false;
     for (const auto &[field, value]: memory_statistics)
     {
-        memory_limit_found = static_cast<bool>
+        if (std::string(field) != node_memory_statistics_total)
+            continue;
+
+        memory_limit = static_cast<util::stat::slong_t>(value);
+        memory_limit_found = true;
+    }
+    if (!memory_limit_found)
+    {
+        util::log::record
         (
-            std::string(field).compare(node_memory_statistics_total)
+            "Unable to retrieve hardware memory limit",
+            util::log::type::ERROR
         );
-        if (memory_limit_found)
-            memory_limit = static_cast<util::stat::slong_t>(value);
+
+        return EXIT_FAILURE;
     }
-    if (!memory_limit)
+
+    return EXIT_SUCCESS;
+}
+
+
+/**
+ *  @brief NUMA Cell Free Memory Determiner
+ *
+ *  @param connection:        hypervisor connection via libvirt
+ *  @param cells memory free: structure reference to write to
+ *  @param attribute cache:   cache to count calls made in
+ *
+ *  @details Determine free memory of each NUMA cell of the system, in the 
+ *  same units as domain memory statistics, for scheduler's use
+ *
+ *  @return execution status code
+ */
+libvirt::status_code
+libvirt::hardware::cells_memory_free
+(
+    const connection_t                &connection, 
+          libvirt::hardware::cells_t  &cells_memory_free,
+          libvirt::attribute::cache_t &attribute_cache
+) noexcept
+{
+    // Get free memory of every cell in bytes
+    std::vector<unsigned long long> cells_bytes_free
+    (
+        libvirt::hardware::maximum_number_of_cells
+    );
+    libvirt::attribute::count(attribute_cache, 1);
+    util::stat::sint_t number_of_cells = libvirt::virNodeGetCellsFreeMemory
+    (
+        connection.get(),
+        cells_bytes_free.data(),
+        0,
+        libvirt::hardware::maximum_number_of_cells
+    );
+    if (number_of_cells < 1)
     {
         util::log::record
         (
-            "Unable to retrieve hardware memory limit",
+            "Unable to retrieve free memory of NUMA cells through libvirt API",
             util::log::type::ERROR
         );
 
         return EXIT_FAILURE;
     }
 
+    // Convert to kibibytes used by domain memory statistics
+    cells_memory_free.resize(static_cast<std::size_t>(number_of_cells));
+    for (libvirt::hardware::cell_t cell = 0; cell < number_of_cells; ++cell)
+    {
+        cells_memory_free[cell] 
+            = static_cast<util::stat::slong_t>(cells_bytes_free[cell] >> 10);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/**
+ *  @brief XML Attribute Reader
+ *
+ *  @param element:   text of a single XML start tag
+ *  @param attribute: name of attribute to read
+ *  @param value:     variable reference to write to
+ *
+ *  @details Reads an integer attribute quoted with either quote character
+ *
+ *  @return whether attribute was found
+ */
+bool
+static integer_attribute
+(
+    const std::string        &element,
+    const std::string        &attribute,
+          util::stat::sint_t &value
+) noexcept
+{
+    const std::size_t position = element.find(" " + attribute + "=");
+    if (position == std::string::npos)
+        return false;
+
+    try
+    {
+        value = std::stoi(element.substr(position + attribute.size() + 3));
+    }
+
+    catch (const std::exception &exception)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+
+/**
+ *  @brief pCPU to NUMA Cell Mapper
+ *
+ *  @param connection:      hypervisor connection via libvirt
+ *  @param cpu cells:       structure reference to write to
+ *  @param attribute cache: cache to count calls made in
+ *
+ *  @details Reads the host topology of the hypervisor capabilities to map 
+ *  every pCPU rank to the NUMA cell it belongs to
+ *
+ *  @return execution status code
+ */
+libvirt::status_code
+libvirt::hardware::cpu_cells
+(
+    const connection_t                    &connection, 
+          libvirt::hardware::cpu_cells_t  &cpu_cells,
+          libvirt::attribute::cache_t     &attribute_cache
+) noexcept
+{
+    // Get capabilities XML
+    libvirt::attribute::count(attribute_cache, 1);
+    std::unique_ptr<char, decltype(&std::free)> capabilities
+    (
+        libvirt::virConnectGetCapabilities(connection.get()),
+        std::free
+    );
+    if (capabilities == nullptr)
+    {
+        util::log::record
+        (
+            "Unable to retrieve hypervisor capabilities through libvirt API",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+    const std::string xml(capabilities.get());
+    cpu_cells.clear();
+
+    // Walk through each cell's pCPUs
+    std::size_t cell_begin = xml.find("<cell ");
+    while (cell_begin != std::string::npos)
+    {
+        const std::size_t cell_end = xml.find("</cell>", cell_begin);
+        const std::string cell_element
+            = xml.substr(cell_begin, xml.find('>', cell_begin) - cell_begin);
+
+        libvirt::hardware::cell_t cell;
+        if (cell_end == std::string::npos 
+            || !integer_attribute(cell_element, "id", cell))
+        {
+            util::log::record
+            (
+                "Unable to parse NUMA cell of hypervisor capabilities",
+                util::log::type::ERROR
+            );
+
+            return EXIT_FAILURE;
+        }
+
+        std::size_t cpu_begin = xml.find("<cpu ", cell_begin);
+        while (cpu_begin != std::string::npos && cpu_begin < cell_end)
+        {
+            const std::string cpu_element
+                = xml.substr(cpu_begin, xml.find('>', cpu_begin) - cpu_begin);
+
+            util::stat::sint_t cpu;
+            if (integer_attribute(cpu_element, "id", cpu) && cpu >= 0)
+            {
+                if (cpu_cells.size() <= static_cast<std::size_t>(cpu))
+                    cpu_cells.resize(cpu + 1, cell);
+                cpu_cells[cpu] = cell;
+            }
+
+            cpu_begin = xml.find("<cpu ", cpu_begin + 1);
+        }
+
+        cell_begin = xml.find("<cell ", cell_end);
+    }
+    if (cpu_cells.empty())
+    {
+        util::log::record
+        (
+            "Hypervisor capabilities hold no NUMA topology",
+            util::log::type::FLAG
+        );
+    }
+
     return EXIT_SUCCESS;
 }
@@ -6,6 +6,8 @@
 #include <lib/libvirt.hpp>
 #include <stat/statistics.hpp>
 
+#include "attribute/attribute.hpp"
+
 
 /**
  *  @brief Hardware Utility Header
@@ -18,13 +20,46 @@ namespace libvirt
 namespace hardware
 {
 
+// data and structure types
+using cell_t      = util::stat::sint_t;
+using cells_t     = std::vector<util::stat::slong_t>;
+using cpu_cells_t = std::vector<cell_t>;
+
+typedef struct datum_t
+{
+    util::stat::slong_t memory_limit;
+    cells_t             cells_memory_free;
+    cpu_cells_t         cpu_cells;
+} datum_t;
+
 // Retrieve hardware memory limit
 [[maybe_unused]]
 status_code
 memory_limit
 (
     const connection_t        &connection,
-          util::stat::slong_t &memory_limit
+          util::stat::slong_t &memory_limit,
+          attribute::cache_t  &attribute_cache
+) noexcept;
+
+// Retrieve free memory of each NUMA cell
+[[maybe_unused]]
+status_code
+cells_memory_free
+(
+    const connection_t       &connection,
+          cells_t            &cells_memory_free,
+          attribute::cache_t &attribute_cache
+) noexcept;
+
+// Retrieve NUMA cell of each pCPU
+[[maybe_unused]]
+status_code
+cpu_cells
+(
+    const connection_t       &connection,
+          cpu_cells_t        &cpu_cells,
+          attribute::cache_t &attribute_cache
 ) noexcept;
 
 // Statistics definitions
@@ -37,6 +72,8 @@ static const util::stat::sint_t
 node_memory_all_statistics
     = static_cast<util::stat::sint_t>(VIR_NODE_MEMORY_STATS_ALL_CELLS);
 
+static constexpr util::stat::sint_t maximum_number_of_cells = 1 << 10;
+
 } // hardware namespace
 
-} // libvirt namespaceA
+} // libvirt namespace
@@ -0,0 +1,395 @@
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <string>
+
+#include <lib/libvirt.hpp>
+#include <log/record.hpp>
+#include <stat/statistics.hpp>
+
+#include "domain/domain.hpp"
+
+#include "hotplug.hpp"
+
+
+/**
+ *  @brief XML Element Reader
+ *
+ *  @param XML:   document to search
+ *  @param name:  element name
+ *  @param text:  variable reference to write element text to
+ *  @param unit:  variable reference to write unit attribute to, if any
+ *
+ *  @details Reads the first element of the given name that holds text
+ *
+ *  @return whether element was found
+ */
+bool
+static element
+(
+    const std::string &xml,
+    const std::string &name,
+          std::string &text,
+          std::string &unit
+) noexcept
+{
+    std::size_t position = 0;
+    while (true)
+    {
+        position = xml.find("<" + name, position);
+        if (position == std::string::npos)
+            return false;
+
+        // Element name must stand on its own
+        const std::size_t after = position + name.size() + 1;
+        if (after >= xml.size() || (xml[after] != '>' && xml[after] != ' '))
+        {
+            position = after;
+            continue;
+        }
+
+        const std::size_t open = xml.find('>', after);
+        if (open == std::string::npos || xml[open - 1] == '/')
+            return false;
+
+        const std::size_t close = xml.find('<', open + 1);
+        if (close == std::string::npos)
+            return false;
+
+        text = xml.substr(open + 1, close - open - 1);
+        unit.clear();
+
+        const std::size_t attribute = xml.find("unit=", after);
+        if (attribute != std::string::npos && attribute < open)
+        {
+            const char quote = xml[attribute + 5];
+            const std::size_t end = xml.find(quote, attribute + 6);
+            if (end != std::string::npos && end < open)
+                unit = xml.substr(attribute + 6, end - attribute - 6);
+        }
+
+        return true;
+    }
+}
+
+
+/**
+ *  @brief Memory Size Reader
+ *
+ *  @param text: size as written in domain XML
+ *  @param unit: libvirt scaled unit; KiB when empty
+ *  @param size: variable reference to write size in KiB to
+ *
+ *  @return whether size was read
+ */
+bool
+static memory_size
+(
+    const std::string         &text,
+    const std::string         &unit,
+          util::stat::slong_t &size
+) noexcept
+{
+    util::stat::slong_t bytes_per_unit;
+    if (unit == "b" || unit == "bytes")
+        bytes_per_unit = 1;
+    else if (unit == "KB")
+        bytes_per_unit = 1000;
+    else if (unit.empty() || unit == "k" || unit == "KiB")
+        bytes_per_unit = 1LL << 10;
+    else if (unit == "MB")
+        bytes_per_unit = 1000 * 1000;
+    else if (unit == "M" || unit == "MiB")
+        bytes_per_unit = 1LL << 20;
+    else if (unit == "GB")
+        bytes_per_unit = 1000 * 1000 * 1000;
+    else if (unit == "G" || unit == "GiB")
+        bytes_per_unit = 1LL << 30;
+    else if (unit == "T" || unit == "TiB")
+        bytes_per_unit = 1LL << 40;
+    else
+        return false;
+
+    try
+    {
+        std::size_t length = 0;
+        const util::stat::slong_t parsed = std::stoll(text, &length);
+        if (length != text.size() || parsed < 0)
+            return false;
+
+        size = parsed * bytes_per_unit / (1LL << 10);
+        return true;
+    }
+
+    catch (const std::exception &exception)
+    {
+        return false;
+    }
+}
+
+
+/**
+ *  @brief Virtio-mem Device Parser
+ *
+ *  @param XML:    domain or device definition
+ *  @param device: structure reference to write to
+ *
+ *  @details Reads the first memory device of the virtio-mem model, such as
+ *
+ *      <memory model='virtio-mem'>
+ *        <target>
+ *          <size unit='KiB'>16777216</size>
+ *          <node>0</node>
+ *          <block unit='KiB'>2048</block>
+ *          <requested unit='KiB'>4194304</requested>
+ *          <current unit='KiB'>4194304</current>
+ *        </target>
+ *        <alias name='virtiomem0'/>
+ *      </memory>
+ *
+ *  Definitions without such a device are parsed successfully and leave the
+ *  device not found.
+ *
+ *  @return execution status code
+ */
+libvirt::status_code
+libvirt::hotplug::parse
+(
+    const std::string                 &xml,
+          libvirt::hotplug::device_t  &device
+) noexcept
+{
+    device = libvirt::hotplug::device_t();
+
+    std::size_t model = xml.find("model='virtio-mem'");
+    if (model == std::string::npos)
+        model = xml.find("model=\"virtio-mem\"");
+    if (model == std::string::npos)
+        return EXIT_SUCCESS;
+
+    const std::size_t begin = xml.rfind("<memory", model);
+    const std::size_t end   = xml.find("</memory>", model);
+    if (begin == std::string::npos || end == std::string::npos)
+    {
+        util::log::record
+        (
+            "Virtio-mem device definition is not closed",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+    const std::string memory = xml.substr(begin, end - begin);
+
+    // Size, block and requested size are required; others are live only
+    std::string text;
+    std::string unit;
+    const bool read
+        =  element(memory, "size", text, unit)
+        && memory_size(text, unit, device.size)
+        && element(memory, "block", text, unit)
+        && memory_size(text, unit, device.block)
+        && element(memory, "requested", text, unit)
+        && memory_size(text, unit, device.requested);
+    if (!read || device.block <= 0)
+    {
+        util::log::record
+        (
+            "Virtio-mem device has malformed size, block or requested size",
+            util::log::type::ERROR
+        );
+
+        device = libvirt::hotplug::device_t();
+        return EXIT_FAILURE;
+    }
+
+    device.current = device.requested;
+    if (element(memory, "current", text, unit))
+        static_cast<void>(memory_size(text, unit, device.current));
+
+    if (element(memory, "node", text, unit))
+    {
+        try
+        {
+            device.node = std::stoi(text);
+        }
+
+        catch (const std::exception &exception)
+        {
+            device.node = -1;
+        }
+    }
+
+    const std::size_t alias = memory.find("<alias name=");
+    if (alias != std::string::npos)
+    {
+        const char quote = memory[alias + 12];
+        const std::size_t close = memory.find(quote, alias + 13);
+        if (close != std::string::npos)
+            device.alias = memory.substr(alias + 13, close - alias - 13);
+    }
+
+    device.found = true;
+
+    return EXIT_SUCCESS;
+}
+
+
+/**
+ *  @brief Virtio-mem Device Discovery
+ *
+ *  @param datum:  domain to discover device of
+ *  @param device: structure reference to write to
+ *
+ *  @details Reads the domain's live definition
+ *
+ *  @return execution status code
+ */
+libvirt::status_code
+libvirt::hotplug::discover
+(
+    const libvirt::domain::datum_t   &datum,
+          libvirt::hotplug::device_t &device
+) noexcept
+{
+    char *xml = libvirt::virDomainGetXMLDesc(datum.domain.get(), 0);
+    if (xml == nullptr)
+    {
+        util::log::record
+        (
+            "Unable to get domain " + datum.uuid + "'s definition",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    std::string definition;
+    try
+    {
+        definition = std::string(xml);
+    }
+
+    catch (const std::exception &exception)
+    {
+        std::free(xml);
+
+        return EXIT_FAILURE;
+    }
+    std::free(xml);
+
+    return libvirt::hotplug::parse(definition, device);
+}
+
+
+/**
+ *  @brief Requested Size Aligner
+ *
+ *  @param device:    device to align for
+ *  @param requested: requested size in KiB
+ *
+ *  @details Rounds down to whole blocks within the device's size
+ *
+ *  @return aligned requested size
+ */
+util::stat::slong_t
+libvirt::hotplug::align
+(
+    const libvirt::hotplug::device_t &device,
+          util::stat::slong_t         requested
+) noexcept
+{
+    if (device.block <= 0)
+        return device.requested;
+
+    const util::stat::slong_t bounded
+        = std::clamp<util::stat::slong_t>(requested, 0, device.size);
+
+    return bounded - bounded % device.block;
+}
+
+
+/**
+ *  @brief Device Definition Builder
+ *
+ *  @param device:    device to define
+ *  @param requested: requested size in KiB
+ *
+ *  @return device definition to update domain with
+ */
+std::string
+libvirt::hotplug::definition
+(
+    const libvirt::hotplug::device_t &device,
+          util::stat::slong_t         requested
+) noexcept
+{
+    try
+    {
+        std::string xml = "<memory model='virtio-mem'>\n  <target>\n";
+        xml += "    <size unit='KiB'>" + std::to_string(device.size)
+             + "</size>\n";
+        if (device.node >= 0)
+            xml += "    <node>" + std::to_string(device.node) + "</node>\n";
+        xml += "    <block unit='KiB'>" + std::to_string(device.block)
+             + "</block>\n";
+        xml += "    <requested unit='KiB'>" + std::to_string(requested)
+             + "</requested>\n";
+        xml += "  </target>\n";
+        if (!device.alias.empty())
+            xml += "  <alias name='" + device.alias + "'/>\n";
+        xml += "</memory>\n";
+
+        return xml;
+    }
+
+    catch (const std::exception &exception)
+    {
+        return std::string();
+    }
+}
+
+
+/**
+ *  @brief Virtio-mem Device Resizer
+ *
+ *  @param domain:    domain to resize device of
+ *  @param device:    domain's device
+ *  @param requested: requested size in KiB; aligned to whole blocks
+ *
+ *  @details Updates the requested size of the live device; the guest plugs
+ *  or unplugs blocks until its current size reaches it. Takes the domain
+ *  handle rather than its datum, so a call running on a worker thread stays
+ *  valid after the datum is released.
+ *
+ *  @return execution status code
+ */
+libvirt::status_code
+libvirt::hotplug::resize
+(
+          libvirt::virDomainPtr       domain,
+    const libvirt::hotplug::device_t &device,
+          util::stat::slong_t         requested
+) noexcept
+{
+    if (domain == nullptr || !device.found)
+        return EXIT_FAILURE;
+
+    const std::string xml
+        = libvirt::hotplug::definition
+          (
+              device, libvirt::hotplug::align(device, requested)
+          );
+    if (xml.empty())
+        return EXIT_FAILURE;
+
+    if (libvirt::virDomainUpdateDeviceFlags
+        (
+            domain, xml.c_str(), device_modify_live_flag
+        ))
+    {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <lib/libvirt.hpp>
+#include <stat/statistics.hpp>
+
+#include "domain/domain.hpp"
+
+
+/**
+ *  @brief Memory Hotplug Header
+ *
+ *  @details Defines routines to discover and resize a domain's virtio-mem
+ *  device, which moves memory in whole blocks and is not bounded by the
+ *  balloon's maximum memory
+ */
+namespace libvirt
+{
+
+namespace hotplug
+{
+
+// Device update constants
+static constexpr util::stat::uint_t
+device_modify_live_flag
+    = static_cast<util::stat::uint_t>(VIR_DOMAIN_DEVICE_MODIFY_LIVE);
+
+// A domain's virtio-mem device; sizes in KiB, node of -1 is unset
+typedef struct device_t
+{
+    bool                found     = false;
+    std::string         alias;
+    util::stat::sint_t  node      = -1;
+    util::stat::slong_t size      = 0;
+    util::stat::slong_t block     = 0;
+    util::stat::slong_t requested = 0;
+    util::stat::slong_t current   = 0;
+} device_t;
+
+// Hotplug routines
+[[nodiscard("Device parse status must be checked")]]
+status_code
+parse
+(
+    const std::string &xml,
+          device_t    &device
+) noexcept;
+
+[[nodiscard("Device discovery status must be checked")]]
+status_code
+discover
+(
+    const domain::datum_t &datum,
+          device_t        &device
+) noexcept;
+
+[[nodiscard("Must use aligned requested size to call")]]
+util::stat::slong_t
+align
+(
+    const device_t            &device,
+          util::stat::slong_t  requested
+) noexcept;
+
+[[nodiscard("Must use device definition to call")]]
+std::string
+definition
+(
+    const device_t            &device,
+          util::stat::slong_t  requested
+) noexcept;
+
+[[nodiscard("Device resize status must be checked")]]
+status_code
+resize
+(
+          virDomainPtr         domain,
+    const device_t            &device,
+          util::stat::slong_t  requested
+) noexcept;
+
+} // hotplug namespace
+
+} // libvirt namespace
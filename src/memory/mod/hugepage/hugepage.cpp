@@ -0,0 +1,234 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+#include <log/record.hpp>
+#include <stat/statistics.hpp>
+
+#include "hugepage.hpp"
+
+
+/**
+ *  @brief Counter Reader
+ *
+ *  @param path:  counter file path
+ *  @param value: variable reference to write to
+ *
+ *  @return whether counter was read
+ */
+bool
+static read_counter
+(
+    const std::string         &path,
+          util::stat::ulong_t &value
+) noexcept
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+        return false;
+
+    std::string field;
+    if (!(file >> field))
+        return false;
+
+    try
+    {
+        value = std::stoull(field);
+        return true;
+    }
+
+    catch (const std::exception &exception)
+    {
+        return false;
+    }
+}
+
+
+/**
+ *  @brief Numbered Name Reader
+ *
+ *  @param name:   directory name such as node0 or hugepages-2048kB
+ *  @param prefix: text preceding the number
+ *  @param suffix: text following the number
+ *  @param number: variable reference to write to
+ *
+ *  @return whether name matched and its number was read
+ */
+bool
+static numbered_name
+(
+    const std::string         &name,
+    const std::string         &prefix,
+    const std::string         &suffix,
+          util::stat::slong_t &number
+) noexcept
+{
+    if (name.size() <= prefix.size() + suffix.size()
+        || name.compare(0, prefix.size(), prefix) != 0
+        || name.compare(name.size() - suffix.size(), suffix.size(), suffix))
+        return false;
+
+    const std::string digits = name.substr
+    (
+        prefix.size(), name.size() - prefix.size() - suffix.size()
+    );
+    if (!std::all_of
+        (
+            digits.begin(), digits.end(),
+            [](unsigned char digit) { return std::isdigit(digit) != 0; }
+        ))
+        return false;
+
+    try
+    {
+        number = std::stoll(digits);
+        return true;
+    }
+
+    catch (const std::exception &exception)
+    {
+        return false;
+    }
+}
+
+
+/**
+ *  @brief Hugepage Pools Reader
+ *
+ *  @param root:  NUMA node sysfs directory, usually /sys/devices/system/node
+ *  @param pools: structure reference to write to
+ *
+ *  @details Reads every node's pool of every supported hugepage size, from
+ *  node<N>/hugepages/hugepages-<size>kB/{nr,free}_hugepages, ordered by node
+ *  and then page size
+ *
+ *  @return execution status code
+ */
+os::hugepage::status_code
+os::hugepage::read
+(
+    const std::string           &root,
+          os::hugepage::pools_t &pools
+) noexcept
+{
+    pools.clear();
+
+    try
+    {
+        std::error_code error;
+        for (const std::filesystem::directory_entry &node_entry:
+             std::filesystem::directory_iterator(root, error))
+        {
+            util::stat::slong_t node;
+            if (!numbered_name
+                (
+                    node_entry.path().filename().string(), "node", "", node
+                ))
+                continue;
+
+            std::error_code node_error;
+            for (const std::filesystem::directory_entry &size_entry:
+                 std::filesystem::directory_iterator
+                 (
+                     node_entry.path() / "hugepages", node_error
+                 ))
+            {
+                os::hugepage::pool_t pool;
+                pool.node = static_cast<util::stat::sint_t>(node);
+                const std::string directory = size_entry.path().string();
+                const bool read
+                    =  numbered_name
+                       (
+                           size_entry.path().filename().string(),
+                           "hugepages-", "kB", pool.page_size
+                       )
+                    && read_counter(directory + "/nr_hugepages", pool.total)
+                    && read_counter(directory + "/free_hugepages", pool.free);
+                if (read)
+                    pools.push_back(pool);
+            }
+        }
+        if (error)
+        {
+            util::log::record
+            (
+                "Unable to list NUMA nodes under " + root,
+                util::log::type::ERROR
+            );
+
+            return EXIT_FAILURE;
+        }
+
+        std::sort
+        (
+            pools.begin(), pools.end(),
+            [](const os::hugepage::pool_t &pool_A,
+               const os::hugepage::pool_t &pool_B)
+            {
+                if (pool_A.node != pool_B.node)
+                    return pool_A.node < pool_B.node;
+
+                return pool_A.page_size < pool_B.page_size;
+            }
+        );
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Unable to read hugepage pools under " + root,
+            util::log::type::ERROR
+        );
+
+        pools.clear();
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/**
+ *  @brief Hugepage Pool Resizer
+ *
+ *  @param root:  NUMA node sysfs directory, usually /sys/devices/system/node
+ *  @param pool:  pool to resize
+ *  @param pages: hugepages pool should hold
+ *
+ *  @details The kernel may allocate fewer pages than asked for when node
+ *  memory is fragmented, and frees only pages not in use
+ *
+ *  @return execution status code
+ */
+os::hugepage::status_code
+os::hugepage::resize
+(
+    const std::string          &root,
+    const os::hugepage::pool_t &pool,
+          util::stat::ulong_t   pages
+) noexcept
+{
+    const std::string path = root + "/node" + std::to_string(pool.node)
+        + "/hugepages/hugepages-" + std::to_string(pool.page_size)
+        + "kB/nr_hugepages";
+
+    std::ofstream file(path);
+    if (!file.is_open() || !(file << pages << std::endl))
+    {
+        util::log::record
+        (
+            "Unable to resize hugepage pool " + path,
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
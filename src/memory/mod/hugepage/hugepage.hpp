@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <stat/statistics.hpp>
+
+
+/**
+ *  @brief Hugepage Pool Header
+ *
+ *  @details Defines routines to read and size the host's per node hugepage
+ *  pools through their sysfs interface
+ */
+namespace os
+{
+
+namespace hugepage
+{
+
+using status_code = std::uint8_t;
+
+// Hugepage pool of a single size on a single node; page size in KiB and
+// counts in pages
+typedef struct pool_t
+{
+    util::stat::sint_t  node      = 0;
+    util::stat::slong_t page_size = 0;
+    util::stat::ulong_t total     = 0;
+    util::stat::ulong_t free      = 0;
+} pool_t;
+
+using pools_t = std::vector<pool_t>;
+
+// Hugepage pool routines
+[[nodiscard("Hugepage pool read status must be checked")]]
+status_code
+read
+(
+    const std::string &root,
+          pools_t     &pools
+) noexcept;
+
+[[nodiscard("Hugepage pool write status must be checked")]]
+status_code
+resize
+(
+    const std::string         &root,
+    const pool_t              &pool,
+          util::stat::ulong_t  pages
+) noexcept;
+
+} // hugepage namespace
+
+} // os namespace
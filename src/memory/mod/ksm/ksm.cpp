@@ -0,0 +1,139 @@
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <string>
+
+#include <unistd.h>
+
+#include <log/record.hpp>
+#include <stat/statistics.hpp>
+
+#include "ksm.hpp"
+
+
+/**
+ *  @brief Counter Reader
+ *
+ *  @param path:  counter file path
+ *  @param value: variable reference to write to
+ *
+ *  @return whether counter was read
+ */
+bool
+static read_counter
+(
+    const std::string         &path,
+          util::stat::ulong_t &value
+) noexcept
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+        return false;
+
+    std::string field;
+    if (!(file >> field))
+        return false;
+
+    try
+    {
+        value = std::stoull(field);
+        return true;
+    }
+
+    catch (const std::exception &exception)
+    {
+        return false;
+    }
+}
+
+
+/**
+ *  @brief KSM Counters Reader
+ *
+ *  @param root:  KSM sysfs directory, usually /sys/kernel/mm/ksm
+ *  @param datum: structure reference to write to
+ *
+ *  @return execution status code
+ */
+os::ksm::status_code
+os::ksm::read
+(
+    const std::string      &root,
+          os::ksm::datum_t &datum
+) noexcept
+{
+    const bool read 
+        =  read_counter(root + "/pages_shared",  datum.pages_shared)
+        && read_counter(root + "/pages_sharing", datum.pages_sharing)
+        && read_counter(root + "/full_scans",    datum.full_scans)
+        && read_counter(root + "/pages_to_scan", datum.pages_to_scan)
+        && read_counter(root + "/run",           datum.run);
+    if (!read)
+    {
+        util::log::record
+        (
+            "Unable to read KSM counters under " + root,
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/**
+ *  @brief KSM Scan Rate Writer
+ *
+ *  @param root:  KSM sysfs directory, usually /sys/kernel/mm/ksm
+ *  @param pages: pages to scan each time the KSM daemon wakes
+ *
+ *  @return execution status code
+ */
+os::ksm::status_code
+os::ksm::pages_to_scan
+(
+    const std::string         &root,
+          util::stat::ulong_t  pages
+) noexcept
+{
+    std::ofstream file(root + "/pages_to_scan");
+    if (!file.is_open() || !(file << pages << std::endl))
+    {
+        util::log::record
+        (
+            "Unable to set KSM pages to scan under " + root,
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/**
+ *  @brief KSM Savings
+ *
+ *  @param datum: KSM counters
+ *
+ *  @details Every sharing page beyond the one shared copy is host memory
+ *  guests see as used but the host does not back separately
+ *
+ *  @return memory saved in KiB
+ */
+util::stat::slong_t
+os::ksm::savings
+(
+    const os::ksm::datum_t &datum
+) noexcept
+{
+    const long page_size = ::sysconf(_SC_PAGESIZE);
+    if (page_size <= 0)
+        return 0;
+
+    return static_cast<util::stat::slong_t>(datum.pages_sharing)
+         * (page_size >> 10);
+}
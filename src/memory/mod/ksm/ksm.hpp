@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <stat/statistics.hpp>
+
+
+/**
+ *  @brief Kernel Samepage Merging Header
+ *
+ *  @details Defines routines to read and steer the host's KSM daemon through
+ *  its sysfs interface
+ */
+namespace os
+{
+
+namespace ksm
+{
+
+using status_code = std::uint8_t;
+
+// KSM counters; pages in host pages
+typedef struct datum_t
+{
+    util::stat::ulong_t pages_shared  = 0;
+    util::stat::ulong_t pages_sharing = 0;
+    util::stat::ulong_t full_scans    = 0;
+    util::stat::ulong_t pages_to_scan = 0;
+    util::stat::ulong_t run           = 0;
+} datum_t;
+
+// KSM routines
+[[nodiscard("KSM read status must be checked")]]
+status_code
+read
+(
+    const std::string &root,
+          datum_t     &datum
+) noexcept;
+
+[[nodiscard("KSM write status must be checked")]]
+status_code
+pages_to_scan
+(
+    const std::string         &root,
+          util::stat::ulong_t  pages
+) noexcept;
+
+[[nodiscard("Must use memory saved to call")]]
+util::stat::slong_t
+savings
+(
+    const datum_t &datum
+) noexcept;
+
+} // ksm namespace
+
+} // os namespace
@@ -0,0 +1,303 @@
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <linux/magic.h>
+#include <poll.h>
+#include <sys/vfs.h>
+#include <unistd.h>
+
+#include <log/record.hpp>
+#include <stat/statistics.hpp>
+
+#include "psi.hpp"
+
+
+/**
+ *  @brief Pressure Event Raiser
+ *
+ *  @param watcher: watcher to raise event on
+ *
+ *  @details Marks host memory pressure and wakes the waiting manager
+ */
+void
+static raise
+(
+    os::psi::watcher_t &watcher
+) noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(watcher.mutex);
+        watcher.triggered = true;
+    }
+    watcher.condition.notify_all();
+}
+
+
+/**
+ *  @brief Stall Average Reader
+ *
+ *  @param path:    pressure file path
+ *  @param average: variable reference to write to
+ *
+ *  @details Reads the ten second average of the "some" line, which is the
+ *  percentage of time at least one task stalled on memory
+ *
+ *  @return whether the average was read
+ */
+bool
+static read_average
+(
+    const std::string   &path,
+          std::double_t &average
+) noexcept
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+        return false;
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream stream(line);
+        std::string kind, field;
+        stream >> kind >> field;
+        if (kind != "some" || field.rfind("avg10=", 0) != 0)
+            continue;
+
+        try
+        {
+            average = std::stod(field.substr(6));
+            return true;
+        }
+
+        catch (const std::exception &exception)
+        {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+
+/**
+ *  @brief Pressure Monitor
+ *
+ *  @param watcher:    watcher to raise events on
+ *  @param parameters: watcher tunables
+ *
+ *  @details Registers a kernel PSI trigger on the pressure file and polls for
+ *  its events. Files not accepting triggers, such as those of older kernels
+ *  or files outside procfs standing in for testing, are instead read every
+ *  poll period and an event is raised while the stall average is above
+ *  threshold.
+ */
+void
+static monitor
+(
+    os::psi::watcher_t   &watcher,
+    os::psi::parameters_t parameters
+) noexcept
+{
+    const int poll_period = static_cast<int>(parameters.poll_period.count());
+
+    // Only procfs pressure files accept triggers
+    struct statfs filesystem;
+    const bool procfs = ::statfs(parameters.path.c_str(), &filesystem) == 0
+                     && filesystem.f_type == PROC_SUPER_MAGIC;
+
+    // Register trigger on stall time within window
+    int descriptor = procfs
+        ? ::open(parameters.path.c_str(), O_RDWR | O_NONBLOCK)
+        : -1;
+    if (descriptor >= 0)
+    {
+        const std::string trigger
+            = "some " + std::to_string(parameters.stall_threshold)
+            + " "     + std::to_string(parameters.window);
+
+        if (::write(descriptor, trigger.c_str(), trigger.size() + 1) < 0)
+        {
+            ::close(descriptor);
+            descriptor = -1;
+        }
+    }
+
+    // Wait on trigger events
+    if (descriptor >= 0)
+    {
+        util::log::record
+        (
+            "Watching host memory pressure through PSI trigger on "
+                + parameters.path
+        );
+
+        struct pollfd request = {descriptor, POLLPRI, 0};
+        while (watcher.running)
+        {
+            const int ready = ::poll(&request, 1, poll_period);
+            if (ready < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+
+                util::log::record
+                (
+                    "Unable to poll PSI trigger on " + parameters.path,
+                    util::log::type::ERROR
+                );
+
+                break;
+            }
+            if (ready == 0)
+                continue;
+
+            if (request.revents & POLLERR)
+            {
+                util::log::record
+                (
+                    "PSI trigger on " + parameters.path + " was invalidated",
+                    util::log::type::ERROR
+                );
+
+                break;
+            }
+            if (request.revents & POLLPRI)
+                raise(watcher);
+        }
+
+        ::close(descriptor);
+        return;
+    }
+
+    // Fall back to reading stall average
+    util::log::record
+    (
+        "PSI triggers unavailable on " + parameters.path
+            + "; polling stall average instead",
+        util::log::type::FLAG
+    );
+
+    while (watcher.running)
+    {
+        std::double_t average;
+        if (read_average(parameters.path, average)
+            && average >= parameters.average_threshold)
+            raise(watcher);
+
+        std::this_thread::sleep_for(parameters.poll_period);
+    }
+}
+
+
+/**
+ *  @brief Pressure Watcher Starter
+ *
+ *  @param watcher:    watcher to start
+ *  @param parameters: watcher tunables
+ *
+ *  @details Launches the monitor thread if watching is enabled
+ *
+ *  @return execution status code
+ */
+os::psi::status_code
+os::psi::watch
+(
+          os::psi::watcher_t    &watcher,
+    const os::psi::parameters_t &parameters
+) noexcept
+{
+    if (!parameters.enabled)
+        return EXIT_SUCCESS;
+
+    if (watcher.running)
+    {
+        util::log::record
+        (
+            "Pressure watcher is already running",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        watcher.running = true;
+        watcher.thread = std::thread(monitor, std::ref(watcher), parameters);
+    }
+
+    catch (const std::exception &exception)
+    {
+        watcher.running = false;
+
+        util::log::record
+        (
+            "Unable to launch pressure watcher thread",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/**
+ *  @brief Pressure Waiter
+ *
+ *  @param watcher:  watcher to wait on
+ *  @param deadline: time to stop waiting
+ *
+ *  @details Sleeps until the deadline unless host memory pressure is raised
+ *  first, in which case the event is consumed
+ *
+ *  @return whether pressure was raised before deadline
+ */
+bool
+os::psi::wait_until
+(
+          os::psi::watcher_t                    &watcher,
+    const std::chrono::steady_clock::time_point &deadline
+) noexcept
+{
+    std::unique_lock<std::mutex> lock(watcher.mutex);
+    const bool triggered = watcher.condition.wait_until
+    (
+        lock, deadline,
+        [&watcher]()
+        {
+            return watcher.triggered;
+        }
+    );
+    watcher.triggered = false;
+
+    return triggered;
+}
+
+
+/**
+ *  @brief Pressure Watcher Stopper
+ *
+ *  @param watcher: watcher to stop
+ *
+ *  @details Signals monitor thread to exit and waits for it
+ */
+void
+os::psi::stop
+(
+    os::psi::watcher_t &watcher
+) noexcept
+{
+    watcher.running = false;
+    if (watcher.thread.joinable())
+        watcher.thread.join();
+}
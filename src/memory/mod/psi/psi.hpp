@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <stat/statistics.hpp>
+
+
+/**
+ *  @brief Pressure Stall Information Header
+ *
+ *  @details Defines the watcher waking the memory manager between intervals
+ *  when the host itself is under memory pressure
+ */
+namespace os
+{
+
+namespace psi
+{
+
+using status_code = std::uint8_t;
+
+// Tunables; stall threshold and window in microseconds as the kernel expects,
+// average threshold in percent of time stalled
+typedef struct parameters_t
+{
+    bool                      enabled           = false;
+    std::string               path              = "/proc/pressure/memory";
+    util::stat::uint_t        stall_threshold   = 150000;
+    util::stat::uint_t        window            = 1000000;
+    std::double_t             average_threshold = 10.0;
+    std::chrono::milliseconds poll_period       = std::chrono::milliseconds(500);
+    std::chrono::milliseconds cooldown          = std::chrono::milliseconds(1000);
+} parameters_t;
+
+// Watcher thread and the event it raises
+typedef struct watcher_t
+{
+    std::thread             thread;
+    std::mutex              mutex;
+    std::condition_variable condition;
+    bool                    triggered = false;
+    std::atomic<bool>       running   = false;
+} watcher_t;
+
+// Watcher routines
+[[nodiscard("Watcher start status must be checked")]]
+status_code
+watch
+(
+          watcher_t    &watcher,
+    const parameters_t &parameters
+) noexcept;
+
+[[nodiscard("Must use whether pressure was raised to call")]]
+bool
+wait_until
+(
+          watcher_t                             &watcher,
+    const std::chrono::steady_clock::time_point &deadline
+) noexcept;
+
+void
+stop
+(
+    watcher_t &watcher
+) noexcept;
+
+} // psi namespace
+
+} // os namespace
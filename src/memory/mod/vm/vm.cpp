@@ -0,0 +1,126 @@
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+#include <log/record.hpp>
+#include <stat/statistics.hpp>
+
+#include "vm.hpp"
+
+
+/**
+ *  @brief Key Value File Reader
+ *
+ *  @param path:   file of "key value" or "key: value unit" lines
+ *  @param fields: keys to read and variable references to write to
+ *
+ *  @details Keys absent from the file, as zswap fields on kernels without
+ *  zswap, are left untouched
+ *
+ *  @return whether file was read
+ */
+bool
+static read_fields
+(
+    const std::string                                            &path,
+    const std::unordered_map<std::string, util::stat::slong_t *> &fields
+) noexcept
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+        return false;
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream stream(line);
+        std::string key, field;
+        if (!(stream >> key >> field))
+            continue;
+
+        if (!key.empty() && key.back() == ':')
+            key.pop_back();
+
+        const auto entry = fields.find(key);
+        if (entry == fields.end())
+            continue;
+
+        try
+        {
+            *entry->second = std::stoll(field);
+        }
+
+        catch (const std::exception &exception)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+/**
+ *  @brief Host Virtual Memory Reader
+ *
+ *  @param meminfo path: memory usage file, usually /proc/meminfo
+ *  @param vmstat path:  paging counters file, usually /proc/vmstat
+ *  @param datum:        structure reference to write to
+ *
+ *  @return execution status code
+ */
+os::vm::status_code
+os::vm::read
+(
+    const std::string     &meminfo_path,
+    const std::string     &vmstat_path,
+          os::vm::datum_t &datum
+) noexcept
+{
+    const bool read_meminfo = read_fields
+    (
+        meminfo_path,
+        {
+            {"SwapTotal",  &datum.swap_total},
+            {"SwapFree",   &datum.swap_free},
+            {"SwapCached", &datum.swap_cached},
+            {"Zswap",      &datum.zswap},
+            {"Zswapped",   &datum.zswapped}
+        }
+    );
+    if (!read_meminfo)
+    {
+        util::log::record
+        (
+            "Unable to read host memory usage from " + meminfo_path,
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    const bool read_vmstat = read_fields
+    (
+        vmstat_path,
+        {
+            {"pswpin",     &datum.swap_in},
+            {"pswpout",    &datum.swap_out},
+            {"pgmajfault", &datum.major_faults}
+        }
+    );
+    if (!read_vmstat)
+    {
+        util::log::record
+        (
+            "Unable to read host paging counters from " + vmstat_path,
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <stat/statistics.hpp>
+
+
+/**
+ *  @brief Host Virtual Memory Header
+ *
+ *  @details Defines routines to read the host's swap and zswap usage and its
+ *  paging activity from procfs
+ */
+namespace os
+{
+
+namespace vm
+{
+
+using status_code = std::uint8_t;
+
+// Host swap usage in KiB and paging counters in pages or events
+typedef struct datum_t
+{
+    util::stat::slong_t swap_total   = 0;
+    util::stat::slong_t swap_free    = 0;
+    util::stat::slong_t swap_cached  = 0;
+    util::stat::slong_t zswap        = 0;
+    util::stat::slong_t zswapped     = 0;
+    util::stat::slong_t swap_in      = 0;
+    util::stat::slong_t swap_out     = 0;
+    util::stat::slong_t major_faults = 0;
+} datum_t;
+
+// Virtual memory routines
+[[nodiscard("Virtual memory read status must be checked")]]
+status_code
+read
+(
+    const std::string &meminfo_path,
+    const std::string &vmstat_path,
+          datum_t     &datum
+) noexcept;
+
+} // vm namespace
+
+} // os namespace
@@ -0,0 +1,267 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <log/record.hpp>
+#include <stat/statistics.hpp>
+
+#include "domain/domain.hpp"
+#include "hardware/hardware.hpp"
+#include "sys/actuator.hpp"
+#include "sys/policy.hpp"
+#include "sys/scheduler.hpp"
+
+#include "model.hpp"
+#include "trace.hpp"
+
+
+// Guest page size in KiB
+static constexpr util::stat::slong_t PAGE_SIZE = 4;
+
+// Simulated guest state between intervals; memory in KiB
+typedef struct guest_t
+{
+    util::stat::slong_t balloon_memory = 0;
+    util::stat::slong_t working_set    = 0;
+    util::stat::slong_t target         = 0;
+    std::size_t         target_due     = 0;
+    bool                target_pending = false;
+    util::stat::slong_t major_faults   = 0;
+    util::stat::slong_t swap_in        = 0;
+    util::stat::slong_t swap_out       = 0;
+    util::stat::slong_t shortfall      = 0;
+    std::size_t         operations     = 0;
+    std::size_t         disturbed_at   = 0;
+    std::size_t         quiet_since    = 0;
+    std::size_t         quiet_for      = 0;
+    bool                converged      = true;
+} guest_t;
+
+
+/**
+ *  @brief Guest Memory Simulation
+ *
+ *  @param trace:      guests and their working sets
+ *  @param parameters: model tunables
+ *  @param policy:     scheduler tunables under test
+ *  @param report:     structure reference to write to
+ *
+ *  @details Each interval applies the trace's working sets, settles balloon
+ *  targets that are due, and charges every guest short of its working set
+ *  with swap traffic on the part it touches. The guests' statistics are then
+ *  handed to the scheduler, whose balloon targets are caught through the
+ *  actuator hook and come due after the response delay. Time is simulated,
+ *  so runs are deterministic.
+ *
+ *  A disturbance is a large change of a guest's working set; the guest
+ *  converges once, for the settling intervals, it is issued no balloon 
+ *  operation and is not short of its working set, and convergence time is
+ *  measured from its latest disturbance. Host swap is the guests' total 
+ *  balloon memory beyond host memory.
+ *
+ *  @return execution status code
+ */
+simulator::model::status_code
+simulator::model::run
+(
+    const simulator::trace::trace_t      &trace,
+    const simulator::model::parameters_t &parameters,
+    const manager::policy_t              &policy,
+          simulator::model::report_t     &report
+) noexcept
+{
+    report = simulator::model::report_t();
+
+    std::vector<guest_t> guests(trace.guests.size());
+    std::unordered_map<libvirt::domain::uuid_t, std::size_t> indices;
+    util::stat::slong_t total_limit = 0;
+    for (std::size_t index = 0; index < guests.size(); ++index)
+    {
+        guests[index].balloon_memory = trace.guests[index].initial_memory;
+        indices[trace.guests[index].name] = index;
+        total_limit += trace.guests[index].memory_limit;
+    }
+
+    // Simulated time drives the scheduler's rates
+    std::size_t tick = 0;
+    const std::chrono::steady_clock::time_point epoch;
+    manager::state_t state;
+    state.clock = [&tick, &parameters, &epoch]()
+    {
+        return epoch + parameters.interval * static_cast<std::int64_t>(tick);
+    };
+
+    // Balloon targets come due after the response delay
+    std::mutex mutex;
+    const std::size_t response_delay 
+        = std::max<std::size_t>(parameters.response_delay, 1);
+    manager::actuator::hook
+    (
+        [&](const libvirt::domain::uuid_t &uuid, util::stat::slong_t target)
+            -> manager::actuator::status_code
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            guest_t &guest = guests[indices.at(uuid)];
+            guest.target         = target;
+            guest.target_due     = tick + response_delay;
+            guest.target_pending = true;
+            ++guest.operations;
+            ++report.balloon_operations;
+
+            return EXIT_SUCCESS;
+        }
+    );
+
+    std::size_t point = 0;
+    std::double_t total_convergence = 0.0;
+    const std::double_t interval_seconds 
+        = std::chrono::duration<std::double_t>(parameters.interval).count();
+
+    manager::status_code status = EXIT_SUCCESS;
+    for (tick = 0; tick < trace.length; ++tick)
+    {
+        // Working sets of this interval; large changes disturb the guest
+        for (; point < trace.points.size(); ++point)
+        {
+            const simulator::trace::point_t &change = trace.points[point];
+            if (change.tick > tick)
+                break;
+
+            guest_t &guest = guests[change.guest];
+            const util::stat::slong_t memory_limit 
+                = trace.guests[change.guest].memory_limit;
+            if (std::abs(change.working_set - guest.working_set)
+                >= parameters.disturbance * memory_limit)
+            {
+                ++report.disturbances;
+                guest.disturbed_at = tick;
+                guest.quiet_for    = 0;
+                guest.converged    = false;
+            }
+            guest.working_set = change.working_set;
+        }
+
+        // Settle due targets and swap what guests are short of
+        util::stat::slong_t guest_swap = 0, balloon_memory = 0;
+        libvirt::domain::data_t domain_data;
+        domain_data.reserve(guests.size());
+        for (std::size_t index = 0; index < guests.size(); ++index)
+        {
+            guest_t &guest = guests[index];
+            const util::stat::slong_t memory_limit 
+                = trace.guests[index].memory_limit;
+            if (guest.target_pending && guest.target_due <= tick)
+            {
+                guest.balloon_memory = std::clamp<util::stat::slong_t>
+                (
+                    guest.target, 0, memory_limit
+                );
+                guest.target_pending = false;
+            }
+
+            guest.shortfall = std::max<util::stat::slong_t>
+            (
+                guest.working_set - guest.balloon_memory, 0
+            );
+            const util::stat::slong_t touched = static_cast<util::stat::slong_t>
+            (
+                parameters.touch_fraction * guest.shortfall
+            );
+            guest.swap_in      += touched;
+            guest.swap_out     += touched;
+            guest.major_faults += touched / PAGE_SIZE;
+
+            guest_swap     += guest.shortfall;
+            balloon_memory += guest.balloon_memory;
+
+            libvirt::domain::datum_t datum;
+            datum.uuid                = trace.guests[index].name;
+            datum.number_of_vCPUs     = 1;
+            datum.balloon_memory_used = guest.balloon_memory;
+            datum.domain_memory_extra = std::max<util::stat::slong_t>
+            (
+                guest.balloon_memory - guest.working_set, 0
+            );
+            datum.domain_memory_limit = memory_limit;
+            datum.major_faults        = guest.major_faults;
+            datum.swap_in             = guest.swap_in;
+            datum.swap_out            = guest.swap_out;
+            datum.memory_usable       = datum.domain_memory_extra;
+            datum.disk_caches         = 0;
+            datum.resident_memory 
+                = std::min(guest.working_set, guest.balloon_memory);
+            domain_data.push_back(std::move(datum));
+        }
+        report.peak_guest_swap = std::max(report.peak_guest_swap, guest_swap);
+        report.peak_host_swap  = std::max
+        (
+            report.peak_host_swap, 
+            std::max<util::stat::slong_t>(balloon_memory - trace.host_memory, 0)
+        );
+
+        // Run scheduler as memoryman does
+        libvirt::hardware::datum_t hardware_datum;
+        hardware_datum.memory_limit = trace.host_memory;
+
+        std::vector<std::size_t> operations(guests.size());
+        for (std::size_t index = 0; index < guests.size(); ++index)
+            operations[index] = guests[index].operations;
+
+        status = manager::scheduler(domain_data, hardware_datum, policy, state);
+        if (static_cast<bool>(status))
+        {
+            util::log::record
+            (
+                "Scheduler failed at interval " + std::to_string(tick),
+                util::log::type::ERROR
+            );
+
+            break;
+        }
+
+        // Guests converge once quiet for the settling intervals
+        for (std::size_t index = 0; index < guests.size(); ++index)
+        {
+            guest_t &guest = guests[index];
+            if (guest.operations != operations[index] || guest.shortfall > 0)
+            {
+                guest.quiet_for = 0;
+                continue;
+            }
+
+            if (guest.quiet_for++ == 0)
+                guest.quiet_since = tick;
+            if (guest.converged || guest.quiet_for < parameters.settle_intervals)
+                continue;
+
+            const std::double_t convergence 
+                = (guest.quiet_since - guest.disturbed_at) * interval_seconds;
+
+            guest.converged = true;
+            ++report.convergences;
+            total_convergence += convergence;
+            report.maximum_convergence 
+                = std::max(report.maximum_convergence, convergence);
+        }
+    }
+    manager::actuator::hook(nullptr);
+
+    report.intervals = tick;
+    if (report.convergences > 0)
+        report.mean_convergence = total_convergence / report.convergences;
+    report.overcommit_ratio 
+        = static_cast<std::double_t>(total_limit) / trace.host_memory;
+    if (report.intervals > 0)
+    {
+        report.operations_per_hour = report.balloon_operations 
+            * 3600.0 / (report.intervals * interval_seconds);
+    }
+
+    return status;
+}
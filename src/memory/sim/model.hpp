@@ -0,0 +1,71 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include <stat/statistics.hpp>
+
+#include "sys/policy.hpp"
+
+#include "trace.hpp"
+
+
+/**
+ *  @brief Guest Memory Model Header
+ *
+ *  @details Defines the simulated host whose guests follow a working set
+ *  trace, answer balloon targets after a delay, and swap whatever of their
+ *  working set their balloon leaves them short of, driven by the scheduler
+ *  exactly as memoryman drives it
+ */
+namespace simulator
+{
+
+namespace model
+{
+
+using status_code = std::uint8_t;
+
+// Tunables; response delay and settling in balancer intervals, touch is the
+// fraction of swapped memory guests touch each interval, and a disturbance 
+// is a working set change of at least the given fraction of a guest's limit
+typedef struct parameters_t
+{
+    std::chrono::milliseconds interval         = std::chrono::milliseconds(5000);
+    std::size_t               response_delay   = 1;
+    std::double_t             touch_fraction   = 0.100;
+    std::size_t               settle_intervals = 3;
+    std::double_t             disturbance      = 0.050;
+} parameters_t;
+
+// Outcome of a simulation; memory in KiB, times in seconds
+typedef struct report_t
+{
+    std::size_t         intervals           = 0;
+    std::size_t         disturbances        = 0;
+    std::size_t         convergences        = 0;
+    std::double_t       mean_convergence    = 0.0;
+    std::double_t       maximum_convergence = 0.0;
+    util::stat::slong_t peak_guest_swap     = 0;
+    util::stat::slong_t peak_host_swap      = 0;
+    std::double_t       overcommit_ratio    = 0.0;
+    std::size_t         balloon_operations  = 0;
+    std::double_t       operations_per_hour = 0.0;
+} report_t;
+
+// Simulation routines
+[[nodiscard("Simulation status must be checked")]]
+status_code
+run
+(
+    const trace::trace_t    &trace,
+    const parameters_t      &parameters,
+    const manager::policy_t &policy,
+          report_t          &report
+) noexcept;
+
+} // model namespace
+
+} // simulator namespace
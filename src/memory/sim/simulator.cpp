@@ -0,0 +1,220 @@
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+#include <conf/config.hpp>
+#include <log/record.hpp>
+
+#include "sys/policy.hpp"
+
+#include "model.hpp"
+#include "trace.hpp"
+
+
+/**
+ *  @brief Memory Manager Simulator
+ *
+ *  @details Replays a recorded working set trace, or a synthetic one, on a 
+ *  simulated host through memoryman's scheduler, such that scheduling
+ *  policies can be compared offline before rollout. The configuration file
+ *  holds the scheduler tunables under test, as read by memoryman, along with
+ *  the simulation's own sim.* tunables.
+ *
+ *  Reports time for the host to converge after working set changes, peak
+ *  guest and host swap, the overcommit ratio, and balloon operations per 
+ *  hour.
+ */
+int
+main(int argc, char *argv[])
+{
+    /**************************** VALIDATE COMMAND ****************************/
+
+    if (argc != 2 && argc != 3)
+    {
+        util::log::record
+        (
+            "Usage follows as ./memoryman-sim <trace | synthetic> "
+            "[configuration]",
+            util::log::type::ABORT
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    util::conf::table_t configuration;
+    if (argc == 3)
+    {
+        util::conf::status_code status = util::conf::load
+        (
+            std::string(argv[2]), 
+            configuration
+        );
+        if (static_cast<bool>(status))
+        {
+            util::log::record
+            (
+                "Unable to read configuration file", 
+                util::log::type::ABORT
+            );
+
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Scheduler tunables under test
+    manager::policy_t policy;
+    manager::status_code status = manager::configure(configuration, policy);
+    if (static_cast<bool>(status))
+    {
+        util::log::record
+        (
+            "Invalid scheduler configuration", 
+            util::log::type::ABORT
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Simulated guests have neither domain metadata, host counters nor
+    // cgroups, and host hugepage pools and memory are never resized or
+    // compacted from simulated demand
+    policy.reservation.metadata_uri.clear();
+    policy.deduplication.enabled = false;
+    policy.swap.enabled          = false;
+    policy.hugepage.enabled      = false;
+    policy.compaction.enabled    = false;
+    policy.backstop.enabled      = false;
+
+
+    /************************** READ SIMULATION TUNABLES **********************/
+
+    using util::conf::value;
+
+    simulator::model::parameters_t parameters;
+    parameters.interval = std::chrono::milliseconds
+    (
+        value
+        (
+            configuration, "sim.interval",
+            parameters.interval.count()
+        )
+    );
+    parameters.response_delay = value
+    (
+        configuration, "sim.response_delay",
+        parameters.response_delay
+    );
+    parameters.touch_fraction = value
+    (
+        configuration, "sim.touch_fraction",
+        parameters.touch_fraction
+    );
+    parameters.settle_intervals = value
+    (
+        configuration, "sim.settle_intervals",
+        parameters.settle_intervals
+    );
+    parameters.disturbance = value
+    (
+        configuration, "sim.disturbance",
+        parameters.disturbance
+    );
+    if (parameters.interval.count() <= 0 || parameters.settle_intervals == 0)
+    {
+        util::log::record
+        (
+            "Simulation interval and settling intervals must be positive",
+            util::log::type::ABORT
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    simulator::trace::parameters_t synthetic;
+    synthetic.number_of_guests = value
+    (
+        configuration, "sim.guests",
+        synthetic.number_of_guests
+    );
+    synthetic.length = value
+    (
+        configuration, "sim.length",
+        synthetic.length
+    );
+    synthetic.seed = value
+    (
+        configuration, "sim.seed",
+        synthetic.seed
+    );
+    synthetic.overcommit = value
+    (
+        configuration, "sim.overcommit",
+        synthetic.overcommit
+    );
+
+
+    /******************************* LOAD TRACE *******************************/
+
+    simulator::trace::trace_t trace;
+    const std::string source(argv[1]);
+    simulator::trace::status_code trace_status = source == "synthetic"
+        ? simulator::trace::synthesize(synthetic, trace)
+        : simulator::trace::load(source, trace);
+    if (static_cast<bool>(trace_status))
+    {
+        util::log::record
+        (
+            "Unable to build working set trace", 
+            util::log::type::ABORT
+        );
+
+        return EXIT_FAILURE;
+    }
+
+
+    /****************************** RUN SIMULATION ****************************/
+
+    simulator::model::report_t report;
+    simulator::model::status_code model_status 
+        = simulator::model::run(trace, parameters, policy, report);
+    if (static_cast<bool>(model_status))
+    {
+        util::log::record
+        (
+            "Simulation stopped after " + std::to_string(report.intervals)
+                + " intervals", 
+            util::log::type::ABORT
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    util::log::record
+    (
+        "intervals: " + std::to_string(report.intervals)
+            + ", guests: " + std::to_string(trace.guests.size())
+    );
+    util::log::record
+    (
+        "convergence (s): mean " + std::to_string(report.mean_convergence)
+            + ", maximum " + std::to_string(report.maximum_convergence)
+            + ", converged " + std::to_string(report.convergences)
+            + " of " + std::to_string(report.disturbances) + " disturbances"
+    );
+    util::log::record
+    (
+        "peak swap (KiB): guest " + std::to_string(report.peak_guest_swap)
+            + ", host " + std::to_string(report.peak_host_swap)
+    );
+    util::log::record
+    (
+        "overcommit ratio: " + std::to_string(report.overcommit_ratio)
+    );
+    util::log::record
+    (
+        "balloon operations: " + std::to_string(report.balloon_operations)
+            + ", per hour " + std::to_string(report.operations_per_hour)
+    );
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,248 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+#include <log/record.hpp>
+#include <stat/statistics.hpp>
+
+#include "trace.hpp"
+
+
+/**
+ *  @brief Trace Loader
+ *
+ *  @param path:  trace file path
+ *  @param trace: structure reference to write to
+ *
+ *  @details Reads a trace of whitespace separated lines, with # comments
+ *
+ *      host <memory KiB>
+ *      guest <name> <memory limit KiB> <initial memory KiB>
+ *      length <intervals>
+ *      <interval> <guest name> <working set KiB>
+ *
+ *  where guests are declared before their working sets, and a working set
+ *  holds until the guest's next one. Length defaults to one past the last
+ *  working set.
+ *
+ *  @return execution status code
+ */
+simulator::trace::status_code
+simulator::trace::load
+(
+    const std::string               &path,
+          simulator::trace::trace_t &trace
+) noexcept
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        util::log::record
+        (
+            "Unable to open trace " + path,
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    trace = simulator::trace::trace_t();
+    std::unordered_map<std::string, std::size_t> guests;
+    std::string line;
+    std::size_t line_number = 0;
+    while (std::getline(file, line))
+    {
+        ++line_number;
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream stream(line);
+        std::string field;
+        if (!(stream >> field))
+            continue;
+
+        bool parsed = false;
+        if (field == "host")
+            parsed = static_cast<bool>(stream >> trace.host_memory);
+
+        else if (field == "length")
+            parsed = static_cast<bool>(stream >> trace.length);
+
+        else if (field == "guest")
+        {
+            simulator::trace::guest_t guest;
+            parsed = stream >> guest.name >> guest.memory_limit 
+                            >> guest.initial_memory
+                  && guests.find(guest.name) == guests.end()
+                  && guest.initial_memory <= guest.memory_limit;
+            if (parsed)
+            {
+                guests[guest.name] = trace.guests.size();
+                trace.guests.push_back(guest);
+            }
+        }
+
+        else
+        {
+            try
+            {
+                simulator::trace::point_t point;
+                std::string name;
+                point.tick = std::stoull(field);
+                parsed = stream >> name >> point.working_set
+                      && guests.find(name) != guests.end();
+                if (parsed)
+                {
+                    point.guest = guests[name];
+                    trace.points.push_back(point);
+                }
+            }
+
+            catch (const std::exception &exception)
+            {
+                parsed = false;
+            }
+        }
+
+        if (!parsed)
+        {
+            util::log::record
+            (
+                "Malformed trace line " + std::to_string(line_number) 
+                    + " of " + path,
+                util::log::type::ERROR
+            );
+
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (trace.host_memory <= 0 || trace.guests.empty())
+    {
+        util::log::record
+        (
+            "Trace " + path + " must declare host memory and guests",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Order working sets by interval, keeping file order within one
+    std::stable_sort
+    (
+        trace.points.begin(), trace.points.end(), []
+        (
+            const simulator::trace::point_t &point_A,
+            const simulator::trace::point_t &point_B
+        )
+        {
+            return point_A.tick < point_B.tick;
+        }
+    );
+    if (trace.length == 0 && !trace.points.empty())
+        trace.length = trace.points.back().tick + 1;
+
+    return EXIT_SUCCESS;
+}
+
+
+/**
+ *  @brief Trace Synthesizer
+ *
+ *  @param parameters: synthetic trace tunables
+ *  @param trace:      structure reference to write to
+ *
+ *  @details Guests of 2, 4, or 8 GiB start at half their limit, and hold
+ *  working sets of 20% to 90% of their limit for phases of random length.
+ *  Host memory is the guests' total limit over the overcommit ratio. The
+ *  same parameters always yield the same trace.
+ *
+ *  @return execution status code
+ */
+simulator::trace::status_code
+simulator::trace::synthesize
+(
+    const simulator::trace::parameters_t &parameters,
+          simulator::trace::trace_t      &trace
+) noexcept
+{
+    if (parameters.number_of_guests == 0 || parameters.overcommit <= 0
+        || parameters.minimum_phase == 0
+        || parameters.minimum_phase > parameters.maximum_phase)
+    {
+        util::log::record
+        (
+            "Synthetic trace needs guests, a positive overcommit and "
+            "0 < minimum_phase <= maximum_phase",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    trace = simulator::trace::trace_t();
+    trace.length = parameters.length;
+
+    std::mt19937_64 generator(parameters.seed);
+    std::uniform_int_distribution<std::size_t> size(1, 3);
+    std::uniform_int_distribution<std::size_t> phase
+    (
+        parameters.minimum_phase, parameters.maximum_phase
+    );
+    std::uniform_real_distribution<std::double_t> working_set(0.2, 0.9);
+
+    util::stat::slong_t total_limit = 0;
+    for (std::size_t guest = 0; guest < parameters.number_of_guests; ++guest)
+    {
+        const util::stat::slong_t memory_limit 
+            = static_cast<util::stat::slong_t>(1 << 20) << size(generator);
+        trace.guests.push_back
+        (
+            {"guest-" + std::to_string(guest), memory_limit, memory_limit / 2}
+        );
+        total_limit += memory_limit;
+
+        for 
+        (
+            std::size_t tick = 0; 
+            tick < parameters.length; 
+            tick += phase(generator)
+        )
+        {
+            trace.points.push_back
+            (
+                {
+                    tick, guest, 
+                    static_cast<util::stat::slong_t>
+                    (
+                        working_set(generator) * memory_limit
+                    )
+                }
+            );
+        }
+    }
+    trace.host_memory = static_cast<util::stat::slong_t>
+    (
+        total_limit / parameters.overcommit
+    );
+
+    std::stable_sort
+    (
+        trace.points.begin(), trace.points.end(), []
+        (
+            const simulator::trace::point_t &point_A,
+            const simulator::trace::point_t &point_B
+        )
+        {
+            return point_A.tick < point_B.tick;
+        }
+    );
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <stat/statistics.hpp>
+
+
+/**
+ *  @brief Working Set Trace Header
+ *
+ *  @details Defines the guests of a simulated host and the working sets they
+ *  touch over time, recorded from real guests or synthesized
+ */
+namespace simulator
+{
+
+namespace trace
+{
+
+using status_code = std::uint8_t;
+
+// Simulated guest; memory in KiB
+typedef struct guest_t
+{
+    std::string         name;
+    util::stat::slong_t memory_limit;
+    util::stat::slong_t initial_memory;
+} guest_t;
+
+// Working set of a guest from a given interval on
+typedef struct point_t
+{
+    std::size_t         tick;
+    std::size_t         guest;
+    util::stat::slong_t working_set;
+} point_t;
+
+// Trace of a host; points in order of interval
+typedef struct trace_t
+{
+    util::stat::slong_t  host_memory = 0;
+    std::size_t          length      = 0;
+    std::vector<guest_t> guests;
+    std::vector<point_t> points;
+} trace_t;
+
+// Tunables of synthetic traces; overcommit is guests' total memory limit
+// over host memory, phases in intervals
+typedef struct parameters_t
+{
+    std::size_t   number_of_guests = 16;
+    std::size_t   length           = 720;
+    std::uint64_t seed             = 0x5eed;
+    std::double_t overcommit       = 1.500;
+    std::size_t   minimum_phase    = 30;
+    std::size_t   maximum_phase    = 120;
+} parameters_t;
+
+// Trace routines
+[[nodiscard("Trace load status must be checked")]]
+status_code
+load
+(
+    const std::string &path,
+          trace_t     &trace
+) noexcept;
+
+[[nodiscard("Trace synthesis status must be checked")]]
+status_code
+synthesize
+(
+    const parameters_t &parameters,
+          trace_t      &trace
+) noexcept;
+
+} // trace namespace
+
+} // simulator namespace
@@ -0,0 +1,289 @@
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <backend/backend.hpp>
+#include <lib/libvirt.hpp>
+#include <log/record.hpp>
+#include <stat/statistics.hpp>
+#include <task/pool.hpp>
+
+#include "domain/domain.hpp"
+#include "hotplug/hotplug.hpp"
+
+#include "actuator.hpp"
+
+
+// Setter replacing libvirt calls; empty for real domains
+static manager::actuator::setter_t balloon_setter;
+
+// Domains with a call in flight, including calls given up on
+static std::mutex                                  in_flight_mutex;
+static std::unordered_set<libvirt::domain::uuid_t> in_flight;
+
+
+/**
+ *  @brief Balloon Setter Hook
+ *
+ *  @param setter: setter to apply targets through; empty restores libvirt
+ *
+ *  @details Must be set before any targets are applied
+ */
+void
+manager::actuator::hook
+(
+    manager::actuator::setter_t setter
+) noexcept
+{
+    balloon_setter = std::move(setter);
+}
+
+
+/**
+ *  @brief In Flight Claimer
+ *
+ *  @param UUID: domain about to be called
+ *
+ *  @return whether domain had no call in flight and is now claimed
+ */
+bool
+static claim
+(
+    const libvirt::domain::uuid_t &uuid
+) noexcept
+{
+    try
+    {
+        std::lock_guard<std::mutex> lock(in_flight_mutex);
+        return in_flight.insert(uuid).second;
+    }
+
+    catch (const std::exception &exception)
+    {
+        return false;
+    }
+}
+
+
+/**
+ *  @brief In Flight Releaser
+ *
+ *  @param UUID: domain whose call returned
+ */
+void
+static release
+(
+    const libvirt::domain::uuid_t &uuid
+) noexcept
+{
+    std::lock_guard<std::mutex> lock(in_flight_mutex);
+    in_flight.erase(uuid);
+}
+
+
+/**
+ *  @brief Balloon Target Applier
+ *
+ *  @param requests:   balloon targets of domains
+ *  @param parameters: worker pool tunables
+ *  @param outcomes:   structure reference to write to
+ *
+ *  @details Sets the memory of every requested domain on the worker pool and
+ *  waits for all calls to finish or time out. Each call holds its own
+ *  reference on the domain, so a call abandoned on timeout stays valid after
+ *  the domain data is released.
+ *
+ *  Targets carrying a virtio-mem device set the device's requested size to
+ *  its current one plus the change instead, which is not bounded by the
+ *  domain's maximum memory.
+ *
+ *  Domains still having a call in flight, as when an earlier call was given
+ *  up on, are not called again until it returns, such that a stale target
+ *  cannot land after a newer one. Their targets are held and time out
+ *  without being attempted.
+ *
+ *  Outcomes are in the same order as the requests; failed and timed out
+ *  calls are logged here.
+ *
+ *  @return execution status code
+ */
+manager::actuator::status_code
+manager::actuator::apply
+(
+    const manager::actuator::requests_t &requests,
+    const util::task::parameters_t      &parameters,
+          manager::actuator::outcomes_t &outcomes
+) noexcept
+{
+    std::vector<bool>   issued(requests.size(), false);
+    util::task::tasks_t tasks;
+    try
+    {
+        tasks.reserve(requests.size());
+        for (std::size_t index = 0; index < requests.size(); ++index)
+        {
+            const manager::actuator::request_t &request = requests[index];
+            const libvirt::domain::uuid_t       uuid    = request.datum->uuid;
+
+            // Targets are not sent while an earlier one may still land
+            if (!claim(uuid))
+            {
+                util::log::record
+                (
+                    "Domain " + uuid + " still has a memory call in flight; "
+                        "holding its target",
+                    util::log::type::FLAG
+                );
+
+                continue;
+            }
+            issued[index] = true;
+
+            util::task::task_t call;
+
+            // Targets applied through hooked setter
+            if (balloon_setter)
+            {
+                const util::stat::slong_t memory_chunk = request.memory_chunk;
+
+                call = [uuid, memory_chunk]() -> util::task::status_code
+                {
+                    return balloon_setter(uuid, memory_chunk);
+                };
+            }
+
+            // Targets resizing a virtio-mem device
+            else if (request.device != nullptr)
+            {
+                const std::shared_ptr<libvirt::virDomain> domain
+                    = libvirt::domain::reference(request.datum->domain.get());
+                const libvirt::hotplug::device_t device = *request.device;
+                const util::stat::slong_t requested = device.requested
+                    + request.memory_chunk - request.datum->balloon_memory_used;
+
+                call = [domain, device, requested]() -> util::task::status_code
+                {
+                    return libvirt::hotplug::resize
+                    (
+                        domain.get(), device, requested
+                    );
+                };
+            }
+
+            else
+            {
+                const std::shared_ptr<libvirt::virDomain> domain
+                    = libvirt::domain::reference(request.datum->domain.get());
+                const util::stat::ulong_t memory_chunk
+                    = static_cast<util::stat::ulong_t>(request.memory_chunk);
+
+                call = [domain, memory_chunk]() -> util::task::status_code
+                {
+                    if (domain == nullptr)
+                        return EXIT_FAILURE;
+
+                    const libvirt::backend::backend_t &backend
+                        = libvirt::backend::current();
+                    if (backend.balloon(domain.get(), memory_chunk))
+                        return EXIT_FAILURE;
+
+                    return EXIT_SUCCESS;
+                };
+            }
+
+            // Domain is released once its call succeeds or runs out of
+            // attempts, however long after being given up on
+            const std::size_t number_of_attempts
+                = parameters.number_of_retries + 1;
+            const std::shared_ptr<std::size_t> attempts
+                = std::make_shared<std::size_t>(0);
+
+            tasks.emplace_back
+            (
+                [uuid, call, attempts, number_of_attempts]()
+                    -> util::task::status_code
+                {
+                    const util::task::status_code status = call();
+                    if (!static_cast<bool>(status)
+                        || ++*attempts >= number_of_attempts)
+                        release(uuid);
+
+                    return status;
+                }
+            );
+        }
+    }
+
+    catch (const std::exception &exception)
+    {
+        for (std::size_t index = 0; index < requests.size(); ++index)
+        {
+            if (issued[index])
+                release(requests[index].datum->uuid);
+        }
+
+        util::log::record
+        (
+            "Unable to build memory actuation tasks",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Apply targets concurrently
+    util::task::results_t results;
+    util::task::status_code status
+        = util::task::run(tasks, parameters, results);
+    if (static_cast<bool>(status))
+    {
+        util::log::record
+        (
+            "Unable to run memory actuation tasks",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Held targets time out without being attempted
+    util::task::result_t held;
+    held.status = util::task::outcome::TIMEOUT;
+    outcomes.assign(requests.size(), held);
+    for (std::size_t index = 0, task = 0; index < requests.size(); ++index)
+    {
+        if (issued[index])
+            outcomes[index] = results[task++];
+    }
+
+    // Report domains not reaching their target
+    for (std::size_t index = 0; index < requests.size(); ++index)
+    {
+        const manager::actuator::request_t &request = requests[index];
+        const util::task::result_t         &outcome = outcomes[index];
+        if (outcome.status == util::task::outcome::SUCCESS || !issued[index])
+            continue;
+
+        util::log::record
+        (
+            "Unable to set domain " + request.datum->uuid
+                + (request.device != nullptr ? "'s hotplugged" : "'s")
+                + " memory to " + std::to_string(request.memory_chunk)
+                + " KiB"
+                + (outcome.status == util::task::outcome::TIMEOUT
+                    ? " within timeout"
+                    : " after " + std::to_string(outcome.attempts)
+                        + " attempts"),
+            util::log::type::FLAG
+        );
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <stat/statistics.hpp>
+#include <task/pool.hpp>
+
+#include "domain/domain.hpp"
+#include "hotplug/hotplug.hpp"
+
+
+/**
+ *  @brief Balloon Actuator Header
+ *
+ *  @details Defines routines applying a batch of balloon targets to domains
+ *  concurrently, such that a slow guest balloon driver delays only itself;
+ *  targets routed to a virtio-mem device resize it instead
+ */
+namespace manager
+{
+
+namespace actuator
+{
+
+using status_code = std::uint8_t;
+
+// Memory target of a single domain; ballooned unless a virtio-mem device
+// is given
+typedef struct request_t
+{
+    const libvirt::domain::datum_t   *datum;
+    util::stat::slong_t               memory_chunk;
+    const libvirt::hotplug::device_t *device = nullptr;
+} request_t;
+
+using requests_t = std::vector<request_t>;
+using outcomes_t = util::task::results_t;
+
+// Balloon target setter standing in for libvirt, as when simulating guests;
+// called concurrently from worker threads
+using setter_t = std::function
+<
+    status_code (const libvirt::domain::uuid_t &, util::stat::slong_t)
+>;
+
+// Actuation routines
+void
+hook
+(
+    setter_t setter
+) noexcept;
+
+[[nodiscard("Actuation exit status must be checked")]]
+status_code
+apply
+(
+    const requests_t               &requests,
+    const util::task::parameters_t &parameters,
+          outcomes_t               &outcomes
+) noexcept;
+
+} // actuator namespace
+
+} // manager namespace
@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+#include <stat/statistics.hpp>
+
+#include "allocator.hpp"
+
+
+/**
+ *  @brief Weighted Water Level Fill
+ *
+ *  @param demands: memory each claim still wants
+ *  @param weights: relative share of each claim
+ *  @param supply:  memory to divide
+ *  @param shares:  shares to add memory given to
+ *
+ *  @details Raises a common water level, in memory per unit of weight, until
+ *  supply runs out; claims wanting less than the level are filled exactly and
+ *  all others get the level times their weight. Claims are visited in order
+ *  of demand per weight, so the division is independent of claim order.
+ *
+ *  @return memory given out
+ */
+util::stat::slong_t
+static fill
+(
+    const std::vector<util::stat::slong_t> &demands,
+    const std::vector<std::double_t>       &weights,
+          util::stat::slong_t               supply,
+          manager::allocator::shares_t     &shares
+) noexcept
+{
+    std::vector<std::size_t> order;
+    order.reserve(demands.size());
+    std::double_t total_weight = 0;
+    for (std::size_t claim = 0; claim < demands.size(); ++claim)
+    {
+        if (demands[claim] <= 0 || weights[claim] <= 0)
+            continue;
+
+        order.push_back(claim);
+        total_weight += weights[claim];
+    }
+
+    // Smallest demand per weight fills first; ties broken by claim index
+    std::sort
+    (
+        order.begin(), order.end(), [&demands, &weights]
+        (
+            std::size_t claim_A,
+            std::size_t claim_B
+        )
+        {
+            const std::double_t level_A = demands[claim_A] / weights[claim_A];
+            const std::double_t level_B = demands[claim_B] / weights[claim_B];
+            if (level_A != level_B)
+                return level_A < level_B;
+
+            return claim_A < claim_B;
+        }
+    );
+
+    util::stat::slong_t given = 0;
+    for (std::size_t position = 0; position < order.size(); ++position)
+    {
+        const std::size_t claim = order[position];
+        const std::double_t level
+            = static_cast<std::double_t>(supply - given) / total_weight;
+
+        // Claim fits under water level
+        if (demands[claim] <= level * weights[claim])
+        {
+            shares[claim] += demands[claim];
+            given         += demands[claim];
+            total_weight  -= weights[claim];
+
+            continue;
+        }
+
+        // Remaining claims all rise to water level
+        for (; position < order.size(); ++position)
+        {
+            const std::size_t rest = order[position];
+            const util::stat::slong_t share = std::min
+            (
+                demands[rest],
+                static_cast<util::stat::slong_t>
+                (
+                    std::floor(level * weights[rest])
+                )
+            );
+            shares[rest] += share;
+            given        += share;
+        }
+    }
+
+    return given;
+}
+
+
+/**
+ *  @brief Max-Min Fair Memory Allocator
+ *
+ *  @param claims: memory claimed by each domain
+ *  @param supply: memory available to divide
+ *  @param shares: structure reference to write to, in order of claims
+ *
+ *  @details Serves guarantees first, sharing supply evenly amongst them when
+ *  it cannot cover all of them, then divides what is left of the supply by
+ *  weighted water-filling over what each claim still requests.
+ *
+ *  No claim gets more than it requests, and no claim can get more without
+ *  another claim of no greater share per weight getting less. Division runs
+ *  in O(n log n) and does not depend on the order of claims.
+ *
+ *  @return memory given out
+ */
+util::stat::slong_t
+manager::allocator::water_fill
+(
+    const manager::allocator::claims_t &claims,
+          util::stat::slong_t           supply,
+          manager::allocator::shares_t &shares
+) noexcept
+{
+    const std::size_t number_of_claims = claims.size();
+    shares.assign(number_of_claims, 0);
+    if (number_of_claims == 0 || supply <= 0)
+        return 0;
+
+    // Serve guarantees evenly
+    std::vector<util::stat::slong_t> demands(number_of_claims);
+    std::vector<std::double_t>       weights(number_of_claims, 1.0);
+    for (std::size_t claim = 0; claim < number_of_claims; ++claim)
+    {
+        demands[claim] = std::clamp
+        (
+            claims[claim].guarantee,
+            static_cast<util::stat::slong_t>(0),
+            std::max<util::stat::slong_t>(claims[claim].request, 0)
+        );
+    }
+    util::stat::slong_t given = fill(demands, weights, supply, shares);
+
+    // Share rest of supply by weight
+    for (std::size_t claim = 0; claim < number_of_claims; ++claim)
+    {
+        demands[claim] = std::max<util::stat::slong_t>
+        (
+            claims[claim].request - shares[claim], 0
+        );
+        weights[claim] = claims[claim].weight;
+    }
+    given += fill(demands, weights, supply - given, shares);
+
+    return given;
+}
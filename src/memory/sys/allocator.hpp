@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include <stat/statistics.hpp>
+
+
+/**
+ *  @brief Memory Allocator Header
+ *
+ *  @details Defines the max-min fair (water-filling) division of scarce
+ *  memory amongst domains requesting more of it
+ */
+namespace manager
+{
+
+namespace allocator
+{
+
+// Memory claimed by a single domain; guarantee is the part of the request
+// served before contended memory is shared by weight
+typedef struct claim_t
+{
+    util::stat::slong_t request   = 0;
+    util::stat::slong_t guarantee = 0;
+    std::double_t       weight    = 1.0;
+} claim_t;
+
+using claims_t = std::vector<claim_t>;
+using shares_t = std::vector<util::stat::slong_t>;
+
+// Allocation routines
+util::stat::slong_t
+water_fill
+(
+    const claims_t            &claims,
+          util::stat::slong_t  supply,
+          shares_t            &shares
+) noexcept;
+
+} // allocator namespace
+
+} // manager namespace
@@ -0,0 +1,197 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+
+#include <log/record.hpp>
+#include <metric/registry.hpp>
+#include <stat/statistics.hpp>
+
+#include "cgroup/cgroup.hpp"
+#include "domain/domain.hpp"
+
+#include "backstop.hpp"
+#include "balloon.hpp"
+
+
+/**
+ *  @brief Scope Bound Writer
+ *
+ *  @param state:      domain's scope and bound
+ *  @param parameters: backstop tunables
+ *  @param limit:      memory.high in KiB, or unlimited to lift bounds
+ *
+ *  @return execution status code
+ */
+manager::backstop::status_code
+static bound
+(
+    const manager::backstop::state_t      &state,
+    const manager::backstop::parameters_t &parameters,
+          util::stat::slong_t              limit
+) noexcept
+{
+    os::cgroup::status_code status
+        = os::cgroup::limit(state.path, os::cgroup::memory_high, limit);
+    if (static_cast<bool>(status) || parameters.margin <= 0)
+        return status;
+
+    return os::cgroup::limit
+    (
+        state.path, os::cgroup::memory_max,
+        limit < 0 ? os::cgroup::unlimited : limit + parameters.margin
+    );
+}
+
+
+/**
+ *  @brief Scope Locator
+ *
+ *  @param state:      domain's scope and bound
+ *  @param parameters: backstop tunables
+ *  @param datum:      domain to locate scope of
+ *
+ *  @details Scopes are looked up once per domain by its libvirt ID
+ *
+ *  @return execution status code
+ */
+manager::backstop::status_code
+manager::backstop::locate
+(
+          manager::backstop::state_t      &state,
+    const manager::backstop::parameters_t &parameters,
+    const libvirt::domain::datum_t        &datum
+) noexcept
+{
+    if (!state.path.empty())
+        return EXIT_SUCCESS;
+
+    if (datum.domain == nullptr)
+        return EXIT_FAILURE;
+
+    const util::stat::uint_t id = libvirt::virDomainGetID(datum.domain.get());
+    if (id == static_cast<util::stat::uint_t>(-1))
+    {
+        util::log::record
+        (
+            "Unable to get ID of domain " + datum.uuid,
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    return os::cgroup::scope(parameters.root, parameters.slice, id, state.path);
+}
+
+
+/**
+ *  @brief Backstop Enforcer
+ *
+ *  @param state:      domain's scope and bound
+ *  @param parameters: backstop tunables
+ *  @param balloon:    domain's balloon tracking
+ *  @param datum:      domain's current statistics
+ *  @param registry:   registry to count engagements in
+ *
+ *  @details A balloon target taking memory from a domain that stalled short
+ *  of it bounds the domain's scope to the target plus the QEMU overhead, and
+ *  the host reclaims the rest. The bound follows later stalled targets and
+ *  is lifted once the guest reaches its target or is given more memory.
+ *
+ *  @return execution status code
+ */
+manager::backstop::status_code
+manager::backstop::enforce
+(
+          manager::backstop::state_t      &state,
+    const manager::backstop::parameters_t &parameters,
+    const manager::balloon::state_t       &balloon,
+    const libvirt::domain::datum_t        &datum,
+          util::metric::registry_t        &registry
+) noexcept
+{
+    const bool stalled = balloon.stalls > state.stalls_seen;
+    state.stalls_seen  = balloon.stalls;
+
+    const util::stat::slong_t limit = balloon.target + parameters.overhead;
+
+    // Guest ignoring a reclaim is bounded from the host
+    if (stalled && balloon.target < balloon.initial_memory
+        && datum.balloon_memory_used > balloon.target)
+    {
+        if (state.engaged && state.limit == limit)
+            return EXIT_SUCCESS;
+
+        if (static_cast<bool>(locate(state, parameters, datum))
+            || static_cast<bool>(bound(state, parameters, limit)))
+            return EXIT_FAILURE;
+
+        util::log::record
+        (
+            "Domain " + datum.uuid + " bounded to "
+                + std::to_string(limit) + " KiB after its balloon stalled at "
+                + std::to_string(datum.balloon_memory_used) + " of target "
+                + std::to_string(balloon.target) + " KiB",
+            util::log::type::FLAG
+        );
+        util::metric::increment
+        (
+            registry, "memoryman_backstop_engagements_total",
+            "Scopes bounded after their balloons stalled", {}
+        );
+
+        state.engaged = true;
+        state.limit   = limit;
+
+        return EXIT_SUCCESS;
+    }
+
+    // Guest caught up or domain given memory again
+    if (state.engaged
+        && (datum.balloon_memory_used <= balloon.target || limit > state.limit))
+    {
+        if (static_cast<bool>(bound(state, parameters, os::cgroup::unlimited)))
+            return EXIT_FAILURE;
+
+        util::log::record("Domain " + datum.uuid + " bound lifted");
+        util::metric::increment
+        (
+            registry, "memoryman_backstop_releases_total",
+            "Scope bounds lifted", {}
+        );
+
+        state.engaged = false;
+        state.limit   = 0;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/**
+ *  @brief Engaged Backstop Exporter
+ *
+ *  @param table:    UUID-to-backstop table
+ *  @param registry: registry to publish bounded domains in
+ */
+void
+manager::backstop::export_engaged
+(
+    const manager::backstop::table_t &table,
+          util::metric::registry_t   &registry
+) noexcept
+{
+    const std::ptrdiff_t number_of_engaged = std::count_if
+    (
+        table.begin(), table.end(),
+        [](const auto &entry) { return entry.second.engaged; }
+    );
+
+    util::metric::set
+    (
+        registry, "memoryman_backstop_engaged_domains",
+        "Domains whose scopes are bounded from the host", {},
+        static_cast<std::double_t>(number_of_engaged)
+    );
+}
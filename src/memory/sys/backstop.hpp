@@ -0,0 +1,85 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include <metric/registry.hpp>
+#include <stat/statistics.hpp>
+
+#include "domain/domain.hpp"
+
+#include "balloon.hpp"
+
+
+/**
+ *  @brief Host Reclaim Backstop Header
+ *
+ *  @details Defines the per domain bounding of a QEMU scope's memory through
+ *  cgroup v2 when its guest does not deflate to a balloon target, such that
+ *  memory is reclaimed from the host side regardless of guest cooperation
+ */
+namespace manager
+{
+
+namespace backstop
+{
+
+using status_code = std::uint8_t;
+
+// Tunables; root is the cgroup v2 mount, overhead the memory QEMU uses
+// beyond guest memory in KiB, and margin the KiB above memory.high that
+// memory.max is set to, where zero leaves memory.max alone
+typedef struct parameters_t
+{
+    bool                enabled  = false;
+    std::string         root     = "/sys/fs/cgroup";
+    std::string         slice    = "machine.slice";
+    util::stat::slong_t overhead = 256 << 10;
+    util::stat::slong_t margin   = 0;
+} parameters_t;
+
+// Per domain scope and bound kept between load balancer iterations
+typedef struct state_t
+{
+    std::string         path;
+    bool                engaged     = false;
+    util::stat::slong_t limit       = 0;
+    std::size_t         stalls_seen = 0;
+} state_t;
+
+using table_t = std::unordered_map<libvirt::domain::uuid_t, state_t>;
+
+// Backstop routines
+[[nodiscard("Scope lookup status must be checked")]]
+status_code
+locate
+(
+          state_t                  &state,
+    const parameters_t             &parameters,
+    const libvirt::domain::datum_t &datum
+) noexcept;
+
+[[nodiscard("Backstop status must be checked")]]
+status_code
+enforce
+(
+          state_t                  &state,
+    const parameters_t             &parameters,
+    const balloon::state_t         &balloon,
+    const libvirt::domain::datum_t &datum,
+          util::metric::registry_t &registry
+) noexcept;
+
+void
+export_engaged
+(
+    const table_t                  &table,
+          util::metric::registry_t &registry
+) noexcept;
+
+} // backstop namespace
+
+} // manager namespace
@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+#include <log/record.hpp>
+#include <metric/registry.hpp>
+#include <stat/statistics.hpp>
+
+#include "domain/domain.hpp"
+
+#include "balloon.hpp"
+
+
+// Balloon response time buckets in seconds
+static const util::metric::bounds_t RESPONSE_BOUNDS
+    = {0.5, 1.0, 2.0, 5.0, 10.0, 20.0, 30.0, 60.0};
+
+
+/**
+ *  @brief Balloon Target Recorder
+ *
+ *  @param state:          domain's balloon tracking
+ *  @param initial memory: balloon size when target was set
+ *  @param target:         balloon target set
+ *  @param now:            time target was set
+ */
+void
+manager::balloon::issue
+(
+          manager::balloon::state_t             &state,
+          util::stat::slong_t                    initial_memory,
+          util::stat::slong_t                    target,
+    const std::chrono::steady_clock::time_point &now
+) noexcept
+{
+    state.pending          = true;
+    state.initial_memory   = initial_memory;
+    state.target           = target;
+    state.issued_at        = now;
+    state.completion_ratio = 0.0;
+}
+
+
+/**
+ *  @brief Balloon Convergence Check
+ *
+ *  @param state:      domain's balloon tracking
+ *  @param parameters: balloon tracking tunables
+ *  @param datum:      domain's current memory statistics
+ *  @param now:        time of this iteration
+ *  @param registry:   registry to observe response times in
+ *
+ *  @details Compares the balloon size the guest reports against its target
+ *  in flight. The completion ratio is the part of the requested change the
+ *  balloon has made. A target reached within tolerance has its response
+ *  time observed and folded into the domain's smoothed latency; a target
+ *  not reached within the timeout is given up on, counted as a stall, so a
+ *  guest whose balloon driver is stuck does not stop being balanced.
+ *
+ *  @return whether domain is still moving toward its target and should not
+ *  be issued a new one
+ */
+bool
+manager::balloon::converging
+(
+          manager::balloon::state_t             &state,
+    const manager::balloon::parameters_t        &parameters,
+    const libvirt::domain::datum_t              &datum,
+    const std::chrono::steady_clock::time_point &now,
+          util::metric::registry_t              &registry
+) noexcept
+{
+    if (!state.pending)
+        return false;
+
+    // Part of requested change made so far
+    const util::stat::slong_t requested = state.target - state.initial_memory;
+    const util::stat::slong_t made 
+        = datum.balloon_memory_used - state.initial_memory;
+    state.completion_ratio = requested == 0
+        ? 1.0
+        : std::clamp
+          (
+              static_cast<std::double_t>(made) / requested, 0.0, 1.0
+          );
+
+    const std::double_t elapsed 
+        = std::chrono::duration<std::double_t>(now - state.issued_at).count();
+    const bool reached 
+        = std::abs(datum.balloon_memory_used - state.target) 
+              <= parameters.tolerance
+        || state.completion_ratio >= parameters.completion;
+
+    // Target reached; balloon response observed
+    if (reached)
+    {
+        state.pending = false;
+        state.latency = state.responses == 0
+            ? elapsed
+            : parameters.smoothing * elapsed 
+              + (1 - parameters.smoothing) * state.latency;
+        ++state.responses;
+
+        util::metric::observe
+        (
+            registry, "memoryman_balloon_response_seconds",
+            "Time from setting a balloon target to the guest reaching it",
+            RESPONSE_BOUNDS, {}, elapsed
+        );
+
+        return false;
+    }
+
+    // Target given up on
+    if (now - state.issued_at >= parameters.timeout)
+    {
+        state.pending = false;
+        ++state.stalls;
+
+        util::log::record
+        (
+            "Domain " + datum.uuid + " balloon stalled at "
+                + std::to_string(datum.balloon_memory_used) + " of target "
+                + std::to_string(state.target) + " KiB after "
+                + std::to_string(elapsed) + " seconds",
+            util::log::type::FLAG
+        );
+        util::metric::increment
+        (
+            registry, "memoryman_balloon_stalls_total",
+            "Balloon targets not reached within timeout", {}
+        );
+
+        return false;
+    }
+
+    return true;
+}
+
+
+/**
+ *  @brief Balloon Response Metric Exporter
+ *
+ *  @param table:    balloon tracking of domains
+ *  @param registry: registry to publish metrics to
+ */
+void
+manager::balloon::export_response
+(
+    const manager::balloon::table_t &table,
+          util::metric::registry_t  &registry
+) noexcept
+{
+    // Series of domains no longer running are dropped
+    util::metric::clear(registry, "memoryman_balloon_completion_ratio");
+    util::metric::clear(registry, "memoryman_balloon_latency_seconds");
+    for (const auto &[uuid, state]: table)
+    {
+        const util::metric::labels_t labels = {{"domain", uuid}};
+        util::metric::set
+        (
+            registry, "memoryman_balloon_completion_ratio",
+            "Part of the last balloon target's change the guest has made",
+            labels, state.completion_ratio
+        );
+
+        if (state.responses == 0)
+            continue;
+
+        util::metric::set
+        (
+            registry, "memoryman_balloon_latency_seconds",
+            "Smoothed time for the guest to reach balloon targets", labels,
+            state.latency
+        );
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <unordered_map>
+
+#include <metric/registry.hpp>
+#include <stat/statistics.hpp>
+
+#include "domain/domain.hpp"
+
+
+/**
+ *  @brief Balloon Response Header
+ *
+ *  @details Defines the per domain tracking of balloon targets against the
+ *  balloon size guests actually report, as setting a target only asks the
+ *  guest's balloon driver to move
+ */
+namespace manager
+{
+
+namespace balloon
+{
+
+// Tunables; tolerance in KiB, completion is the fraction of the requested
+// change after which a domain takes new targets, and targets not completed
+// within the timeout are given up on
+typedef struct parameters_t
+{
+    bool                 enabled    = true;
+    util::stat::slong_t  tolerance  = 4 << 10;
+    std::double_t        completion = 0.900;
+    std::chrono::seconds timeout    = std::chrono::seconds(60);
+    std::double_t        smoothing  = 0.300;
+} parameters_t;
+
+// Per domain balloon target in flight and response history
+typedef struct state_t
+{
+    bool                                  pending          = false;
+    util::stat::slong_t                   initial_memory   = 0;
+    util::stat::slong_t                   target           = 0;
+    std::chrono::steady_clock::time_point issued_at;
+    std::double_t                         completion_ratio = 1.0;
+    std::double_t                         latency          = 0.0;
+    std::size_t                           responses        = 0;
+    std::size_t                           stalls           = 0;
+} state_t;
+
+using table_t = std::unordered_map<libvirt::domain::uuid_t, state_t>;
+
+// Balloon response routines
+void
+issue
+(
+          state_t                               &state,
+          util::stat::slong_t                    initial_memory,
+          util::stat::slong_t                    target,
+    const std::chrono::steady_clock::time_point &now
+) noexcept;
+
+[[nodiscard("Must use whether domain is converging to call")]]
+bool
+converging
+(
+          state_t                               &state,
+    const parameters_t                          &parameters,
+    const libvirt::domain::datum_t              &datum,
+    const std::chrono::steady_clock::time_point &now,
+          util::metric::registry_t              &registry
+) noexcept;
+
+void
+export_response
+(
+    const table_t                  &table,
+          util::metric::registry_t &registry
+) noexcept;
+
+} // balloon namespace
+
+} // manager namespace
@@ -0,0 +1,277 @@
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <lib/libvirt.hpp>
+#include <log/record.hpp>
+#include <metric/registry.hpp>
+#include <stat/statistics.hpp>
+#include <task/pool.hpp>
+
+#include "attribute/attribute.hpp"
+#include "domain/domain.hpp"
+
+#include "collector.hpp"
+
+
+/**
+ *  @brief Stale Statistics Fallback
+ *
+ *  @param state:    last statistics of each domain
+ *  @param datum:    domain to fill in, with its UUID and handle
+ *  @param registry: registry to count stale domains in
+ *
+ *  @return whether last statistics were found
+ */
+bool
+static fallback
+(
+    const manager::collector::state_t &state,
+          libvirt::domain::datum_t    &datum,
+          util::metric::registry_t    &registry
+) noexcept
+{
+    const auto last = state.last.find(datum.uuid);
+    if (last == state.last.end())
+        return false;
+
+    libvirt::domain::copy(last->second, datum);
+    datum.stale = true;
+
+    util::metric::increment
+    (
+        registry, "memoryman_collection_stale_total",
+        "Domains served from their last statistics", {}
+    );
+
+    return true;
+}
+
+
+/**
+ *  @brief Probe Builder
+ *
+ *  @param uuid:   domain's UUID
+ *  @param domain: domain's handle, which the probe takes its own reference on
+ *
+ *  @return probe to run
+ */
+std::shared_ptr<manager::collector::probe_t>
+static probe
+(
+    const libvirt::domain::uuid_t   &uuid,
+          libvirt::domain::domain_t &domain
+)
+{
+    std::shared_ptr<manager::collector::probe_t> probe
+        = std::make_shared<manager::collector::probe_t>();
+    probe->datum.uuid   = uuid;
+    probe->datum.domain = libvirt::domain::reference(domain.get());
+
+    return probe;
+}
+
+
+/**
+ *  @brief Deadline Bounded Statistics Collector
+ *
+ *  @param state:           last statistics and domains still being probed
+ *  @param parameters:      collection tunables
+ *  @param domain table:    UUID-to-domain table, whose handles are moved out
+ *  @param domain data:     structure reference to write to
+ *  @param attribute cache: slowly changing attributes kept between calls,
+ *                          shared with calls still in flight
+ *  @param registry:        registry to count stale domains in
+ *
+ *  @details Collects every domain on the task pool, each call holding its
+ *  own reference on the domain and on the attribute cache so calls given up
+ *  on stay valid after the caller is gone, and waits at most the deadline
+ *  for any domain. Domains missing it are served from their last statistics,
+ *  marked stale, and join the slow set; their calls go on in the background
+ *  and are not repeated until they return, at which point their statistics are
+ *  kept and the domain is collected again. Domains failing or missing the
+ *  deadline before ever being collected are left out of the iteration, such
+ *  that no single domain fails collection of the others.
+ *
+ *  @return execution status code
+ */
+manager::collector::status_code
+manager::collector::collect
+(
+          manager::collector::state_t      &state,
+    const manager::collector::parameters_t &parameters,
+          libvirt::domain::table_t         &domain_table,
+          libvirt::domain::data_t          &domain_data,
+    const libvirt::attribute::handle_t     &attribute_cache,
+          util::metric::registry_t         &registry
+) noexcept
+{
+    using probe_ptr_t = std::shared_ptr<manager::collector::probe_t>;
+
+    libvirt::domain::data_t  collected;
+    std::vector<probe_ptr_t> probes;
+    util::task::tasks_t      tasks;
+    try
+    {
+        collected.reserve(domain_table.size());
+        probes.reserve(domain_table.size());
+        for (auto &[uuid, domain]: domain_table)
+        {
+            // Slow domain still in flight is not probed again
+            const auto slow = state.slow.find(uuid);
+            if (slow != state.slow.end())
+            {
+                const probe_ptr_t &pending = slow->second;
+                if (!pending->done.load(std::memory_order_acquire))
+                {
+                    libvirt::domain::datum_t datum;
+                    datum.uuid   = uuid;
+                    datum.domain = std::move(domain);
+
+                    collected.emplace_back(std::move(datum));
+                    probes.emplace_back(nullptr);
+
+                    continue;
+                }
+
+                if (!static_cast<bool>(pending->status))
+                    libvirt::domain::copy(pending->datum, state.last[uuid]);
+
+                util::log::record("Domain " + uuid + " answered again");
+                state.slow.erase(slow);
+            }
+
+            probe_ptr_t next = probe(uuid, domain);
+            tasks.emplace_back
+            (
+                [next, attribute_cache]() -> util::task::status_code
+                {
+                    next->status = next->datum.domain == nullptr
+                        ? EXIT_FAILURE
+                        : libvirt::domain::statistics
+                          (
+                              next->datum, *attribute_cache
+                          );
+                    next->done.store(true, std::memory_order_release);
+
+                    return next->status;
+                }
+            );
+
+            libvirt::domain::datum_t datum;
+            datum.uuid   = uuid;
+            datum.domain = std::move(domain);
+
+            collected.emplace_back(std::move(datum));
+            probes.emplace_back(std::move(next));
+        }
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Unable to build statistics collection tasks",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Collect domains concurrently under deadline
+    util::task::parameters_t pool;
+    pool.number_of_workers = parameters.number_of_workers;
+    pool.number_of_retries = 0;
+    pool.timeout           = parameters.deadline;
+
+    util::task::results_t results;
+    util::task::status_code status = util::task::run(tasks, pool, results);
+    if (static_cast<bool>(status))
+    {
+        util::log::record
+        (
+            "Unable to run statistics collection tasks",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    for (std::size_t index = 0; index < collected.size(); ++index)
+    {
+        libvirt::domain::datum_t &datum   = collected[index];
+        const probe_ptr_t        &current = probes[index];
+        const bool done = current != nullptr
+            && current->done.load(std::memory_order_acquire);
+
+        // Fresh statistics
+        if (done && !static_cast<bool>(current->status))
+        {
+            libvirt::domain::copy(current->datum, datum);
+            libvirt::domain::copy(current->datum, state.last[datum.uuid]);
+            datum.stale = false;
+
+            domain_data.emplace_back(std::move(datum));
+            continue;
+        }
+
+        // Domain missing the deadline joins the slow set
+        const bool slow = !done;
+        if (current != nullptr && slow)
+        {
+            util::log::record
+            (
+                "Domain " + datum.uuid + " missed the "
+                    + std::to_string(parameters.deadline.count())
+                    + " ms collection deadline",
+                util::log::type::FLAG
+            );
+
+            state.slow[datum.uuid] = current;
+        }
+
+        if (fallback(state, datum, registry))
+        {
+            domain_data.emplace_back(std::move(datum));
+            continue;
+        }
+
+        // Domains never collected are left out rather than failing the rest
+        util::log::record
+        (
+            "Domain " + datum.uuid + " left out until collected once",
+            util::log::type::FLAG
+        );
+    }
+
+    // Forget domains gone from host
+    for (auto last = state.last.begin(); last != state.last.end();)
+    {
+        if (domain_table.find(last->first) == domain_table.end())
+            last = state.last.erase(last);
+        else
+            ++last;
+    }
+    for (auto slow = state.slow.begin(); slow != state.slow.end();)
+    {
+        if (domain_table.find(slow->first) == domain_table.end())
+            slow = state.slow.erase(slow);
+        else
+            ++slow;
+    }
+
+    util::metric::set
+    (
+        registry, "memoryman_collection_slow_domains",
+        "Domains whose statistics calls missed the deadline",
+        {}, static_cast<std::double_t>(state.slow.size())
+    );
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+#include <metric/registry.hpp>
+
+#include "attribute/attribute.hpp"
+#include "domain/domain.hpp"
+
+
+/**
+ *  @brief Statistics Collector Header
+ *
+ *  @details Defines the collection of domain statistics under a per domain
+ *  deadline, such that a hung guest delays an iteration by at most one
+ *  deadline and is then served from its last statistics until it answers
+ */
+namespace manager
+{
+
+namespace collector
+{
+
+using status_code = std::uint8_t;
+
+// Tunables; deadline bounds how long a domain's statistics calls are waited
+// on before its last statistics are used instead
+typedef struct parameters_t
+{
+    bool                      enabled           = true;
+    std::size_t               number_of_workers = 8;
+    std::chrono::milliseconds deadline = std::chrono::milliseconds(2000);
+} parameters_t;
+
+// Collection of a single domain, shared with the worker running it such that
+// it outlives calls given up on
+typedef struct probe_t
+{
+    libvirt::domain::datum_t datum;
+    status_code              status = EXIT_FAILURE;
+    std::atomic<bool>        done   = false;
+} probe_t;
+
+// Last statistics of each domain, and domains that missed the deadline with
+// their probes still in flight
+using last_t = std::unordered_map
+<
+    libvirt::domain::uuid_t,
+    libvirt::domain::datum_t
+>;
+using slow_t = std::unordered_map
+<
+    libvirt::domain::uuid_t,
+    std::shared_ptr<probe_t>
+>;
+
+typedef struct state_t
+{
+    last_t last;
+    slow_t slow;
+} state_t;
+
+// Collection routines
+[[nodiscard("Collection status must be checked")]]
+status_code
+collect
+(
+          state_t                      &state,
+    const parameters_t                 &parameters,
+          libvirt::domain::table_t     &domain_table,
+          libvirt::domain::data_t      &domain_data,
+    const libvirt::attribute::handle_t &attribute_cache,
+          util::metric::registry_t     &registry
+) noexcept;
+
+} // collector namespace
+
+} // manager namespace
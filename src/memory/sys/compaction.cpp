@@ -0,0 +1,208 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <log/record.hpp>
+#include <metric/registry.hpp>
+#include <stat/statistics.hpp>
+#include <task/pool.hpp>
+
+#include "buddy/buddy.hpp"
+
+#include "compaction.hpp"
+
+
+/**
+ *  @brief Fragmentation Sampler
+ *
+ *  @param state:      fragmentation state to refresh
+ *  @param parameters: compaction tunables
+ *  @param registry:   registry to publish fragmentation indices in
+ *
+ *  @details Reads the free blocks of each zone and derives every node's
+ *  unusable free space index for the wanted order
+ *
+ *  @return execution status code
+ */
+manager::compaction::status_code
+manager::compaction::sample
+(
+          manager::compaction::state_t      &state,
+    const manager::compaction::parameters_t &parameters,
+          util::metric::registry_t          &registry
+) noexcept
+{
+    state.index.clear();
+
+    os::buddy::status_code status
+        = os::buddy::read(parameters.buddyinfo, state.zones);
+    state.sampled = !static_cast<bool>(status);
+    if (!state.sampled)
+        return EXIT_FAILURE;
+
+    try
+    {
+        for (const os::buddy::zone_t &zone: state.zones)
+        {
+            if (state.index.find(zone.node) != state.index.end())
+                continue;
+
+            state.index[zone.node] = os::buddy::unusable_index
+            (
+                state.zones, zone.node, parameters.order
+            );
+        }
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Unable to allocate fragmentation indices",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    for (const auto &[node, index]: state.index)
+    {
+        util::metric::set
+        (
+            registry, "memoryman_fragmentation_index",
+            "Share of free memory in blocks below the compaction order",
+            {{"node", std::to_string(node)}}, index
+        );
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/**
+ *  @brief Proactive Compactor
+ *
+ *  @param state:      fragmentation state sampled this iteration
+ *  @param parameters: compaction tunables
+ *  @param now:        time of this iteration
+ *  @param registry:   registry to count compactions in
+ *
+ *  @details Compacts nodes whose fragmentation index reached the threshold
+ *  and which were not compacted within the interval, through each node's
+ *  compact file or, lacking those, once for the whole host. Compactions run
+ *  on the task pool and are waited on for the timeout only; one still
+ *  running then goes on in the background.
+ *
+ *  @return execution status code
+ */
+manager::compaction::status_code
+manager::compaction::compact
+(
+          manager::compaction::state_t          &state,
+    const manager::compaction::parameters_t     &parameters,
+    const std::chrono::steady_clock::time_point &now,
+          util::metric::registry_t              &registry
+) noexcept
+{
+    if (!state.sampled)
+        return EXIT_FAILURE;
+
+    std::vector<util::stat::sint_t> nodes;
+    std::vector<std::string>        paths;
+    util::task::tasks_t             tasks;
+    try
+    {
+        for (const auto &[node, index]: state.index)
+        {
+            if (index < parameters.threshold)
+                continue;
+
+            const manager::compaction::times_t::const_iterator compacted
+                = state.compacted_at.find(node);
+            if (compacted != state.compacted_at.end()
+                && now - compacted->second < parameters.interval)
+                continue;
+
+            std::error_code error;
+            std::string path = parameters.root + "/node"
+                             + std::to_string(node) + "/compact";
+            if (!std::filesystem::exists(path, error))
+            {
+                // Host wide compaction covers every node at once
+                if (!paths.empty() && paths.back() == parameters.fallback)
+                {
+                    nodes.push_back(node);
+                    continue;
+                }
+                path = parameters.fallback;
+            }
+
+            nodes.push_back(node);
+            if (paths.empty() || paths.back() != path)
+            {
+                paths.push_back(path);
+                tasks.emplace_back
+                (
+                    [path]() -> util::task::status_code
+                    {
+                        return os::buddy::compact(path);
+                    }
+                );
+            }
+        }
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Unable to allocate compaction batch",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+    if (tasks.empty())
+        return EXIT_SUCCESS;
+
+    // Rate limit compactions whatever their outcome
+    for (const util::stat::sint_t node: nodes)
+        state.compacted_at[node] = now;
+
+    util::task::parameters_t pool;
+    pool.number_of_workers = tasks.size();
+    pool.number_of_retries = 0;
+    pool.timeout           = parameters.timeout;
+
+    util::task::results_t results;
+    util::task::status_code status = util::task::run(tasks, pool, results);
+    if (static_cast<bool>(status))
+        return EXIT_FAILURE;
+
+    status = EXIT_SUCCESS;
+    for (std::size_t index = 0; index < results.size(); ++index)
+    {
+        std::string outcome = "completed";
+        if (results[index].status == util::task::outcome::TIMEOUT)
+            outcome = "background";
+        else if (results[index].status == util::task::outcome::FAILURE)
+        {
+            outcome = "failed";
+            status  = EXIT_FAILURE;
+        }
+
+        util::metric::increment
+        (
+            registry, "memoryman_compactions_total",
+            "Proactive compactions of fragmented memory",
+            {{"path", paths[index]}, {"outcome", outcome}}
+        );
+    }
+
+    return status;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include <metric/registry.hpp>
+#include <stat/statistics.hpp>
+
+#include "buddy/buddy.hpp"
+
+
+/**
+ *  @brief Memory Compaction Header
+ *
+ *  @details Defines the per node fragmentation index of host memory and the
+ *  rate limited proactive compaction of nodes short of high-order blocks
+ */
+namespace manager
+{
+
+namespace compaction
+{
+
+using status_code = std::uint8_t;
+
+// Tunables; order is that of the blocks wanted, such as transparent
+// hugepages, threshold the fragmentation index from which a node is
+// compacted, interval the least time between compactions of a node, and
+// timeout how long an iteration waits on compactions before going on
+typedef struct parameters_t
+{
+    bool                      enabled   = false;
+    std::string               buddyinfo = "/proc/buddyinfo";
+    std::string               root      = "/sys/devices/system/node";
+    std::string               fallback  = "/proc/sys/vm/compact_memory";
+    std::size_t               order     = 9;
+    std::double_t             threshold = 0.500;
+    std::chrono::seconds      interval  = std::chrono::seconds(300);
+    std::chrono::milliseconds timeout   = std::chrono::milliseconds(100);
+} parameters_t;
+
+using indices_t = std::map<util::stat::sint_t, std::double_t>;
+using times_t
+    = std::map<util::stat::sint_t, std::chrono::steady_clock::time_point>;
+
+// Fragmentation of each node read this iteration and when each node was
+// last compacted
+typedef struct state_t
+{
+    os::buddy::zones_t zones;
+    bool               sampled = false;
+    indices_t          index;
+    times_t            compacted_at;
+} state_t;
+
+// Memory compaction routines
+[[nodiscard("Fragmentation sampling status must be checked")]]
+status_code
+sample
+(
+          state_t                  &state,
+    const parameters_t             &parameters,
+          util::metric::registry_t &registry
+) noexcept;
+
+[[nodiscard("Compaction status must be checked")]]
+status_code
+compact
+(
+          state_t                               &state,
+    const parameters_t                          &parameters,
+    const std::chrono::steady_clock::time_point &now,
+          util::metric::registry_t              &registry
+) noexcept;
+
+} // compaction namespace
+
+} // manager namespace
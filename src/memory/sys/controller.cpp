@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include <log/record.hpp>
+#include <stat/statistics.hpp>
+
+#include "domain/domain.hpp"
+
+#include "controller.hpp"
+
+
+/**
+ *  @brief Balloon Controller Output
+ *
+ *  @param state:               domain's controller state between iterations
+ *  @param parameters:          controller gains and limits
+ *  @param domain memory extra: memory unused by domain
+ *  @param supply threshold:    unused memory above which domain supplies
+ *  @param demand threshold:    unused memory below which domain demands
+ *
+ *  @details Proportional-integral-derivative controller on the error between
+ *  the domain's unused memory and the middle of its headroom band, such that
+ *  a domain far outside the band moves in large steps and one just outside
+ *  moves in small steps, while a domain staying outside accumulates integral
+ *  action to ramp its step over consecutive iterations.
+ *
+ *  Windup is held back by clamping the integral, by not integrating while the
+ *  output is saturated at the maximum step, and by discarding the integral
+ *  once the error changes sign. The output magnitude is rate limited between
+ *  the minimum and maximum step.
+ *
+ *  @return memory change for domain; negative when domain loses memory
+ */
+std::double_t
+manager::controller::delta
+(
+          manager::controller::state_t      &state,
+    const manager::controller::parameters_t &parameters,
+          std::double_t                      domain_memory_extra,
+          std::double_t                      supply_threshold,
+          std::double_t                      demand_threshold
+) noexcept
+{
+    // Error relative to middle of headroom band; positive when domain has
+    // more unused memory than it should
+    const std::double_t setpoint = (supply_threshold + demand_threshold) / 2;
+    const std::double_t error    = domain_memory_extra - setpoint;
+
+    if (!state.primed)
+    {
+        state.previous_error = error;
+        state.primed = true;
+    }
+    ++state.ticks_outside_band;
+
+    // Integral from the other side of the band no longer applies
+    if (error * state.integral < 0)
+        state.integral = 0.0;
+
+    // Controller terms
+    const std::double_t integral = std::clamp
+    (
+        state.integral + error,
+        -parameters.integral_limit,
+        parameters.integral_limit
+    );
+    const std::double_t derivative = error - state.previous_error;
+
+    const std::double_t output
+        = parameters.proportional_gain * error
+        + parameters.integral_gain     * integral
+        + parameters.derivative_gain   * derivative;
+    std::double_t magnitude = std::abs(output);
+
+    // Only accumulate integral while output is not saturated
+    const std::double_t maximum_step
+        = static_cast<std::double_t>(parameters.maximum_step);
+    if (magnitude <= maximum_step)
+        state.integral = integral;
+    state.previous_error = error;
+
+    // Rate limit output
+    magnitude = std::clamp
+    (
+        magnitude,
+        static_cast<std::double_t>(parameters.minimum_step),
+        maximum_step
+    );
+
+    return output > 0 ? -magnitude : magnitude;
+}
+
+
+/**
+ *  @brief Balloon Controller Settler
+ *
+ *  @param state: domain's controller state between iterations
+ *  @param UUID:  domain's UUID
+ *
+ *  @details Resets controller state of a domain which is inside its headroom
+ *  band, recording how many iterations it took to converge into the band
+ */
+void
+manager::controller::settle
+(
+          manager::controller::state_t &state,
+    const libvirt::domain::uuid_t      &uuid
+) noexcept
+{
+    if (state.ticks_outside_band > 0)
+    {
+        util::log::record
+        (
+            "Domain " + uuid + " converged into headroom band after "
+                + std::to_string(state.ticks_outside_band) + " intervals"
+        );
+    }
+
+    state = manager::controller::state_t();
+}
+
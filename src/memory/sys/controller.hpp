@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+
+#include <stat/statistics.hpp>
+
+#include "domain/domain.hpp"
+
+
+/**
+ *  @brief Balloon Controller Header
+ *
+ *  @details Defines the feedback controller sizing each domain's memory change
+ *  from the distance of its unused memory to the scheduler's headroom band
+ */
+namespace manager
+{
+
+namespace controller
+{
+
+using status_code = std::uint8_t;
+
+// Tunables; steps and limits are in the same units as domain statistics
+typedef struct parameters_t
+{
+    bool                enabled           = true;
+    std::double_t       proportional_gain = 1.000;
+    std::double_t       integral_gain     = 0.500;
+    std::double_t       derivative_gain   = 0.000;
+    util::stat::slong_t minimum_step      = 20 << 10;
+    util::stat::slong_t maximum_step      = 1  << 20;
+    std::double_t       integral_limit    = 4  << 20;
+} parameters_t;
+
+// Per domain state kept between load balancer iterations
+typedef struct state_t
+{
+    std::double_t       integral           = 0.0;
+    std::double_t       previous_error     = 0.0;
+    bool                primed             = false;
+    util::stat::ulong_t ticks_outside_band = 0;
+} state_t;
+
+using table_t = std::unordered_map<libvirt::domain::uuid_t, state_t>;
+
+// Controller routines
+[[nodiscard("Must use controller output to call")]]
+std::double_t
+delta
+(
+          state_t       &state,
+    const parameters_t  &parameters,
+          std::double_t  domain_memory_extra,
+          std::double_t  supply_threshold,
+          std::double_t  demand_threshold
+) noexcept;
+
+void
+settle
+(
+          state_t                 &state,
+    const libvirt::domain::uuid_t &uuid
+) noexcept;
+
+} // controller namespace
+
+} // manager namespace
@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+#include <log/record.hpp>
+#include <metric/registry.hpp>
+#include <stat/statistics.hpp>
+
+#include "ksm/ksm.hpp"
+
+#include "deduplication.hpp"
+
+
+/**
+ *  @brief Deduplication Credit
+ *
+ *  @param state:      KSM counters to refresh
+ *  @param parameters: deduplication tunables
+ *
+ *  @details Guests' balloon sizes count merged pages once per guest, which
+ *  overstates what the host actually backs; the memory KSM saves is handed
+ *  back to the host budget, scaled by the credit fraction to leave margin
+ *  for merged pages being written to and split again. Unreadable counters
+ *  credit nothing.
+ *
+ *  @return memory credited to host in KiB
+ */
+util::stat::slong_t
+manager::deduplication::credit
+(
+          manager::deduplication::state_t      &state,
+    const manager::deduplication::parameters_t &parameters
+) noexcept
+{
+    state.sampled = false;
+    os::ksm::status_code status = os::ksm::read(parameters.root, state.datum);
+    if (static_cast<bool>(status))
+        return 0;
+
+    state.sampled = true;
+    if (state.datum.run == 0 && state.datum.pages_sharing == 0)
+        return 0;
+
+    return static_cast<util::stat::slong_t>
+    (
+        parameters.credit * os::ksm::savings(state.datum)
+    );
+}
+
+
+/**
+ *  @brief KSM Scan Rate Controller
+ *
+ *  @param state:           KSM counters of this iteration
+ *  @param parameters:      deduplication tunables
+ *  @param memory headroom: host memory left once demand is met
+ *  @param memory limit:    host memory
+ *
+ *  @details Doubles pages to scan while headroom is below the raise
+ *  threshold, so KSM finds more to merge when memory is short, and halves it
+ *  while headroom is above the lower threshold to save host CPU. Lowering
+ *  waits for a full scan at the current rate so merging it started is not
+ *  cut short. The rate stays within its bounds and is only written when it
+ *  changes.
+ *
+ *  @return execution status code
+ */
+manager::deduplication::status_code
+manager::deduplication::tune
+(
+          manager::deduplication::state_t      &state,
+    const manager::deduplication::parameters_t &parameters,
+          util::stat::slong_t                   memory_headroom,
+          util::stat::slong_t                   memory_limit
+) noexcept
+{
+    if (!parameters.tuning || !state.sampled || memory_limit <= 0)
+        return EXIT_SUCCESS;
+
+    // Adopt rate set outside of the controller
+    if (state.pages_to_scan == 0)
+    {
+        state.pages_to_scan = state.datum.pages_to_scan;
+        state.tuned_at_scan = state.datum.full_scans;
+    }
+
+    const std::double_t headroom 
+        = static_cast<std::double_t>(memory_headroom) / memory_limit;
+
+    util::stat::ulong_t pages_to_scan = state.pages_to_scan;
+    if (headroom < parameters.raise_headroom)
+        pages_to_scan *= 2;
+    else if (headroom > parameters.lower_headroom
+             && state.datum.full_scans > state.tuned_at_scan)
+        pages_to_scan /= 2;
+
+    pages_to_scan = std::clamp
+    (
+        pages_to_scan, 
+        parameters.minimum_pages_to_scan, 
+        parameters.maximum_pages_to_scan
+    );
+    if (pages_to_scan == state.datum.pages_to_scan)
+    {
+        state.pages_to_scan = pages_to_scan;
+        return EXIT_SUCCESS;
+    }
+
+    os::ksm::status_code status 
+        = os::ksm::pages_to_scan(parameters.root, pages_to_scan);
+    if (static_cast<bool>(status))
+        return EXIT_FAILURE;
+
+    util::log::record
+    (
+        "KSM pages to scan set from " 
+            + std::to_string(state.datum.pages_to_scan) + " to " 
+            + std::to_string(pages_to_scan)
+    );
+
+    state.pages_to_scan = pages_to_scan;
+    state.tuned_at_scan = state.datum.full_scans;
+
+    return EXIT_SUCCESS;
+}
+
+
+/**
+ *  @brief Deduplication Metric Exporter
+ *
+ *  @param state:    KSM counters of this iteration
+ *  @param registry: registry to publish metrics to
+ */
+void
+manager::deduplication::export_savings
+(
+    const manager::deduplication::state_t &state,
+          util::metric::registry_t        &registry
+) noexcept
+{
+    if (!state.sampled)
+        return;
+
+    util::metric::set
+    (
+        registry, "memoryman_ksm_savings_kib",
+        "Host memory saved by KSM in KiB", {},
+        static_cast<std::double_t>(os::ksm::savings(state.datum))
+    );
+    util::metric::set
+    (
+        registry, "memoryman_ksm_pages_to_scan",
+        "Pages KSM scans each time it wakes", {},
+        static_cast<std::double_t>(state.datum.pages_to_scan)
+    );
+    util::metric::set
+    (
+        registry, "memoryman_ksm_full_scans",
+        "Full scans KSM has completed", {},
+        static_cast<std::double_t>(state.datum.full_scans)
+    );
+}
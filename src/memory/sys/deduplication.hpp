@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+#include <metric/registry.hpp>
+#include <stat/statistics.hpp>
+
+#include "ksm/ksm.hpp"
+
+
+/**
+ *  @brief Memory Deduplication Header
+ *
+ *  @details Defines the accounting of host memory saved by KSM and the
+ *  controller steering how fast KSM scans for pages to merge
+ */
+namespace manager
+{
+
+namespace deduplication
+{
+
+using status_code = std::uint8_t;
+
+// Tunables; credit is the fraction of savings counted as host memory, and
+// headroom thresholds are fractions of host memory left once demand is met
+typedef struct parameters_t
+{
+    bool                enabled               = false;
+    std::string         root                  = "/sys/kernel/mm/ksm";
+    std::double_t       credit                = 1.000;
+    bool                tuning                = false;
+    util::stat::ulong_t minimum_pages_to_scan = 100;
+    util::stat::ulong_t maximum_pages_to_scan = 4000;
+    std::double_t       raise_headroom        = 0.100;
+    std::double_t       lower_headroom        = 0.300;
+} parameters_t;
+
+// KSM counters and scan rate kept between load balancer iterations
+typedef struct state_t
+{
+    os::ksm::datum_t    datum;
+    bool                sampled       = false;
+    util::stat::ulong_t tuned_at_scan = 0;
+    util::stat::ulong_t pages_to_scan = 0;
+} state_t;
+
+// Deduplication routines
+[[nodiscard("Must use memory credited to call")]]
+util::stat::slong_t
+credit
+(
+          state_t      &state,
+    const parameters_t &parameters
+) noexcept;
+
+[[nodiscard("KSM tuning status must be checked")]]
+status_code
+tune
+(
+          state_t             &state,
+    const parameters_t        &parameters,
+          util::stat::slong_t  memory_headroom,
+          util::stat::slong_t  memory_limit
+) noexcept;
+
+void
+export_savings
+(
+    const state_t                  &state,
+          util::metric::registry_t &registry
+) noexcept;
+
+} // deduplication namespace
+
+} // manager namespace
@@ -0,0 +1,200 @@
+#include <cmath>
+#include <cstddef>
+#include <deque>
+#include <string>
+
+#include <metric/registry.hpp>
+#include <stat/statistics.hpp>
+
+#include "domain/domain.hpp"
+
+#include "forecast.hpp"
+
+
+/**
+ *  @brief Statistic Trend Slope
+ *
+ *  @param history: samples of past intervals, oldest first
+ *  @param field:   statistic of samples to fit
+ *
+ *  @details Least squares fit of the statistic against interval number,
+ *  skipping intervals the guest did not report it
+ *
+ *  @return change of statistic per interval; zero when too few samples
+ */
+std::double_t
+static slope
+(
+    const std::deque<manager::forecast::sample_t> &history,
+          util::stat::slong_t manager::forecast::sample_t::*field
+) noexcept
+{
+    std::double_t count = 0, sum_x = 0, sum_y = 0, sum_xx = 0, sum_xy = 0;
+    for (std::size_t interval = 0; interval < history.size(); ++interval)
+    {
+        const util::stat::slong_t value = history[interval].*field;
+        if (value == libvirt::domain::memory_statistic_unreported)
+            continue;
+
+        const std::double_t x = static_cast<std::double_t>(interval);
+        const std::double_t y = static_cast<std::double_t>(value);
+        count  += 1;
+        sum_x  += x;
+        sum_y  += y;
+        sum_xx += x * x;
+        sum_xy += x * y;
+    }
+
+    const std::double_t denominator = count * sum_xx - sum_x * sum_x;
+    if (count < 2 || denominator == 0)
+        return 0.0;
+
+    return (count * sum_xy - sum_x * sum_y) / denominator;
+}
+
+
+/**
+ *  @brief Domain Memory Projection
+ *
+ *  @param state:      domain's trend from previous iterations
+ *  @param parameters: forecast tunables
+ *  @param datum:      domain's current statistics
+ *
+ *  @details Smooths unused memory with an exponentially weighted moving
+ *  average and extends it by the slope of its recent history to the horizon.
+ *
+ *  Memory use is declining when unused memory grows while usable memory does
+ *  not shrink and resident memory does not grow, for those the guest reports;
+ *  the decline is sustained once it has held for enough intervals.
+ *
+ *  Every projection is scored against the unused memory observed once the
+ *  horizon is reached.
+ *
+ *  @return projected unused memory and whether memory use is in decline
+ */
+manager::forecast::projection_t
+manager::forecast::project
+(
+          manager::forecast::state_t      &state,
+    const manager::forecast::parameters_t &parameters,
+    const libvirt::domain::datum_t        &datum
+) noexcept
+{
+    const std::double_t domain_memory_extra
+        = static_cast<std::double_t>(datum.domain_memory_extra);
+
+    // Record interval
+    state.history.push_back
+    (
+        {datum.domain_memory_extra, datum.memory_usable, datum.resident_memory}
+    );
+    while (state.history.size() > parameters.history)
+        state.history.pop_front();
+
+    state.smoothed_extra = state.history.size() == 1
+        ? domain_memory_extra
+        : parameters.smoothing * domain_memory_extra
+            + (1 - parameters.smoothing) * state.smoothed_extra;
+
+    // Score projection made horizon intervals ago
+    if (state.predictions.size() >= parameters.horizon)
+    {
+        const std::double_t error
+            = std::abs(state.predictions.front() - domain_memory_extra);
+        const std::double_t relative_error = datum.domain_memory_limit > 0
+            ? error / static_cast<std::double_t>(datum.domain_memory_limit)
+            : 0.0;
+        state.predictions.pop_front();
+
+        state.absolute_error = state.number_of_forecasts == 0
+            ? error
+            : parameters.smoothing * error
+                + (1 - parameters.smoothing) * state.absolute_error;
+        state.relative_error = state.number_of_forecasts == 0
+            ? relative_error
+            : parameters.smoothing * relative_error
+                + (1 - parameters.smoothing) * state.relative_error;
+        ++state.number_of_forecasts;
+    }
+
+    // Extend trend to horizon
+    using manager::forecast::sample_t;
+    const std::double_t extra_slope
+        = slope(state.history, &sample_t::domain_memory_extra);
+    const std::double_t usable_slope
+        = slope(state.history, &sample_t::memory_usable);
+    const std::double_t resident_slope
+        = slope(state.history, &sample_t::resident_memory);
+
+    manager::forecast::projection_t projection;
+    projection.domain_memory_extra = state.smoothed_extra
+        + extra_slope * static_cast<std::double_t>(parameters.horizon);
+    state.predictions.push_back(projection.domain_memory_extra);
+
+    // Track sustained decline in memory use
+    if (extra_slope > 0 && usable_slope >= 0 && resident_slope <= 0)
+        ++state.declining_intervals;
+    else
+        state.declining_intervals = 0;
+    projection.declining
+        = state.declining_intervals >= parameters.decline_intervals;
+
+    return projection;
+}
+
+
+/**
+ *  @brief Forecast Accuracy Exporter
+ *
+ *  @param table:      per domain trends
+ *  @param parameters: forecast tunables
+ *  @param registry:   metric registry to update
+ *
+ *  @details Publishes each domain's smoothed projection error at the current
+ *  horizon, such that the horizon can be tuned per host
+ */
+void
+manager::forecast::export_accuracy
+(
+    const manager::forecast::table_t      &table,
+    const manager::forecast::parameters_t &parameters,
+          util::metric::registry_t        &registry
+) noexcept
+{
+    util::metric::set
+    (
+        registry, "memoryman_forecast_horizon_intervals",
+        "Intervals ahead unused memory is projected", {},
+        static_cast<std::double_t>(parameters.horizon)
+    );
+
+    // Series of domains no longer running are dropped
+    util::metric::clear(registry, "memoryman_forecast_absolute_error_kib");
+    util::metric::clear(registry, "memoryman_forecast_relative_error");
+    util::metric::clear(registry, "memoryman_forecast_projections_scored");
+    for (const auto &[uuid, state]: table)
+    {
+        if (state.number_of_forecasts == 0)
+            continue;
+
+        const util::metric::labels_t labels = {{"domain", uuid}};
+        util::metric::set
+        (
+            registry, "memoryman_forecast_absolute_error_kib",
+            "Smoothed error of projected unused memory in KiB", labels,
+            state.absolute_error
+        );
+        util::metric::set
+        (
+            registry, "memoryman_forecast_relative_error",
+            "Smoothed error of projected unused memory over domain limit",
+            labels, state.relative_error
+        );
+        util::metric::set
+        (
+            registry, "memoryman_forecast_projections_scored",
+            "Projections scored against observed unused memory", labels,
+            static_cast<std::double_t>(state.number_of_forecasts)
+        );
+    }
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+
+#include <metric/registry.hpp>
+#include <stat/statistics.hpp>
+
+#include "domain/domain.hpp"
+
+
+/**
+ *  @brief Memory Forecast Header
+ *
+ *  @details Defines the per domain memory trend projecting unused memory a
+ *  few intervals ahead, such that domains trending out of their headroom band
+ *  are served before they leave it
+ */
+namespace manager
+{
+
+namespace forecast
+{
+
+// Tunables; history and horizon in load balancer intervals, smoothing is
+// the weight of the newest sample
+typedef struct parameters_t
+{
+    bool          enabled           = true;
+    std::size_t   history           = 8;
+    std::double_t smoothing         = 0.500;
+    std::size_t   horizon           = 3;
+    std::size_t   decline_intervals = 3;
+} parameters_t;
+
+// Memory statistics of a single interval
+typedef struct sample_t
+{
+    util::stat::slong_t domain_memory_extra;
+    util::stat::slong_t memory_usable;
+    util::stat::slong_t resident_memory;
+} sample_t;
+
+// Per domain trend kept between load balancer iterations; predictions are
+// of unused memory horizon intervals ahead, oldest first
+typedef struct state_t
+{
+    std::deque<sample_t>      history;
+    std::deque<std::double_t> predictions;
+    std::double_t             smoothed_extra      = 0.0;
+    std::size_t               declining_intervals = 0;
+    std::double_t             absolute_error      = 0.0;
+    std::double_t             relative_error      = 0.0;
+    std::uint64_t             number_of_forecasts = 0;
+} state_t;
+
+using table_t = std::unordered_map<libvirt::domain::uuid_t, state_t>;
+
+// Projected memory of a domain at the horizon
+typedef struct projection_t
+{
+    std::double_t domain_memory_extra = 0.0;
+    bool          declining           = false;
+} projection_t;
+
+// Forecast routines
+[[nodiscard("Must use memory projection to call")]]
+projection_t
+project
+(
+          state_t                  &state,
+    const parameters_t             &parameters,
+    const libvirt::domain::datum_t &datum
+) noexcept;
+
+void
+export_accuracy
+(
+    const table_t                  &table,
+    const parameters_t             &parameters,
+          util::metric::registry_t &registry
+) noexcept;
+
+} // forecast namespace
+
+} // manager namespace
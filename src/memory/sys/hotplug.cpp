@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+#include <log/record.hpp>
+#include <stat/statistics.hpp>
+
+#include "domain/domain.hpp"
+#include "hotplug/hotplug.hpp"
+
+#include "actuator.hpp"
+#include "hotplug.hpp"
+
+
+/**
+ *  @brief Virtio-mem Device Refresher
+ *
+ *  @param state:      domain's cached device
+ *  @param parameters: hotplug tunables
+ *  @param datum:      domain to discover device of
+ *  @param now:        time of this iteration
+ *
+ *  @details Rereads the domain's definition once the refresh period passes;
+ *  domains whose definition cannot be read are ballooned until then
+ */
+void
+manager::hotplug::refresh
+(
+          manager::hotplug::state_t             &state,
+    const manager::hotplug::parameters_t        &parameters,
+    const libvirt::domain::datum_t              &datum,
+    const std::chrono::steady_clock::time_point &now
+) noexcept
+{
+    if (state.loaded && now - state.loaded_at < parameters.refresh)
+        return;
+
+    state.loaded    = true;
+    state.loaded_at = now;
+
+    libvirt::status_code status
+        = libvirt::hotplug::discover(datum, state.device);
+    if (static_cast<bool>(status))
+    {
+        util::log::record
+        (
+            "Unable to discover domain " + datum.uuid + "'s virtio-mem device",
+            util::log::type::FLAG
+        );
+
+        state.device = libvirt::hotplug::device_t();
+    }
+}
+
+
+/**
+ *  @brief Hotplug Headroom
+ *
+ *  @param table:      UUID-to-device table
+ *  @param parameters: hotplug tunables
+ *  @param UUID:       domain to determine headroom of
+ *
+ *  @return memory domain's device can still plug beyond its maximum memory
+ */
+util::stat::slong_t
+manager::hotplug::headroom
+(
+    const manager::hotplug::table_t      &table,
+    const manager::hotplug::parameters_t &parameters,
+    const libvirt::domain::uuid_t        &uuid
+) noexcept
+{
+    if (!parameters.enabled)
+        return 0;
+
+    const manager::hotplug::table_t::const_iterator entry = table.find(uuid);
+    if (entry == table.end() || !entry->second.device.found)
+        return 0;
+
+    const libvirt::hotplug::device_t &device = entry->second.device;
+
+    return std::max<util::stat::slong_t>(device.size - device.requested, 0);
+}
+
+
+/**
+ *  @brief Actuator Router
+ *
+ *  @param table:      UUID-to-device table
+ *  @param parameters: hotplug tunables
+ *  @param requests:   memory targets to route
+ *
+ *  @details Moves a target to the domain's virtio-mem device when its change
+ *  is at least the threshold, or when it grows the domain past its maximum
+ *  memory, which the balloon cannot. Hotplugged changes are rounded toward
+ *  the current size to whole blocks of the device and targets are adjusted
+ *  to match; changes the device cannot carry stay with the balloon.
+ */
+void
+manager::hotplug::route
+(
+          manager::hotplug::table_t      &table,
+    const manager::hotplug::parameters_t &parameters,
+          manager::actuator::requests_t  &requests
+) noexcept
+{
+    if (!parameters.enabled)
+        return;
+
+    for (manager::actuator::request_t &request: requests)
+    {
+        const manager::hotplug::table_t::iterator entry
+            = table.find(request.datum->uuid);
+        if (entry == table.end() || !entry->second.device.found)
+            continue;
+
+        const libvirt::hotplug::device_t &device = entry->second.device;
+        const util::stat::slong_t change
+            = request.memory_chunk - request.datum->balloon_memory_used;
+        if (std::abs(change) < parameters.threshold
+            && request.memory_chunk <= request.datum->domain_memory_limit)
+            continue;
+
+        const util::stat::slong_t requested = libvirt::hotplug::align
+        (
+            device,
+            change < 0
+                ? device.requested + change + device.block - 1
+                : device.requested + change
+        );
+        if (requested == device.requested)
+            continue;
+
+        request.memory_chunk = request.datum->balloon_memory_used
+                             + requested - device.requested;
+        request.device       = &device;
+    }
+}
+
+
+/**
+ *  @brief Hotplug Commit
+ *
+ *  @param table:   UUID-to-device table
+ *  @param request: memory target applied successfully
+ *
+ *  @details Carries a hotplugged target into the cached device, so the next
+ *  target builds on it before the definition is reread
+ */
+void
+manager::hotplug::commit
+(
+          manager::hotplug::table_t     &table,
+    const manager::actuator::request_t  &request
+) noexcept
+{
+    if (request.device == nullptr)
+        return;
+
+    const manager::hotplug::table_t::iterator entry
+        = table.find(request.datum->uuid);
+    if (entry == table.end())
+        return;
+
+    entry->second.device.requested
+        += request.memory_chunk - request.datum->balloon_memory_used;
+}
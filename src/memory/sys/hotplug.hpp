@@ -0,0 +1,81 @@
+#pragma once
+
+#include <chrono>
+#include <unordered_map>
+
+#include <stat/statistics.hpp>
+
+#include "domain/domain.hpp"
+#include "hotplug/hotplug.hpp"
+
+#include "actuator.hpp"
+
+
+/**
+ *  @brief Memory Hotplug Routing Header
+ *
+ *  @details Defines the choice between ballooning and resizing a domain's
+ *  virtio-mem device: small changes are ballooned, while large changes and
+ *  growth past the domain's maximum memory are hotplugged
+ */
+namespace manager
+{
+
+namespace hotplug
+{
+
+// Tunables; changes of at least the threshold, in KiB, are hotplugged
+typedef struct parameters_t
+{
+    bool                 enabled   = false;
+    util::stat::slong_t  threshold = 1 << 20;
+    std::chrono::seconds refresh   = std::chrono::seconds(60);
+} parameters_t;
+
+// Per domain virtio-mem device cached between load balancer iterations
+typedef struct state_t
+{
+    libvirt::hotplug::device_t            device;
+    bool                                  loaded = false;
+    std::chrono::steady_clock::time_point loaded_at;
+} state_t;
+
+using table_t = std::unordered_map<libvirt::domain::uuid_t, state_t>;
+
+// Hotplug routing routines
+void
+refresh
+(
+          state_t                               &state,
+    const parameters_t                          &parameters,
+    const libvirt::domain::datum_t              &datum,
+    const std::chrono::steady_clock::time_point &now
+) noexcept;
+
+[[nodiscard("Must use memory hotplug can add to call")]]
+util::stat::slong_t
+headroom
+(
+    const table_t                 &table,
+    const parameters_t            &parameters,
+    const libvirt::domain::uuid_t &uuid
+) noexcept;
+
+void
+route
+(
+          table_t              &table,
+    const parameters_t         &parameters,
+          actuator::requests_t &requests
+) noexcept;
+
+void
+commit
+(
+          table_t             &table,
+    const actuator::request_t &request
+) noexcept;
+
+} // hotplug namespace
+
+} // manager namespace
@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <log/record.hpp>
+#include <metric/registry.hpp>
+#include <stat/statistics.hpp>
+
+#include "domain/domain.hpp"
+#include "hugepage/hugepage.hpp"
+
+#include "hugepage.hpp"
+
+
+/**
+ *  @brief Idle Pool Memory
+ *
+ *  @param state:      hugepage pools to refresh
+ *  @param parameters: hugepage pool tunables
+ *
+ *  @details Pages held in pools but not by any domain are memory the host
+ *  cannot hand to ballooned domains. Unreadable pools count nothing.
+ *
+ *  @return memory free in hugepage pools in KiB
+ */
+util::stat::slong_t
+manager::hugepage::idle
+(
+          manager::hugepage::state_t      &state,
+    const manager::hugepage::parameters_t &parameters
+) noexcept
+{
+    os::hugepage::status_code status
+        = os::hugepage::read(parameters.root, state.pools);
+    state.sampled = !static_cast<bool>(status);
+    if (!state.sampled)
+        return 0;
+
+    util::stat::slong_t memory_idle = 0;
+    for (const os::hugepage::pool_t &pool: state.pools)
+    {
+        memory_idle += static_cast<util::stat::slong_t>(pool.free)
+                     * pool.page_size;
+    }
+
+    return memory_idle;
+}
+
+
+/**
+ *  @brief Hugepage Reservation
+ *
+ *  @param demands:    hugepages held by running domains
+ *  @param parameters: hugepage pool tunables
+ *  @param datum:      hugepage backed domain
+ *
+ *  @details Hugepage backed guests have all of their memory backed by pool
+ *  pages from the moment they start
+ */
+void
+manager::hugepage::reserve
+(
+          manager::hugepage::demands_t    &demands,
+    const manager::hugepage::parameters_t &parameters,
+    const libvirt::domain::datum_t        &datum
+) noexcept
+{
+    manager::hugepage::demand_t demand;
+    demand.page_size = datum.hugepage_size > 0
+        ? datum.hugepage_size
+        : parameters.default_size;
+    if (demand.page_size <= 0 || datum.domain_memory_limit <= 0)
+        return;
+
+    demand.cells = datum.cells;
+    demand.pages = static_cast<util::stat::ulong_t>
+    (
+        (datum.domain_memory_limit + demand.page_size - 1) / demand.page_size
+    );
+    demands.push_back(std::move(demand));
+}
+
+
+/**
+ *  @brief Hugepage Pool Balancer
+ *
+ *  @param state:      hugepage pools read this iteration
+ *  @param parameters: hugepage pool tunables
+ *  @param demands:    hugepages held by running domains
+ *  @param registry:   registry to publish pool sizes in
+ *
+ *  @details Sizes each node's pool of the default page size, and of every
+ *  page size a domain is backed by, to the pages reserved on that node plus
+ *  the spare pages. A domain's pages are divided evenly between its NUMA
+ *  cells, or between all nodes with a pool of its page size when unplaced.
+ *  Pools never shrink below the pages in use, and pools of other sizes are
+ *  left as configured.
+ *
+ *  @return execution status code
+ */
+manager::hugepage::status_code
+manager::hugepage::balance
+(
+    const manager::hugepage::state_t      &state,
+    const manager::hugepage::parameters_t &parameters,
+    const manager::hugepage::demands_t    &demands,
+          util::metric::registry_t        &registry
+) noexcept
+{
+    if (!state.sampled)
+        return EXIT_FAILURE;
+
+    // Pages reserved by node and page size
+    using pool_key_t = std::pair<util::stat::sint_t, util::stat::slong_t>;
+    std::map<pool_key_t, util::stat::ulong_t> reserved;
+    std::set<util::stat::slong_t> managed_sizes = {parameters.default_size};
+    for (const manager::hugepage::demand_t &demand: demands)
+    {
+        managed_sizes.insert(demand.page_size);
+
+        std::vector<util::stat::sint_t> nodes;
+        for (const os::hugepage::pool_t &pool: state.pools)
+        {
+            if (pool.page_size == demand.page_size
+                && (demand.cells.empty()
+                    || demand.cells.count
+                       (
+                           static_cast<libvirt::hardware::cell_t>(pool.node)
+                       )))
+                nodes.push_back(pool.node);
+        }
+        if (nodes.empty())
+        {
+            util::log::record
+            (
+                "No hugepage pool of " + std::to_string(demand.page_size)
+                    + " KiB on domain's nodes",
+                util::log::type::FLAG
+            );
+
+            continue;
+        }
+
+        const util::stat::ulong_t share = demand.pages / nodes.size();
+        const util::stat::ulong_t rest  = demand.pages % nodes.size();
+        for (std::size_t index = 0; index < nodes.size(); ++index)
+        {
+            reserved[{nodes[index], demand.page_size}]
+                += share + (index < rest ? 1 : 0);
+        }
+    }
+
+    // Resize managed pools
+    manager::hugepage::status_code status = EXIT_SUCCESS;
+    for (const os::hugepage::pool_t &pool: state.pools)
+    {
+        if (!managed_sizes.count(pool.page_size))
+            continue;
+
+        const std::map<pool_key_t, util::stat::ulong_t>::const_iterator entry
+            = reserved.find({pool.node, pool.page_size});
+        const util::stat::ulong_t pages_used = pool.total - pool.free;
+        const util::stat::ulong_t pages = std::max
+        (
+            (entry == reserved.end() ? 0 : entry->second) + parameters.spare,
+            pages_used
+        );
+
+        util::metric::set
+        (
+            registry, "memoryman_hugepage_pool_pages",
+            "Hugepages pools are sized to",
+            {
+                {"node", std::to_string(pool.node)},
+                {"size", std::to_string(pool.page_size)}
+            },
+            static_cast<std::double_t>(pages)
+        );
+
+        if (pages == pool.total)
+            continue;
+
+        if (static_cast<bool>
+            (
+                os::hugepage::resize(parameters.root, pool, pages)
+            ))
+        {
+            status = EXIT_FAILURE;
+            continue;
+        }
+
+        util::metric::increment
+        (
+            registry, "memoryman_hugepage_pool_resizes_total",
+            "Hugepage pool resizes", {}
+        );
+    }
+
+    return status;
+}
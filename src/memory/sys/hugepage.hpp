@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <metric/registry.hpp>
+#include <stat/statistics.hpp>
+
+#include "domain/domain.hpp"
+#include "hugepage/hugepage.hpp"
+
+
+/**
+ *  @brief Hugepage Pool Controller Header
+ *
+ *  @details Defines the sizing of the host's hugepage pools to the hugepages
+ *  reserved by running hugepage backed domains, which are not ballooned
+ */
+namespace manager
+{
+
+namespace hugepage
+{
+
+using status_code = std::uint8_t;
+
+// Tunables; root is the NUMA node sysfs directory, default size in KiB backs
+// domains not naming a page size, and spare pages are kept free in each
+// managed pool for domains starting
+typedef struct parameters_t
+{
+    bool                enabled      = false;
+    std::string         root         = "/sys/devices/system/node";
+    util::stat::slong_t default_size = 2 << 10;
+    util::stat::ulong_t spare        = 0;
+} parameters_t;
+
+// Hugepage pools read this iteration
+typedef struct state_t
+{
+    os::hugepage::pools_t pools;
+    bool                  sampled = false;
+} state_t;
+
+// Hugepages a running domain holds on its nodes; page size in KiB
+typedef struct demand_t
+{
+    libvirt::domain::cell_set_t cells;
+    util::stat::slong_t         page_size = 0;
+    util::stat::ulong_t         pages     = 0;
+} demand_t;
+
+using demands_t = std::vector<demand_t>;
+
+// Hugepage pool routines
+[[nodiscard("Must use idle pool memory to call")]]
+util::stat::slong_t
+idle
+(
+          state_t      &state,
+    const parameters_t &parameters
+) noexcept;
+
+void
+reserve
+(
+          demands_t                &demands,
+    const parameters_t             &parameters,
+    const libvirt::domain::datum_t &datum
+) noexcept;
+
+[[nodiscard("Hugepage pool sizing status must be checked")]]
+status_code
+balance
+(
+    const state_t                  &state,
+    const parameters_t             &parameters,
+    const demands_t                &demands,
+          util::metric::registry_t &registry
+) noexcept;
+
+} // hugepage namespace
+
+} // manager namespace
@@ -0,0 +1,234 @@
+#include <chrono>
+#include <cmath>
+#include <string>
+
+#include <metric/registry.hpp>
+
+#include "domain/domain.hpp"
+
+#include "hysteresis.hpp"
+
+
+/**
+ *  @brief Phase Name
+ *
+ *  @param current: phase to name
+ *
+ *  @return phase name as exported in metric labels
+ */
+std::string
+static phase_name
+(
+    manager::hysteresis::phase current
+) noexcept
+{
+    switch (current)
+    {
+        case manager::hysteresis::phase::GROWING:
+            return "growing";
+        case manager::hysteresis::phase::SHRINKING:
+            return "shrinking";
+        case manager::hysteresis::phase::COOLDOWN:
+            return "cooldown";
+        default:
+            return "steady";
+    }
+}
+
+
+/**
+ *  @brief Dwell Check
+ *
+ *  @param state:  domain's phase
+ *  @param period: time domain must have spent in its phase
+ *  @param now:    time of this iteration
+ *
+ *  @details Domains not yet seen have no phase to dwell in
+ *
+ *  @return whether domain has spent the period in its phase
+ */
+bool
+static dwelled
+(
+    const manager::hysteresis::state_t          &state,
+    const std::chrono::seconds                  &period,
+    const std::chrono::steady_clock::time_point &now
+) noexcept
+{
+    return state.entered_at == std::chrono::steady_clock::time_point()
+        || now - state.entered_at >= period;
+}
+
+
+/**
+ *  @brief Phase Transition
+ *
+ *  @param state:    domain's phase
+ *  @param next:     phase to enter
+ *  @param now:      time of this iteration
+ *  @param registry: registry to count transitions in
+ */
+void
+static transition
+(
+          manager::hysteresis::state_t          &state,
+          manager::hysteresis::phase             next,
+    const std::chrono::steady_clock::time_point &now,
+          util::metric::registry_t              &registry
+) noexcept
+{
+    if (state.current == next)
+        return;
+
+    util::metric::increment
+    (
+        registry, "memoryman_hysteresis_transitions_total",
+        "Movement phase transitions of domains",
+        {{"from", phase_name(state.current)}, {"to", phase_name(next)}}
+    );
+
+    state.current    = next;
+    state.entered_at = now;
+}
+
+
+/**
+ *  @brief Hold Counter
+ *
+ *  @param state:    domain's phase
+ *  @param registry: registry to count held moves in
+ */
+void
+static hold
+(
+    const manager::hysteresis::state_t &state,
+          util::metric::registry_t     &registry
+) noexcept
+{
+    util::metric::increment
+    (
+        registry, "memoryman_hysteresis_held_total",
+        "Domain moves held back by dwell, cooldown or dead band",
+        {{"phase", phase_name(state.current)}}
+    );
+}
+
+
+/**
+ *  @brief Move Admission
+ *
+ *  @param state:      domain's phase
+ *  @param parameters: hysteresis tunables
+ *  @param wanted:     growing or shrinking, as domain's thresholds ask
+ *  @param margin:     how far domain is beyond the threshold it crossed
+ *  @param dead band:  margin needed to leave steady or cooldown, in the same
+ *                     units as domain statistics
+ *  @param now:        time of this iteration
+ *  @param registry:   registry to count transitions and held moves in
+ *
+ *  @details A domain keeps moving in the direction it is moving in. A domain
+ *  starts moving from steady only once it has dwelled there and is beyond the
+ *  dead band. A domain asked to reverse direction enters cooldown instead,
+ *  and leaves it the same way it leaves steady once the cooldown passes.
+ *  Disabled hysteresis admits every move, still counting transitions so the
+ *  churn it removes can be compared.
+ *
+ *  @return whether domain moves this iteration
+ */
+bool
+manager::hysteresis::admit
+(
+          manager::hysteresis::state_t          &state,
+    const manager::hysteresis::parameters_t     &parameters,
+          manager::hysteresis::phase             wanted,
+          std::double_t                          margin,
+          std::double_t                          dead_band,
+    const std::chrono::steady_clock::time_point &now,
+          util::metric::registry_t              &registry
+) noexcept
+{
+    if (!parameters.enabled || state.current == wanted)
+    {
+        transition(state, wanted, now, registry);
+        return true;
+    }
+
+    // Reversal waits out cooldown
+    if (state.current != manager::hysteresis::phase::STEADY
+        && state.current != manager::hysteresis::phase::COOLDOWN)
+    {
+        transition(state, manager::hysteresis::phase::COOLDOWN, now, registry);
+        hold(state, registry);
+
+        return false;
+    }
+
+    const std::chrono::seconds &period
+        = state.current == manager::hysteresis::phase::COOLDOWN
+        ? parameters.cooldown
+        : parameters.dwell;
+    if (!dwelled(state, period, now) || margin < dead_band)
+    {
+        hold(state, registry);
+        return false;
+    }
+
+    transition(state, wanted, now, registry);
+
+    return true;
+}
+
+
+/**
+ *  @brief Forced Move
+ *
+ *  @param state:    domain's phase
+ *  @param wanted:   growing or shrinking
+ *  @param now:      time of this iteration
+ *  @param registry: registry to count transitions in
+ *
+ *  @details Records a move the scheduler makes regardless of phase, such as
+ *  giving back memory above a domain's limit or feeding working set pressure
+ */
+void
+manager::hysteresis::force
+(
+          manager::hysteresis::state_t          &state,
+          manager::hysteresis::phase             wanted,
+    const std::chrono::steady_clock::time_point &now,
+          util::metric::registry_t              &registry
+) noexcept
+{
+    transition(state, wanted, now, registry);
+}
+
+
+/**
+ *  @brief Phase Settler
+ *
+ *  @param state:      domain's phase
+ *  @param parameters: hysteresis tunables
+ *  @param now:        time of this iteration
+ *  @param registry:   registry to count transitions in
+ *
+ *  @details Returns a domain within its headroom band to steady once it has
+ *  dwelled in its phase, or once its cooldown passes
+ */
+void
+manager::hysteresis::settle
+(
+          manager::hysteresis::state_t          &state,
+    const manager::hysteresis::parameters_t     &parameters,
+    const std::chrono::steady_clock::time_point &now,
+          util::metric::registry_t              &registry
+) noexcept
+{
+    const std::chrono::seconds &period
+        = state.current == manager::hysteresis::phase::COOLDOWN
+        ? parameters.cooldown
+        : parameters.dwell;
+    if (parameters.enabled && !dwelled(state, period, now))
+        return;
+
+    transition(state, manager::hysteresis::phase::STEADY, now, registry);
+}
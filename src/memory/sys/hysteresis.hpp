@@ -0,0 +1,89 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+
+#include <metric/registry.hpp>
+
+#include "domain/domain.hpp"
+
+
+/**
+ *  @brief Movement Hysteresis Header
+ *
+ *  @details Defines the per domain state machine keeping domains near the
+ *  supply and demand thresholds from flipping between supplier and demander
+ *  on consecutive iterations
+ */
+namespace manager
+{
+
+namespace hysteresis
+{
+
+// Direction a domain's memory is moving in
+enum class phase: std::uint8_t
+{
+    STEADY    = 0x00,
+    GROWING   = 0x01,
+    SHRINKING = 0x02,
+    COOLDOWN  = 0x03
+};
+
+// Tunables; a domain stays in a phase for at least the dwell, waits out the
+// cooldown before reversing, and leaves steady or cooldown only once beyond
+// a threshold by the dead band, as a fraction of its memory limit
+typedef struct parameters_t
+{
+    bool                 enabled   = true;
+    std::chrono::seconds dwell     = std::chrono::seconds(15);
+    std::chrono::seconds cooldown  = std::chrono::seconds(30);
+    std::double_t        dead_band = 0.020;
+} parameters_t;
+
+// Per domain phase kept between load balancer iterations
+typedef struct state_t
+{
+    phase                                 current = phase::STEADY;
+    std::chrono::steady_clock::time_point entered_at;
+} state_t;
+
+using table_t = std::unordered_map<libvirt::domain::uuid_t, state_t>;
+
+// Hysteresis routines
+[[nodiscard("Must use whether move was admitted to call")]]
+bool
+admit
+(
+          state_t                               &state,
+    const parameters_t                          &parameters,
+          phase                                  wanted,
+          std::double_t                          margin,
+          std::double_t                          dead_band,
+    const std::chrono::steady_clock::time_point &now,
+          util::metric::registry_t              &registry
+) noexcept;
+
+void
+force
+(
+          state_t                               &state,
+          phase                                  wanted,
+    const std::chrono::steady_clock::time_point &now,
+          util::metric::registry_t              &registry
+) noexcept;
+
+void
+settle
+(
+          state_t                               &state,
+    const parameters_t                          &parameters,
+    const std::chrono::steady_clock::time_point &now,
+          util::metric::registry_t              &registry
+) noexcept;
+
+} // hysteresis namespace
+
+} // manager namespace
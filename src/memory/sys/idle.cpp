@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+
+#include <metric/registry.hpp>
+#include <stat/statistics.hpp>
+
+#include "domain/domain.hpp"
+
+#include "idle.hpp"
+
+
+/**
+ *  @brief Idleness Observer
+ *
+ *  @param state:      domain's CPU time and idleness
+ *  @param parameters: idle tracking tunables
+ *  @param datum:      domain's current statistics
+ *  @param now:        time of this iteration
+ *  @param registry:   registry to count wakeups in
+ *
+ *  @details Derives the domain's utilisation per vCPU from the CPU time it
+ *  used since the last iteration. A domain below the threshold for the given
+ *  number of consecutive intervals is marked idle and its balloon size kept
+ *  to restore. The first interval above the threshold wakes it. Domains not
+ *  reporting CPU time are never idle.
+ */
+void
+manager::idle::observe
+(
+          manager::idle::state_t                &state,
+    const manager::idle::parameters_t           &parameters,
+    const libvirt::domain::datum_t              &datum,
+    const std::chrono::steady_clock::time_point &now,
+          util::metric::registry_t              &registry
+) noexcept
+{
+    if (datum.cpu_time < 0 || datum.number_of_vCPUs == 0)
+    {
+        state = manager::idle::state_t();
+        return;
+    }
+
+    const std::chrono::duration<std::double_t, std::nano> elapsed
+        = now - state.sampled_at;
+    if (!state.primed || elapsed.count() <= 0
+        || datum.cpu_time < state.cpu_time)
+    {
+        state.primed         = true;
+        state.sampled_at     = now;
+        state.cpu_time       = datum.cpu_time;
+        state.idle_intervals = 0;
+
+        return;
+    }
+
+    const std::double_t utilisation
+        = static_cast<std::double_t>(datum.cpu_time - state.cpu_time)
+        / elapsed.count()
+        / static_cast<std::double_t>(datum.number_of_vCPUs);
+    state.sampled_at = now;
+    state.cpu_time   = datum.cpu_time;
+
+    // Domain busy again wakes
+    if (utilisation >= parameters.threshold)
+    {
+        state.idle_intervals = 0;
+        if (state.idle)
+        {
+            state.idle = false;
+            util::metric::increment
+            (
+                registry, "memoryman_idle_wakeups_total",
+                "Idle domains woken by vCPU activity", {}
+            );
+        }
+
+        return;
+    }
+
+    ++state.idle_intervals;
+    if (!state.idle && state.idle_intervals >= parameters.intervals)
+    {
+        state.idle          = true;
+        state.memory_before = std::max
+        (
+            state.memory_before, datum.balloon_memory_used
+        );
+    }
+}
+
+
+/**
+ *  @brief Idle Reclaim Floor
+ *
+ *  @param parameters: idle tracking tunables
+ *  @param datum:      idle domain
+ *
+ *  @return memory an idle domain is reclaimed down to
+ */
+util::stat::slong_t
+manager::idle::reclaim_floor
+(
+    const manager::idle::parameters_t &parameters,
+    const libvirt::domain::datum_t    &datum
+) noexcept
+{
+    return static_cast<util::stat::slong_t>
+    (
+        parameters.floor * static_cast<std::double_t>(datum.domain_memory_limit)
+    );
+}
+
+
+/**
+ *  @brief Idle Domain Exporter
+ *
+ *  @param table:    UUID-to-idleness table
+ *  @param registry: registry to publish idle domains in
+ */
+void
+manager::idle::export_idle
+(
+    const manager::idle::table_t   &table,
+          util::metric::registry_t &registry
+) noexcept
+{
+    const std::ptrdiff_t number_of_idle = std::count_if
+    (
+        table.begin(), table.end(),
+        [](const auto &entry) { return entry.second.idle; }
+    );
+
+    util::metric::set
+    (
+        registry, "memoryman_idle_domains",
+        "Domains idle long enough to be deeply reclaimed", {},
+        static_cast<std::double_t>(number_of_idle)
+    );
+}
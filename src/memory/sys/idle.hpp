@@ -0,0 +1,80 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <unordered_map>
+
+#include <metric/registry.hpp>
+#include <stat/statistics.hpp>
+
+#include "domain/domain.hpp"
+
+
+/**
+ *  @brief Idle Domain Header
+ *
+ *  @details Defines the per domain tracking of vCPU utilisation from CPU time
+ *  deltas, marking domains idle for long enough as deep reclaim targets
+ */
+namespace manager
+{
+
+namespace idle
+{
+
+// Tunables; threshold is the utilisation per vCPU below which an interval is
+// idle, floor the fraction of its limit an idle domain is reclaimed down to,
+// and step the most reclaimed from it each iteration in KiB
+typedef struct parameters_t
+{
+    bool                enabled   = false;
+    std::double_t       threshold = 0.010;
+    util::stat::ulong_t intervals = 12;
+    std::double_t       floor     = 0.250;
+    util::stat::slong_t step      = 512 << 10;
+} parameters_t;
+
+// Per domain CPU time and idleness kept between load balancer iterations;
+// memory before reclaim is the balloon size to restore on waking, kept until
+// the balloon has grown back to it
+typedef struct state_t
+{
+    bool                                  primed         = false;
+    std::chrono::steady_clock::time_point sampled_at;
+    util::stat::slong_t                   cpu_time       = 0;
+    util::stat::ulong_t                   idle_intervals = 0;
+    bool                                  idle           = false;
+    util::stat::slong_t                   memory_before  = 0;
+} state_t;
+
+using table_t = std::unordered_map<libvirt::domain::uuid_t, state_t>;
+
+// Idle tracking routines
+void
+observe
+(
+          state_t                               &state,
+    const parameters_t                          &parameters,
+    const libvirt::domain::datum_t              &datum,
+    const std::chrono::steady_clock::time_point &now,
+          util::metric::registry_t              &registry
+) noexcept;
+
+[[nodiscard("Must use idle floor to call")]]
+util::stat::slong_t
+reclaim_floor
+(
+    const parameters_t             &parameters,
+    const libvirt::domain::datum_t &datum
+) noexcept;
+
+void
+export_idle
+(
+    const table_t                  &table,
+          util::metric::registry_t &registry
+) noexcept;
+
+} // idle namespace
+
+} // manager namespace
@@ -0,0 +1,1071 @@
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+#include <conf/config.hpp>
+#include <log/record.hpp>
+#include <stat/statistics.hpp>
+#include <task/pool.hpp>
+
+#include "attribute/attribute.hpp"
+#include "psi/psi.hpp"
+
+#include "backstop.hpp"
+#include "balloon.hpp"
+#include "collector.hpp"
+#include "compaction.hpp"
+#include "controller.hpp"
+#include "deduplication.hpp"
+#include "forecast.hpp"
+#include "hotplug.hpp"
+#include "hugepage.hpp"
+#include "hysteresis.hpp"
+#include "idle.hpp"
+#include "pressure.hpp"
+#include "reservation.hpp"
+#include "sampler.hpp"
+#include "swap.hpp"
+#include "tuner.hpp"
+
+#include "policy.hpp"
+
+
+/**
+ *  @brief Memory Policy Configurer
+ *
+ *  @param configuration: table of configured tunables
+ *  @param policy:        structure reference to write to
+ *
+ *  @details Overrides default tunables with those present in configuration
+ *
+ *  @return execution status code
+ */
+manager::status_code
+manager::configure
+(
+    const util::conf::table_t &configuration,
+          manager::policy_t   &policy
+) noexcept
+{
+    using util::conf::value;
+
+    // Balloon controller
+    manager::controller::parameters_t &controller = policy.controller;
+    controller.enabled = value
+    (
+        configuration, "controller.enabled",
+        controller.enabled
+    );
+    controller.proportional_gain = value
+    (
+        configuration, "controller.proportional_gain",
+        controller.proportional_gain
+    );
+    controller.integral_gain = value
+    (
+        configuration, "controller.integral_gain",
+        controller.integral_gain
+    );
+    controller.derivative_gain = value
+    (
+        configuration, "controller.derivative_gain",
+        controller.derivative_gain
+    );
+    controller.minimum_step = value
+    (
+        configuration, "controller.minimum_step",
+        controller.minimum_step
+    );
+    controller.maximum_step = value
+    (
+        configuration, "controller.maximum_step",
+        controller.maximum_step
+    );
+    controller.integral_limit = value
+    (
+        configuration, "controller.integral_limit",
+        controller.integral_limit
+    );
+    if (controller.minimum_step < 0
+        || controller.maximum_step < controller.minimum_step)
+    {
+        util::log::record
+        (
+            "Balloon controller steps must satisfy "
+            "0 <= minimum_step <= maximum_step",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Working set pressure score
+    manager::pressure::parameters_t &pressure = policy.pressure;
+    pressure.enabled = value
+    (
+        configuration, "pressure.enabled",
+        pressure.enabled
+    );
+    pressure.major_fault_weight = value
+    (
+        configuration, "pressure.major_fault_weight",
+        pressure.major_fault_weight
+    );
+    pressure.swap_weight = value
+    (
+        configuration, "pressure.swap_weight",
+        pressure.swap_weight
+    );
+    pressure.usable_weight = value
+    (
+        configuration, "pressure.usable_weight",
+        pressure.usable_weight
+    );
+    pressure.major_fault_rate_scale = value
+    (
+        configuration, "pressure.major_fault_rate_scale",
+        pressure.major_fault_rate_scale
+    );
+    pressure.swap_rate_scale = value
+    (
+        configuration, "pressure.swap_rate_scale",
+        pressure.swap_rate_scale
+    );
+    pressure.demand_score = value
+    (
+        configuration, "pressure.demand_score",
+        pressure.demand_score
+    );
+    if (pressure.major_fault_rate_scale <= 0 || pressure.swap_rate_scale <= 0)
+    {
+        util::log::record
+        (
+            "Pressure score rate scales must be positive",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Memory trend forecast
+    manager::forecast::parameters_t &forecast = policy.forecast;
+    forecast.enabled = value
+    (
+        configuration, "forecast.enabled",
+        forecast.enabled
+    );
+    forecast.history = value
+    (
+        configuration, "forecast.history",
+        forecast.history
+    );
+    forecast.smoothing = value
+    (
+        configuration, "forecast.smoothing",
+        forecast.smoothing
+    );
+    forecast.horizon = value
+    (
+        configuration, "forecast.horizon",
+        forecast.horizon
+    );
+    forecast.decline_intervals = value
+    (
+        configuration, "forecast.decline_intervals",
+        forecast.decline_intervals
+    );
+    if (forecast.history < 2 || forecast.horizon == 0
+        || forecast.smoothing <= 0 || forecast.smoothing > 1)
+    {
+        util::log::record
+        (
+            "Forecast must satisfy history >= 2, horizon >= 1 and "
+            "0 < smoothing <= 1",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Movement coefficients of each priority class; configured ones are used
+    // as is unless tuned from the outcomes of reclaims and grants
+    manager::tuner::parameters_t &tuner = policy.tuner;
+    tuner.enabled = value
+    (
+        configuration, "tuner.enabled",
+        tuner.enabled
+    );
+    tuner.coefficients.supply = value
+    (
+        configuration, "tuner.supply",
+        tuner.coefficients.supply
+    );
+    tuner.lower.supply = value
+    (
+        configuration, "tuner.supply_lower",
+        tuner.lower.supply
+    );
+    tuner.upper.supply = value
+    (
+        configuration, "tuner.supply_upper",
+        tuner.upper.supply
+    );
+    tuner.coefficients.demand = value
+    (
+        configuration, "tuner.demand",
+        tuner.coefficients.demand
+    );
+    tuner.lower.demand = value
+    (
+        configuration, "tuner.demand_lower",
+        tuner.lower.demand
+    );
+    tuner.upper.demand = value
+    (
+        configuration, "tuner.demand_upper",
+        tuner.upper.demand
+    );
+    tuner.coefficients.change = value
+    (
+        configuration, "tuner.change",
+        tuner.coefficients.change
+    );
+    tuner.lower.change = value
+    (
+        configuration, "tuner.change_lower",
+        tuner.lower.change
+    );
+    tuner.upper.change = value
+    (
+        configuration, "tuner.change_upper",
+        tuner.upper.change
+    );
+    tuner.step = value
+    (
+        configuration, "tuner.step",
+        tuner.step
+    );
+    tuner.gap = value
+    (
+        configuration, "tuner.gap",
+        tuner.gap
+    );
+    tuner.settle = std::chrono::seconds
+    (
+        value
+        (
+            configuration, "tuner.settle",
+            tuner.settle.count()
+        )
+    );
+    tuner.window = value
+    (
+        configuration, "tuner.window",
+        tuner.window
+    );
+    tuner.target = value
+    (
+        configuration, "tuner.target",
+        tuner.target
+    );
+    const manager::tuner::coefficients_t &coefficients = tuner.coefficients;
+    if (tuner.lower.supply <= 0 || tuner.upper.supply >= 1
+        || tuner.lower.demand <= 0 || tuner.upper.demand >= 1
+        || tuner.lower.change <= 0
+        || coefficients.supply < tuner.lower.supply
+        || coefficients.supply > tuner.upper.supply
+        || coefficients.demand < tuner.lower.demand
+        || coefficients.demand > tuner.upper.demand
+        || coefficients.change < tuner.lower.change
+        || coefficients.change > tuner.upper.change
+        || coefficients.demand + tuner.gap > coefficients.supply)
+    {
+        util::log::record
+        (
+            "Movement coefficients must lie within their bounds, which lie "
+            "within (0, 1), with supply above demand by the gap",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+    if (tuner.step <= 0 || tuner.gap < 0 || tuner.settle.count() < 0
+        || tuner.window == 0 || tuner.target <= 0 || tuner.target >= 1)
+    {
+        util::log::record
+        (
+            "Coefficient tuning needs a positive step and window, a "
+            "non-negative gap and settle time, and a target within (0, 1)",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Movement phases against supplier and demander flapping
+    manager::hysteresis::parameters_t &hysteresis = policy.hysteresis;
+    hysteresis.enabled = value
+    (
+        configuration, "hysteresis.enabled",
+        hysteresis.enabled
+    );
+    hysteresis.dwell = std::chrono::seconds
+    (
+        value
+        (
+            configuration, "hysteresis.dwell",
+            hysteresis.dwell.count()
+        )
+    );
+    hysteresis.cooldown = std::chrono::seconds
+    (
+        value
+        (
+            configuration, "hysteresis.cooldown",
+            hysteresis.cooldown.count()
+        )
+    );
+    hysteresis.dead_band = value
+    (
+        configuration, "hysteresis.dead_band",
+        hysteresis.dead_band
+    );
+    if (hysteresis.dwell.count() < 0 || hysteresis.cooldown.count() < 0
+        || hysteresis.dead_band < 0 || hysteresis.dead_band >= 1)
+    {
+        util::log::record
+        (
+            "Hysteresis dwell and cooldown must not be negative and dead band "
+            "must be within [0, 1)",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Balloon response tracking
+    manager::balloon::parameters_t &balloon = policy.balloon;
+    balloon.enabled = value
+    (
+        configuration, "balloon.enabled",
+        balloon.enabled
+    );
+    balloon.tolerance = value
+    (
+        configuration, "balloon.tolerance",
+        balloon.tolerance
+    );
+    balloon.completion = value
+    (
+        configuration, "balloon.completion",
+        balloon.completion
+    );
+    balloon.timeout = std::chrono::seconds
+    (
+        value
+        (
+            configuration, "balloon.timeout",
+            balloon.timeout.count()
+        )
+    );
+    balloon.smoothing = value
+    (
+        configuration, "balloon.smoothing",
+        balloon.smoothing
+    );
+    if (balloon.tolerance < 0 || balloon.completion <= 0 
+        || balloon.completion > 1 || balloon.timeout.count() <= 0
+        || balloon.smoothing <= 0 || balloon.smoothing > 1)
+    {
+        util::log::record
+        (
+            "Balloon tracking must satisfy tolerance >= 0, completion and "
+            "smoothing within (0, 1], and a positive timeout",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Host side bounds of domains whose balloons stall, which only balloon
+    // tracking detects
+    manager::backstop::parameters_t &backstop = policy.backstop;
+    backstop.enabled = value
+    (
+        configuration, "backstop.enabled",
+        backstop.enabled
+    );
+    backstop.root = value
+    (
+        configuration, "backstop.root",
+        backstop.root
+    );
+    backstop.slice = value
+    (
+        configuration, "backstop.slice",
+        backstop.slice
+    );
+    backstop.overhead = value
+    (
+        configuration, "backstop.overhead",
+        backstop.overhead
+    );
+    backstop.margin = value
+    (
+        configuration, "backstop.margin",
+        backstop.margin
+    );
+    if (backstop.overhead < 0 || backstop.margin < 0
+        || (backstop.enabled && !balloon.enabled))
+    {
+        util::log::record
+        (
+            "Backstop needs balloon tracking, and a non-negative overhead "
+            "and margin",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Deep reclaim of domains with idle vCPUs, whose CPU time is read along
+    // with other attributes
+    manager::idle::parameters_t &idle = policy.idle;
+    idle.enabled = value
+    (
+        configuration, "idle.enabled",
+        idle.enabled
+    );
+    idle.threshold = value
+    (
+        configuration, "idle.threshold",
+        idle.threshold
+    );
+    idle.intervals = value
+    (
+        configuration, "idle.intervals",
+        idle.intervals
+    );
+    idle.floor = value
+    (
+        configuration, "idle.floor",
+        idle.floor
+    );
+    idle.step = value
+    (
+        configuration, "idle.step",
+        idle.step
+    );
+    if (idle.threshold < 0 || idle.intervals == 0 || idle.floor < 0 
+        || idle.floor > 1 || idle.step <= 0)
+    {
+        util::log::record
+        (
+            "Idle reclaim must satisfy threshold >= 0, intervals >= 1, floor "
+            "within [0, 1] and a positive step",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+    policy.attributes.cpu_time = idle.enabled;
+
+    // Per domain reservations and priority classes
+    manager::reservation::parameters_t &reservation = policy.reservation;
+    reservation.enabled = value
+    (
+        configuration, "reservation.enabled",
+        reservation.enabled
+    );
+    reservation.metadata_uri = value
+    (
+        configuration, "reservation.metadata_uri",
+        reservation.metadata_uri
+    );
+    reservation.refresh = std::chrono::seconds
+    (
+        value
+        (
+            configuration, "reservation.refresh",
+            reservation.refresh.count()
+        )
+    );
+    reservation.latency_critical_weight = value
+    (
+        configuration, "reservation.latency_critical_weight",
+        reservation.latency_critical_weight
+    );
+    reservation.guaranteed_weight = value
+    (
+        configuration, "reservation.guaranteed_weight",
+        reservation.guaranteed_weight
+    );
+    reservation.best_effort_weight = value
+    (
+        configuration, "reservation.best_effort_weight",
+        reservation.best_effort_weight
+    );
+    const std::string default_class = value
+    (
+        configuration, "reservation.default_class",
+        std::string("best-effort")
+    );
+    if (!manager::reservation::parse(default_class, reservation.default_class)
+        || reservation.latency_critical_weight <= 0
+        || reservation.guaranteed_weight       <= 0
+        || reservation.best_effort_weight      <= 0)
+    {
+        util::log::record
+        (
+            "Reservation default class must be latency-critical, guaranteed "
+            "or best-effort and class weights must be positive",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Domains configured as domain.<UUID>.<class|reservation|limit>
+    for (const auto &[key, setting]: configuration)
+    {
+        const std::string prefix = "domain.";
+        const std::size_t separator = key.rfind('.');
+        if (key.rfind(prefix, 0) != 0 || separator < prefix.size() + 1)
+            continue;
+
+        const std::string uuid
+            = key.substr(prefix.size(), separator - prefix.size());
+        const std::string field = key.substr(separator + 1);
+
+        // Domains not given a class fall in the default one
+        const auto [entry, inserted] = reservation.overrides.try_emplace(uuid);
+        manager::reservation::reservation_t &domain = entry->second;
+        if (inserted)
+            domain.priority_class = reservation.default_class;
+
+        bool valid = true;
+        if (field == "class")
+            valid = manager::reservation::parse(setting, domain.priority_class);
+        else if (field == "reservation")
+        {
+            domain.reservation = value
+            (
+                configuration, key,
+                static_cast<util::stat::slong_t>(-1)
+            );
+        }
+        else if (field == "limit")
+        {
+            domain.limit = value
+            (
+                configuration, key,
+                static_cast<util::stat::slong_t>(-1)
+            );
+        }
+        else
+            valid = false;
+
+        if (!valid || domain.reservation < 0 || domain.limit < 0)
+        {
+            util::log::record
+            (
+                "Invalid domain reservation setting " + key + " = " + setting,
+                util::log::type::ERROR
+            );
+
+            return EXIT_FAILURE;
+        }
+    }
+    for (const auto &[uuid, domain]: reservation.overrides)
+    {
+        if (domain.limit > 0 && domain.reservation > domain.limit)
+        {
+            util::log::record
+            (
+                "Reservation of domain " + uuid + " exceeds its limit",
+                util::log::type::ERROR
+            );
+
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Host memory pressure watcher and emergency reclaim
+    os::psi::parameters_t &psi = policy.psi;
+    psi.enabled = value
+    (
+        configuration, "psi.enabled",
+        psi.enabled
+    );
+    psi.path = value
+    (
+        configuration, "psi.path",
+        psi.path
+    );
+    psi.stall_threshold = value
+    (
+        configuration, "psi.stall_threshold",
+        psi.stall_threshold
+    );
+    psi.window = value
+    (
+        configuration, "psi.window",
+        psi.window
+    );
+    psi.average_threshold = value
+    (
+        configuration, "psi.average_threshold",
+        psi.average_threshold
+    );
+    psi.poll_period = std::chrono::milliseconds
+    (
+        value
+        (
+            configuration, "psi.poll_period",
+            psi.poll_period.count()
+        )
+    );
+    psi.cooldown = std::chrono::milliseconds
+    (
+        value
+        (
+            configuration, "psi.cooldown",
+            psi.cooldown.count()
+        )
+    );
+    policy.emergency_suppliers = value
+    (
+        configuration, "psi.emergency_suppliers",
+        policy.emergency_suppliers
+    );
+    if (psi.stall_threshold == 0 || psi.stall_threshold > psi.window
+        || psi.poll_period.count() <= 0)
+    {
+        util::log::record
+        (
+            "PSI trigger must satisfy 0 < stall_threshold <= window and "
+            "poll period must be positive",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Statistics sampling apart from load balancer
+    manager::sampler::parameters_t &sampling = policy.sampling;
+    sampling.enabled = value
+    (
+        configuration, "sampling.enabled",
+        sampling.enabled
+    );
+    sampling.period = std::chrono::milliseconds
+    (
+        value
+        (
+            configuration, "sampling.period",
+            sampling.period.count()
+        )
+    );
+    sampling.window = value
+    (
+        configuration, "sampling.window",
+        sampling.window
+    );
+    sampling.stats_period = std::chrono::seconds
+    (
+        value
+        (
+            configuration, "sampling.stats_period",
+            sampling.stats_period.count()
+        )
+    );
+    const std::string statistic = value
+    (
+        configuration, "sampling.statistic",
+        std::string("minimum")
+    );
+    if (!manager::sampler::parse(statistic, sampling.statistic)
+        || sampling.period.count() <= 0 || sampling.window == 0
+        || sampling.stats_period.count() < 0)
+    {
+        util::log::record
+        (
+            "Sampling statistic must be minimum, mean or maximum, period "
+            "and window must be positive, and stats period must not be "
+            "negative",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Domain attributes cached between iterations; a refresh of zero
+    // refetches them every iteration
+    libvirt::attribute::parameters_t &attributes = policy.attributes;
+    attributes.enabled = value
+    (
+        configuration, "attributes.enabled",
+        attributes.enabled
+    );
+    attributes.refresh = value
+    (
+        configuration, "attributes.refresh",
+        attributes.refresh
+    );
+    attributes.events = value
+    (
+        configuration, "attributes.events",
+        attributes.events
+    );
+
+    // KSM accounting and scan rate
+    manager::deduplication::parameters_t &deduplication 
+        = policy.deduplication;
+    deduplication.enabled = value
+    (
+        configuration, "ksm.enabled",
+        deduplication.enabled
+    );
+    deduplication.root = value
+    (
+        configuration, "ksm.root",
+        deduplication.root
+    );
+    deduplication.credit = value
+    (
+        configuration, "ksm.credit",
+        deduplication.credit
+    );
+    deduplication.tuning = value
+    (
+        configuration, "ksm.tuning",
+        deduplication.tuning
+    );
+    deduplication.minimum_pages_to_scan = value
+    (
+        configuration, "ksm.minimum_pages_to_scan",
+        deduplication.minimum_pages_to_scan
+    );
+    deduplication.maximum_pages_to_scan = value
+    (
+        configuration, "ksm.maximum_pages_to_scan",
+        deduplication.maximum_pages_to_scan
+    );
+    deduplication.raise_headroom = value
+    (
+        configuration, "ksm.raise_headroom",
+        deduplication.raise_headroom
+    );
+    deduplication.lower_headroom = value
+    (
+        configuration, "ksm.lower_headroom",
+        deduplication.lower_headroom
+    );
+    if (deduplication.credit < 0 || deduplication.credit > 1)
+    {
+        util::log::record
+        (
+            "KSM credit must be within [0, 1]",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+    if (deduplication.minimum_pages_to_scan == 0
+        || deduplication.minimum_pages_to_scan 
+           > deduplication.maximum_pages_to_scan
+        || deduplication.raise_headroom > deduplication.lower_headroom)
+    {
+        util::log::record
+        (
+            "KSM tuning must satisfy 0 < minimum_pages_to_scan <= "
+            "maximum_pages_to_scan and raise_headroom <= lower_headroom",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Host swap accounting and grant hold
+    manager::swap::parameters_t &swap = policy.swap;
+    swap.enabled = value
+    (
+        configuration, "swap.enabled",
+        swap.enabled
+    );
+    swap.meminfo_path = value
+    (
+        configuration, "swap.meminfo_path",
+        swap.meminfo_path
+    );
+    swap.vmstat_path = value
+    (
+        configuration, "swap.vmstat_path",
+        swap.vmstat_path
+    );
+    swap.debit = value
+    (
+        configuration, "swap.debit",
+        swap.debit
+    );
+    swap.swap_in_threshold = value
+    (
+        configuration, "swap.swap_in_threshold",
+        swap.swap_in_threshold
+    );
+    if (swap.debit < 0 || swap.debit > 1 || swap.swap_in_threshold < 0)
+    {
+        util::log::record
+        (
+            "Swap debit must be within [0, 1] and swap in threshold must not "
+            "be negative",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Virtio-mem hotplug of large changes
+    manager::hotplug::parameters_t &hotplug = policy.hotplug;
+    hotplug.enabled = value
+    (
+        configuration, "hotplug.enabled",
+        hotplug.enabled
+    );
+    hotplug.threshold = value
+    (
+        configuration, "hotplug.threshold",
+        hotplug.threshold
+    );
+    hotplug.refresh = std::chrono::seconds
+    (
+        value
+        (
+            configuration, "hotplug.refresh",
+            hotplug.refresh.count()
+        )
+    );
+    if (hotplug.threshold < 0 || hotplug.refresh.count() < 0)
+    {
+        util::log::record
+        (
+            "Hotplug threshold and refresh period must not be negative",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Hugepage pools of hugepage backed domains, which are read from domain
+    // definitions along with other attributes
+    manager::hugepage::parameters_t &hugepage = policy.hugepage;
+    hugepage.enabled = value
+    (
+        configuration, "hugepage.enabled",
+        hugepage.enabled
+    );
+    hugepage.root = value
+    (
+        configuration, "hugepage.root",
+        hugepage.root
+    );
+    hugepage.default_size = value
+    (
+        configuration, "hugepage.default_size",
+        hugepage.default_size
+    );
+    hugepage.spare = value
+    (
+        configuration, "hugepage.spare",
+        hugepage.spare
+    );
+    if (hugepage.default_size <= 0)
+    {
+        util::log::record
+        (
+            "Default hugepage size must be positive",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+    policy.attributes.memory_backing = hugepage.enabled;
+
+    // Proactive compaction of nodes short of high-order blocks
+    manager::compaction::parameters_t &compaction = policy.compaction;
+    compaction.enabled = value
+    (
+        configuration, "compaction.enabled",
+        compaction.enabled
+    );
+    compaction.buddyinfo = value
+    (
+        configuration, "compaction.buddyinfo",
+        compaction.buddyinfo
+    );
+    compaction.root = value
+    (
+        configuration, "compaction.root",
+        compaction.root
+    );
+    compaction.fallback = value
+    (
+        configuration, "compaction.fallback",
+        compaction.fallback
+    );
+    compaction.order = value
+    (
+        configuration, "compaction.order",
+        compaction.order
+    );
+    compaction.threshold = value
+    (
+        configuration, "compaction.threshold",
+        compaction.threshold
+    );
+    compaction.interval = std::chrono::seconds
+    (
+        value
+        (
+            configuration, "compaction.interval",
+            compaction.interval.count()
+        )
+    );
+    compaction.timeout = std::chrono::milliseconds
+    (
+        value
+        (
+            configuration, "compaction.timeout",
+            compaction.timeout.count()
+        )
+    );
+    if (compaction.order == 0 || compaction.threshold < 0
+        || compaction.threshold > 1 || compaction.interval.count() < 0
+        || compaction.timeout.count() <= 0)
+    {
+        util::log::record
+        (
+            "Compaction needs a positive order and timeout, a threshold "
+            "within [0, 1] and a non-negative interval",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Fraction of guest disk caches counted as reclaimable
+    policy.cache_fraction = value
+    (
+        configuration, "reclaim.cache_fraction",
+        policy.cache_fraction
+    );
+    if (policy.cache_fraction < 0 || policy.cache_fraction > 1)
+    {
+        util::log::record
+        (
+            "Reclaimable cache fraction must be within [0, 1]",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Per NUMA node budgeting
+    policy.numa_enabled = value
+    (
+        configuration, "numa.enabled",
+        policy.numa_enabled
+    );
+    policy.numa_cell_reserve = value
+    (
+        configuration, "numa.cell_reserve",
+        policy.numa_cell_reserve
+    );
+
+    // Concurrent balloon actuation
+    util::task::parameters_t &actuation = policy.actuation;
+    actuation.number_of_workers = value
+    (
+        configuration, "actuation.workers",
+        actuation.number_of_workers
+    );
+    actuation.number_of_retries = value
+    (
+        configuration, "actuation.retries",
+        actuation.number_of_retries
+    );
+    actuation.number_of_abandoned = value
+    (
+        configuration, "actuation.abandoned",
+        actuation.number_of_abandoned
+    );
+    actuation.timeout = std::chrono::milliseconds
+    (
+        value
+        (
+            configuration, "actuation.timeout",
+            actuation.timeout.count()
+        )
+    );
+    actuation.backoff = std::chrono::milliseconds
+    (
+        value
+        (
+            configuration, "actuation.backoff",
+            actuation.backoff.count()
+        )
+    );
+    if (actuation.number_of_workers == 0 || actuation.timeout.count() <= 0
+        || actuation.backoff.count() < 0)
+    {
+        util::log::record
+        (
+            "Balloon actuation needs at least one worker, a positive timeout "
+            "and a non-negative backoff",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Statistics collection under a per domain deadline
+    manager::collector::parameters_t &collection = policy.collection;
+    collection.enabled = value
+    (
+        configuration, "collection.enabled",
+        collection.enabled
+    );
+    collection.deadline = std::chrono::milliseconds
+    (
+        value
+        (
+            configuration, "collection.deadline",
+            collection.deadline.count()
+        )
+    );
+    collection.number_of_workers = value
+    (
+        configuration, "collection.workers",
+        collection.number_of_workers
+    );
+    if (collection.number_of_workers == 0 || collection.deadline.count() <= 0)
+    {
+        util::log::record
+        (
+            "Statistics collection needs at least one worker and a positive "
+            "deadline",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Metric export
+    policy.metrics_path = value
+    (
+        configuration, "metrics.path",
+        policy.metrics_path
+    );
+
+    return EXIT_SUCCESS;
+}
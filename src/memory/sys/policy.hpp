@@ -0,0 +1,176 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include <conf/config.hpp>
+#include <metric/registry.hpp>
+#include <stat/statistics.hpp>
+#include <task/pool.hpp>
+
+#include "attribute/attribute.hpp"
+#include "domain/domain.hpp"
+#include "psi/psi.hpp"
+
+#include "backstop.hpp"
+#include "balloon.hpp"
+#include "collector.hpp"
+#include "compaction.hpp"
+#include "controller.hpp"
+#include "deduplication.hpp"
+#include "forecast.hpp"
+#include "hotplug.hpp"
+#include "hugepage.hpp"
+#include "hysteresis.hpp"
+#include "idle.hpp"
+#include "pressure.hpp"
+#include "reservation.hpp"
+#include "sampler.hpp"
+#include "swap.hpp"
+#include "tuner.hpp"
+
+
+/**
+ *  @brief Memory Policy Header
+ *
+ *  @details Defines the scheduler's runtime tunables and the state it keeps
+ *  between load balancer iterations
+ */
+namespace manager
+{
+
+using status_code = std::uint8_t;
+
+// Scheduler tunables
+typedef struct policy_t
+{
+    controller::parameters_t         controller;
+    pressure::parameters_t           pressure;
+    forecast::parameters_t           forecast;
+
+    // Movement coefficients of each priority class, tuned from outcomes
+    tuner::parameters_t              tuner;
+
+    // Movement phases against supplier and demander flapping
+    hysteresis::parameters_t         hysteresis;
+
+    // Balloon response tracking
+    balloon::parameters_t            balloon;
+
+    // Host side bounds of domains whose balloons stall
+    backstop::parameters_t           backstop;
+
+    // Deep reclaim of domains with idle vCPUs
+    idle::parameters_t               idle;
+
+    // Per domain reservations, limits and priority classes
+    reservation::parameters_t        reservation;
+
+    // Emergency reclaim on host memory pressure
+    os::psi::parameters_t            psi;
+    std::size_t                      emergency_suppliers = 4;
+
+    // Statistics sampling apart from load balancer
+    sampler::parameters_t            sampling;
+
+    // Domain attributes cached between iterations
+    libvirt::attribute::parameters_t attributes;
+
+    // KSM accounting and scan rate
+    deduplication::parameters_t      deduplication;
+
+    // Host swap accounting and grant hold
+    swap::parameters_t               swap;
+
+    // Virtio-mem hotplug of large changes
+    hotplug::parameters_t            hotplug;
+
+    // Hugepage pools of hugepage backed domains, which are not ballooned
+    hugepage::parameters_t           hugepage;
+
+    // Proactive compaction of fragmented nodes
+    compaction::parameters_t         compaction;
+
+    // Fraction of guest disk caches counted as reclaimable
+    std::double_t                    cache_fraction = 0.500;
+
+    // Per NUMA node budgeting
+    bool                             numa_enabled      = true;
+    util::stat::slong_t              numa_cell_reserve = 64 << 10;
+
+    // Concurrent balloon actuation
+    util::task::parameters_t         actuation;
+
+    // Statistics collection bounded per domain against hung guests
+    collector::parameters_t          collection;
+
+    // Metric export in text exposition format; empty path disables
+    std::string                      metrics_path;
+} policy_t;
+
+// Scheduler state between iterations
+typedef struct state_t
+{
+    controller::table_t      controller;
+    pressure::table_t        pressure;
+    forecast::table_t        forecast;
+    reservation::table_t     reservation;
+    balloon::table_t         balloon;
+    backstop::table_t        backstop;
+    deduplication::state_t   deduplication;
+    swap::state_t            swap;
+    hotplug::table_t         hotplug;
+    hysteresis::table_t      hysteresis;
+    hugepage::state_t        hugepage;
+    collector::state_t       collector;
+    compaction::state_t      compaction;
+    idle::table_t            idle;
+    tuner::state_t           tuner;
+    util::metric::registry_t metrics;
+
+    // Time source of iterations; simulations substitute their own
+    std::function<std::chrono::steady_clock::time_point ()> clock
+        = std::chrono::steady_clock::now;
+} state_t;
+
+// Read tunables from configuration
+[[nodiscard("Policy configuration status must be checked")]]
+status_code
+configure
+(
+    const util::conf::table_t &configuration,
+          policy_t            &policy
+) noexcept;
+
+
+
+/**
+ *  @brief Per Domain State Pruner
+ *
+ *  @param table: UUID-to-state table
+ *  @param UUIDs: UUIDs of domains currently running
+ *
+ *  @details Drops state of domains no longer running
+ */
+template <typename table_t>
+void
+prune
+(
+          table_t                     &table,
+    const libvirt::domain::uuid_set_t &uuids
+) noexcept
+{
+    typename table_t::iterator entry = table.begin();
+    while (entry != table.end())
+    {
+        if (uuids.find(entry->first) == uuids.end())
+            entry = table.erase(entry);
+        else
+            ++entry;
+    }
+}
+
+} // manager namespace
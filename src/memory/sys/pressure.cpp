@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include <stat/statistics.hpp>
+
+#include "domain/domain.hpp"
+
+#include "pressure.hpp"
+
+
+/**
+ *  @brief Counter Rate Between Iterations
+ *
+ *  @param current:  counter value this iteration
+ *  @param previous: counter value last iteration
+ *  @param seconds:  time elapsed between both values
+ *
+ *  @details Counters going backwards, as when a guest reboots, count as no
+ *  activity rather than negative activity
+ *
+ *  @return counter change per second
+ */
+std::double_t
+static rate
+(
+    util::stat::slong_t current,
+    util::stat::slong_t previous,
+    std::double_t       seconds
+) noexcept
+{
+    if (current < previous || seconds <= 0)
+        return 0.0;
+
+    return static_cast<std::double_t>(current - previous) / seconds;
+}
+
+
+/**
+ *  @brief Domain Memory Pressure Score
+ *
+ *  @param state:      domain's counters from last iteration
+ *  @param parameters: score weights and scales
+ *  @param datum:      domain's current memory statistics
+ *  @param now:        time of this iteration
+ *
+ *  @details Weighs the domain's major fault rate and swap traffic rate since
+ *  the last iteration, each normalized by the rate considered saturating,
+ *  with the fraction of the domain's memory it is unable to use without
+ *  swapping. Statistics the guest does not report do not contribute, and the
+ *  rates only contribute once a previous sample exists.
+ *
+ *  A guest whose unused memory looks healthy while it thrashes swap scores
+ *  high on the rate terms, and is thus seen as a demander.
+ *
+ *  @return pressure score; zero when no pressure is observed
+ */
+std::double_t
+manager::pressure::score
+(
+          manager::pressure::state_t            &state,
+    const manager::pressure::parameters_t       &parameters,
+    const libvirt::domain::datum_t              &datum,
+    const std::chrono::steady_clock::time_point &now
+) noexcept
+{
+    using libvirt::domain::memory_statistic_unreported;
+
+    std::double_t score = 0.0;
+
+    // Fault and swap rates since last iteration
+    if (state.primed)
+    {
+        const std::double_t seconds
+            = std::chrono::duration<std::double_t>(now - state.sampled_at)
+                .count();
+
+        if (datum.major_faults != memory_statistic_unreported)
+        {
+            const std::double_t major_fault_rate
+                = rate(datum.major_faults, state.major_faults, seconds);
+
+            score += parameters.major_fault_weight * std::min
+            (
+                major_fault_rate / parameters.major_fault_rate_scale,
+                1.0
+            );
+        }
+
+        if (datum.swap_in  != memory_statistic_unreported
+         && datum.swap_out != memory_statistic_unreported)
+        {
+            const std::double_t swap_rate
+                = rate(datum.swap_in,  state.swap_in,  seconds)
+                + rate(datum.swap_out, state.swap_out, seconds);
+
+            score += parameters.swap_weight * std::min
+            (
+                swap_rate / parameters.swap_rate_scale,
+                1.0
+            );
+        }
+    }
+
+    // Fraction of domain memory not usable without swapping
+    if (datum.memory_usable != memory_statistic_unreported
+        && datum.balloon_memory_used > 0)
+    {
+        const std::double_t usable_fraction
+            = static_cast<std::double_t>(datum.memory_usable)
+            / static_cast<std::double_t>(datum.balloon_memory_used);
+
+        score += parameters.usable_weight
+               * std::clamp(1.0 - usable_fraction, 0.0, 1.0);
+    }
+
+    // Save counters for next iteration
+    state.primed       = true;
+    state.sampled_at   = now;
+    state.major_faults = datum.major_faults;
+    state.swap_in      = datum.swap_in;
+    state.swap_out     = datum.swap_out;
+
+    return score;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <unordered_map>
+
+#include <stat/statistics.hpp>
+
+#include "domain/domain.hpp"
+
+
+/**
+ *  @brief Memory Pressure Header
+ *
+ *  @details Defines the composite per domain memory pressure score built from
+ *  guest fault and swap rates and from how little memory a guest can use
+ */
+namespace manager
+{
+
+namespace pressure
+{
+
+// Tunables; rate scales are the rates considered a score of one
+typedef struct parameters_t
+{
+    bool          enabled                = true;
+    std::double_t major_fault_weight     = 0.400;
+    std::double_t swap_weight            = 0.400;
+    std::double_t usable_weight          = 0.200;
+    std::double_t major_fault_rate_scale = 100.0;
+    std::double_t swap_rate_scale        = 10 << 10;
+    std::double_t demand_score           = 0.500;
+} parameters_t;
+
+// Per domain counters kept between load balancer iterations
+typedef struct state_t
+{
+    bool                                  primed       = false;
+    std::chrono::steady_clock::time_point sampled_at;
+    util::stat::slong_t                   major_faults = 0;
+    util::stat::slong_t                   swap_in      = 0;
+    util::stat::slong_t                   swap_out     = 0;
+} state_t;
+
+using table_t = std::unordered_map<libvirt::domain::uuid_t, state_t>;
+
+// Pressure routines
+[[nodiscard("Must use pressure score to call")]]
+std::double_t
+score
+(
+          state_t                               &state,
+    const parameters_t                          &parameters,
+    const libvirt::domain::datum_t              &datum,
+    const std::chrono::steady_clock::time_point &now
+) noexcept;
+
+} // pressure namespace
+
+} // manager namespace
@@ -0,0 +1,246 @@
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <string>
+
+#include <log/record.hpp>
+#include <stat/statistics.hpp>
+
+#include "domain/domain.hpp"
+
+#include "reservation.hpp"
+
+
+/**
+ *  @brief XML Attribute Reader
+ *
+ *  @param XML:   element to read attribute of
+ *  @param name:  attribute name
+ *  @param value: variable reference to write to
+ *
+ *  @details Reads a single or double quoted attribute of the outermost
+ *  element only
+ *
+ *  @return whether attribute was found
+ */
+bool
+static attribute
+(
+    const std::string &xml,
+    const std::string &name,
+          std::string &value
+) noexcept
+{
+    const std::size_t end = xml.find('>');
+    std::size_t position = 0;
+    while (true)
+    {
+        position = xml.find(name + "=", position);
+        if (position == std::string::npos || position >= end)
+            return false;
+
+        // Attribute name must stand on its own
+        if (position > 0 && !std::isspace(xml[position - 1]))
+        {
+            position += name.size();
+            continue;
+        }
+
+        const std::size_t open = position + name.size() + 1;
+        if (open >= xml.size() || (xml[open] != '"' && xml[open] != '\''))
+            return false;
+
+        const std::size_t close = xml.find(xml[open], open + 1);
+        if (close == std::string::npos)
+            return false;
+
+        value = xml.substr(open + 1, close - open - 1);
+        return true;
+    }
+}
+
+
+/**
+ *  @brief Memory Size Reader
+ *
+ *  @param string: memory size in KiB
+ *  @param size:   variable reference to write to
+ *
+ *  @return whether size is a non-negative integer
+ */
+bool
+static memory_size
+(
+    const std::string         &string,
+          util::stat::slong_t &size
+) noexcept
+{
+    try
+    {
+        std::size_t length = 0;
+        const util::stat::slong_t parsed = std::stoll(string, &length);
+        if (length != string.size() || parsed < 0)
+            return false;
+
+        size = parsed;
+        return true;
+    }
+
+    catch (const std::exception &exception)
+    {
+        return false;
+    }
+}
+
+
+/**
+ *  @brief Priority Class Parser
+ *
+ *  @param name:           class name; latency-critical, guaranteed, or
+ *                         best-effort
+ *  @param priority class: variable reference to write to
+ *
+ *  @return whether name is a known class
+ */
+bool
+manager::reservation::parse
+(
+    const std::string                    &name,
+          manager::reservation::priority &priority_class
+) noexcept
+{
+    if (name == "latency-critical")
+        priority_class = manager::reservation::priority::LATENCY_CRITICAL;
+    else if (name == "guaranteed")
+        priority_class = manager::reservation::priority::GUARANTEED;
+    else if (name == "best-effort")
+        priority_class = manager::reservation::priority::BEST_EFFORT;
+    else
+        return false;
+
+    return true;
+}
+
+
+/**
+ *  @brief Domain Reservation Resolver
+ *
+ *  @param state:      domain's cached reservation
+ *  @param parameters: reservation tunables
+ *  @param datum:      domain to resolve reservation of
+ *  @param now:        time of this iteration
+ *
+ *  @details Configured reservations override metadata. Otherwise the
+ *  domain's metadata element is read, such as
+ *
+ *      <memory xmlns="..." class="latency-critical"
+ *              reservation="4194304" limit="8388608"/>
+ *
+ *  and cached until the refresh period passes, unless the metadata URI is
+ *  empty. Domains with neither get the default class and no reservation or
+ *  limit.
+ *
+ *  @return domain's reservation
+ */
+manager::reservation::reservation_t
+manager::reservation::resolve
+(
+          manager::reservation::state_t         &state,
+    const manager::reservation::parameters_t    &parameters,
+    const libvirt::domain::datum_t              &datum,
+    const std::chrono::steady_clock::time_point &now
+) noexcept
+{
+    const manager::reservation::reservations_t::const_iterator configured
+        = parameters.overrides.find(datum.uuid);
+    if (configured != parameters.overrides.end())
+        return configured->second;
+
+    // Metadata lookup disabled by an empty URI
+    if (parameters.metadata_uri.empty())
+    {
+        manager::reservation::reservation_t reservation;
+        reservation.priority_class = parameters.default_class;
+
+        return reservation;
+    }
+
+    // Reuse metadata read recently
+    if (state.loaded && now - state.loaded_at < parameters.refresh)
+        return state.reservation;
+
+    state.loaded      = true;
+    state.loaded_at   = now;
+    state.reservation = manager::reservation::reservation_t();
+    state.reservation.priority_class = parameters.default_class;
+
+    std::string xml;
+    libvirt::status_code status
+        = libvirt::domain::metadata(datum, parameters.metadata_uri, xml);
+    if (static_cast<bool>(status))
+        return state.reservation;
+
+    // Malformed fields fall back to defaults
+    std::string value;
+    if (attribute(xml, "class", value)
+        && !parse(value, state.reservation.priority_class))
+    {
+        util::log::record
+        (
+            "Domain " + datum.uuid + " has unknown priority class " + value,
+            util::log::type::FLAG
+        );
+    }
+    if (attribute(xml, "reservation", value)
+        && !memory_size(value, state.reservation.reservation))
+    {
+        util::log::record
+        (
+            "Domain " + datum.uuid + " has malformed reservation " + value,
+            util::log::type::FLAG
+        );
+    }
+    if (attribute(xml, "limit", value)
+        && !memory_size(value, state.reservation.limit))
+    {
+        util::log::record
+        (
+            "Domain " + datum.uuid + " has malformed limit " + value,
+            util::log::type::FLAG
+        );
+    }
+
+    return state.reservation;
+}
+
+
+/**
+ *  @brief Priority Class Weight
+ *
+ *  @param parameters:     reservation tunables
+ *  @param priority class: class to weigh
+ *
+ *  @return class's weight on contended memory
+ */
+std::double_t
+manager::reservation::weight
+(
+    const manager::reservation::parameters_t &parameters,
+          manager::reservation::priority      priority_class
+) noexcept
+{
+    switch (priority_class)
+    {
+        case manager::reservation::priority::LATENCY_CRITICAL:
+            return parameters.latency_critical_weight;
+
+        case manager::reservation::priority::GUARANTEED:
+            return parameters.guaranteed_weight;
+
+        case manager::reservation::priority::BEST_EFFORT:
+            return parameters.best_effort_weight;
+    }
+
+    return parameters.best_effort_weight;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include <stat/statistics.hpp>
+
+#include "domain/domain.hpp"
+
+
+/**
+ *  @brief Memory Reservation Header
+ *
+ *  @details Defines per domain memory reservations, limits and priority
+ *  classes, read from domain metadata or configuration
+ */
+namespace manager
+{
+
+namespace reservation
+{
+
+// Priority classes, most protected first
+enum class priority: std::uint8_t
+{
+    LATENCY_CRITICAL = 0x00,
+    GUARANTEED       = 0x01,
+    BEST_EFFORT      = 0x02
+};
+
+// Reservation of a single domain; memory in KiB, limit of zero is no limit
+typedef struct reservation_t
+{
+    priority            priority_class = priority::BEST_EFFORT;
+    util::stat::slong_t reservation    = 0;
+    util::stat::slong_t limit          = 0;
+} reservation_t;
+
+using reservations_t
+    = std::unordered_map<libvirt::domain::uuid_t, reservation_t>;
+
+// Tunables; weights scale a class's share of contended memory
+typedef struct parameters_t
+{
+    bool                 enabled                 = true;
+    std::string          metadata_uri            = "http://hypman/memory/1.0";
+    std::chrono::seconds refresh                 = std::chrono::seconds(60);
+    priority             default_class           = priority::BEST_EFFORT;
+    std::double_t        latency_critical_weight = 4.000;
+    std::double_t        guaranteed_weight       = 2.000;
+    std::double_t        best_effort_weight      = 1.000;
+    reservations_t       overrides;
+} parameters_t;
+
+// Per domain reservation cached between load balancer iterations
+typedef struct state_t
+{
+    reservation_t                         reservation;
+    bool                                  loaded = false;
+    std::chrono::steady_clock::time_point loaded_at;
+} state_t;
+
+using table_t = std::unordered_map<libvirt::domain::uuid_t, state_t>;
+
+// Reservation routines
+[[nodiscard("Must use whether priority class was parsed to call")]]
+bool
+parse
+(
+    const std::string &name,
+          priority    &priority_class
+) noexcept;
+
+[[nodiscard("Must use domain reservation to call")]]
+reservation_t
+resolve
+(
+          state_t                               &state,
+    const parameters_t                          &parameters,
+    const libvirt::domain::datum_t              &datum,
+    const std::chrono::steady_clock::time_point &now
+) noexcept;
+
+[[nodiscard("Must use class weight to call")]]
+std::double_t
+weight
+(
+    const parameters_t &parameters,
+          priority      priority_class
+) noexcept;
+
+} // reservation namespace
+
+} // manager namespace
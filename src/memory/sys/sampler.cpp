@@ -0,0 +1,337 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <lib/libvirt.hpp>
+#include <log/record.hpp>
+#include <stat/statistics.hpp>
+
+#include "attribute/attribute.hpp"
+#include "domain/domain.hpp"
+
+#include "collector.hpp"
+#include "policy.hpp"
+#include "sampler.hpp"
+
+
+/**
+ *  @brief Statistics Sampling Loop
+ *
+ *  @param sampler:         sampler to fill windows of
+ *  @param parameters:      sampler tunables
+ *  @param collection:      collection tunables, whose deadline bounds a
+ *                          period
+ *  @param connection:      hypervisor connection via libvirt
+ *  @param attribute cache: domain attributes shared with load balancer
+ *
+ *  @details Collects memory statistics of every running domain each period
+ *  under the collection deadline and records their unused memory into the
+ *  domain's window, such that a hung guest holds up neither sampling nor
+ *  stopping the sampler. Domains served stale are not recorded again.
+ *  Windows of domains no longer running are dropped, and a failed collection
+ *  is simply retried the next period.
+ */
+void
+static sample
+(
+          manager::sampler::sampler_t      &sampler,
+          manager::sampler::parameters_t    parameters,
+          manager::collector::parameters_t  collection,
+    const libvirt::connection_t            &connection,
+          libvirt::attribute::handle_t      attribute_cache
+) noexcept
+{
+    while (sampler.running)
+    {
+        libvirt::status_code status;
+
+        libvirt::domain::table_t domain_table;
+        status = libvirt::domain::table(connection, domain_table);
+
+        libvirt::domain::data_t domain_data;
+        if (!static_cast<bool>(status) && !domain_table.empty())
+        {
+            domain_data.reserve(domain_table.size());
+            status = manager::collector::collect
+            (
+                sampler.collector, collection, domain_table, domain_data,
+                attribute_cache, sampler.metrics
+            );
+        }
+
+        if (!static_cast<bool>(status))
+        {
+            std::lock_guard<std::mutex> lock(sampler.mutex);
+
+            libvirt::domain::uuid_set_t domain_uuids;
+            for (const libvirt::domain::datum_t &datum: domain_data)
+            {
+                domain_uuids.insert(datum.uuid);
+                if (datum.stale)
+                    continue;
+
+                manager::sampler::record
+                (
+                    sampler.rings[datum.uuid], parameters.window, 
+                    datum.domain_memory_extra
+                );
+            }
+            manager::prune(sampler.rings, domain_uuids);
+        }
+
+        // Sleep until next sample unless stopped
+        std::unique_lock<std::mutex> lock(sampler.mutex);
+        sampler.condition.wait_for
+        (
+            lock, parameters.period,
+            [&sampler]()
+            {
+                return !sampler.running;
+            }
+        );
+    }
+}
+
+
+/**
+ *  @brief Aggregate Parser
+ *
+ *  @param name:      aggregate name; minimum, mean, or maximum
+ *  @param statistic: variable reference to write to
+ *
+ *  @return whether name is a known aggregate
+ */
+bool
+manager::sampler::parse
+(
+    const std::string                 &name,
+          manager::sampler::aggregate &statistic
+) noexcept
+{
+    if (name == "minimum")
+        statistic = manager::sampler::aggregate::MINIMUM;
+    else if (name == "mean")
+        statistic = manager::sampler::aggregate::MEAN;
+    else if (name == "maximum")
+        statistic = manager::sampler::aggregate::MAXIMUM;
+    else
+        return false;
+
+    return true;
+}
+
+
+/**
+ *  @brief Statistics Sampler Starter
+ *
+ *  @param sampler:         sampler to start
+ *  @param parameters:      sampler tunables
+ *  @param collection:      collection tunables
+ *  @param connection:      hypervisor connection via libvirt, which must
+ *                          outlive the sampler
+ *  @param attribute cache: domain attributes shared with load balancer
+ *
+ *  @details Launches the sampling thread if sampling is enabled
+ *
+ *  @return execution status code
+ */
+manager::sampler::status_code
+manager::sampler::start
+(
+          manager::sampler::sampler_t      &sampler,
+    const manager::sampler::parameters_t   &parameters,
+    const manager::collector::parameters_t &collection,
+    const libvirt::connection_t            &connection,
+    const libvirt::attribute::handle_t     &attribute_cache
+) noexcept
+{
+    if (!parameters.enabled)
+        return EXIT_SUCCESS;
+
+    if (sampler.running)
+    {
+        util::log::record
+        (
+            "Statistics sampler is already running",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        sampler.running = true;
+        sampler.thread = std::thread
+        (
+            sample, std::ref(sampler), parameters, collection,
+            std::cref(connection), attribute_cache
+        );
+    }
+
+    catch (const std::exception &exception)
+    {
+        sampler.running = false;
+
+        util::log::record
+        (
+            "Unable to launch statistics sampler thread",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+/**
+ *  @brief Statistics Sampler Stopper
+ *
+ *  @param sampler: sampler to stop
+ *
+ *  @details Signals sampling thread to exit and waits for it
+ */
+void
+manager::sampler::stop
+(
+    manager::sampler::sampler_t &sampler
+) noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(sampler.mutex);
+        sampler.running = false;
+    }
+    sampler.condition.notify_all();
+
+    if (sampler.thread.joinable())
+        sampler.thread.join();
+}
+
+
+/**
+ *  @brief Window Recorder
+ *
+ *  @param ring:   domain's window
+ *  @param window: window capacity in samples
+ *  @param sample: unused memory to record
+ *
+ *  @details Overwrites the oldest sample once the window is full
+ */
+void
+manager::sampler::record
+(
+    manager::sampler::ring_t &ring,
+    std::size_t               window,
+    util::stat::slong_t       sample
+) noexcept
+{
+    window = std::max<std::size_t>(window, 1);
+    if (ring.samples.size() != window)
+    {
+        ring.samples.assign(window, 0);
+        ring.next  = 0;
+        ring.count = 0;
+    }
+
+    ring.samples[ring.next] = sample;
+    ring.next  = (ring.next + 1) % window;
+    ring.count = std::min(ring.count + 1, window);
+}
+
+
+/**
+ *  @brief Window Summarizer
+ *
+ *  @param ring: domain's window
+ *
+ *  @return minimum, mean, and maximum of samples in window
+ */
+manager::sampler::summary_t
+manager::sampler::summarize
+(
+    const manager::sampler::ring_t &ring
+) noexcept
+{
+    manager::sampler::summary_t summary;
+    if (ring.count == 0)
+        return summary;
+
+    // Oldest sample sits at next once the window is full, otherwise at zero
+    const std::size_t first = ring.count == ring.samples.size() ? ring.next : 0;
+    summary.minimum = ring.samples[first];
+    summary.maximum = ring.samples[first];
+
+    std::double_t total = 0;
+    for (std::size_t offset = 0; offset < ring.count; ++offset)
+    {
+        const util::stat::slong_t sample
+            = ring.samples[(first + offset) % ring.samples.size()];
+
+        summary.minimum = std::min(summary.minimum, sample);
+        summary.maximum = std::max(summary.maximum, sample);
+        total += sample;
+    }
+    summary.mean  = total / ring.count;
+    summary.count = ring.count;
+
+    return summary;
+}
+
+
+/**
+ *  @brief Window Aggregator
+ *
+ *  @param sampler:     sampler holding windows
+ *  @param parameters:  sampler tunables
+ *  @param domain data: domains to replace unused memory snapshot of
+ *
+ *  @details Records each domain's current snapshot into its window, then 
+ *  replaces the snapshot with the configured aggregate over the window, such
+ *  that the balancer acts on the domain's recent range rather than a single
+ *  instant. The minimum is conservative both ways, as only memory reliably 
+ *  unused is supplied and any dip in unused memory raises demand.
+ */
+void
+manager::sampler::aggregate_into
+(
+          manager::sampler::sampler_t    &sampler,
+    const manager::sampler::parameters_t &parameters,
+          libvirt::domain::data_t        &domain_data
+) noexcept
+{
+    std::lock_guard<std::mutex> lock(sampler.mutex);
+    for (libvirt::domain::datum_t &datum: domain_data)
+    {
+        manager::sampler::ring_t &ring = sampler.rings[datum.uuid];
+        manager::sampler::record
+        (
+            ring, parameters.window, datum.domain_memory_extra
+        );
+
+        const manager::sampler::summary_t summary 
+            = manager::sampler::summarize(ring);
+        switch (parameters.statistic)
+        {
+            case manager::sampler::aggregate::MINIMUM:
+                datum.domain_memory_extra = summary.minimum;
+                break;
+
+            case manager::sampler::aggregate::MEAN:
+                datum.domain_memory_extra 
+                    = static_cast<util::stat::slong_t>(summary.mean);
+                break;
+
+            case manager::sampler::aggregate::MAXIMUM:
+                datum.domain_memory_extra = summary.maximum;
+                break;
+        }
+    }
+}
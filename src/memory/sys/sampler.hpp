@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <lib/libvirt.hpp>
+#include <metric/registry.hpp>
+#include <stat/statistics.hpp>
+
+#include "attribute/attribute.hpp"
+#include "domain/domain.hpp"
+
+#include "collector.hpp"
+
+
+/**
+ *  @brief Statistics Sampler Header
+ *
+ *  @details Defines the thread sampling domain memory statistics at their own
+ *  rate, apart from the load balancer, into a per domain window the balancer
+ *  reads aggregates of
+ */
+namespace manager
+{
+
+namespace sampler
+{
+
+using status_code = std::uint8_t;
+
+// Aggregate of window handed to the balancer as unused memory
+enum class aggregate: std::uint8_t
+{
+    MINIMUM = 0x00,
+    MEAN    = 0x01,
+    MAXIMUM = 0x02
+};
+
+// Tunables; window in samples, stats period of zero follows the balancer 
+// interval
+typedef struct parameters_t
+{
+    bool                      enabled      = false;
+    std::chrono::milliseconds period       = std::chrono::milliseconds(1000);
+    std::size_t               window       = 10;
+    std::chrono::seconds      stats_period = std::chrono::seconds(0);
+    aggregate                 statistic    = aggregate::MINIMUM;
+} parameters_t;
+
+// Fixed capacity window of a domain's most recent unused memory samples
+typedef struct ring_t
+{
+    std::vector<util::stat::slong_t> samples;
+    std::size_t                      next  = 0;
+    std::size_t                      count = 0;
+} ring_t;
+
+// Aggregates of a domain's window
+typedef struct summary_t
+{
+    util::stat::slong_t minimum = 0;
+    std::double_t       mean    = 0.0;
+    util::stat::slong_t maximum = 0;
+    std::size_t         count   = 0;
+} summary_t;
+
+using rings_t = std::unordered_map<libvirt::domain::uuid_t, ring_t>;
+
+// Sampler thread and the windows it fills, collecting apart from the
+// balancer's slow set and metrics
+typedef struct sampler_t
+{
+    std::thread                 thread;
+    std::mutex                  mutex;
+    std::condition_variable     condition;
+    rings_t                     rings;
+    std::atomic<bool>           running = false;
+    manager::collector::state_t collector;
+    util::metric::registry_t    metrics;
+} sampler_t;
+
+// Sampler routines
+[[nodiscard("Must use whether aggregate was parsed to call")]]
+bool
+parse
+(
+    const std::string &name,
+          aggregate   &statistic
+) noexcept;
+
+[[nodiscard("Sampler start status must be checked")]]
+status_code
+start
+(
+          sampler_t                        &sampler,
+    const parameters_t                     &parameters,
+    const manager::collector::parameters_t &collection,
+    const libvirt::connection_t            &connection,
+    const libvirt::attribute::handle_t     &attribute_cache
+) noexcept;
+
+void
+stop
+(
+    sampler_t &sampler
+) noexcept;
+
+void
+record
+(
+    ring_t              &ring,
+    std::size_t          window,
+    util::stat::slong_t  sample
+) noexcept;
+
+[[nodiscard("Must use window aggregates to call")]]
+summary_t
+summarize
+(
+    const ring_t &ring
+) noexcept;
+
+void
+aggregate_into
+(
+          sampler_t               &sampler,
+    const parameters_t            &parameters,
+          libvirt::domain::data_t &domain_data
+) noexcept;
+
+} // sampler namespace
+
+} // manager namespace
@@ -1,26 +1,317 @@
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstddef>
 #include <cstdlib>
+#include <functional>
+#include <limits>
+#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <lib/libvirt.hpp>
 #include <log/record.hpp>
 #include <stat/statistics.hpp>
+#include <task/pool.hpp>
 
 #include "domain/domain.hpp"
+#include "hardware/hardware.hpp"
 
+#include "actuator.hpp"
+#include "allocator.hpp"
+#include "backstop.hpp"
+#include "balloon.hpp"
+#include "compaction.hpp"
+#include "controller.hpp"
+#include "deduplication.hpp"
+#include "forecast.hpp"
+#include "hotplug.hpp"
+#include "hugepage.hpp"
+#include "hysteresis.hpp"
+#include "idle.hpp"
+#include "policy.hpp"
+#include "pressure.hpp"
+#include "reservation.hpp"
 #include "scheduler.hpp"
+#include "swap.hpp"
+#include "tuner.hpp"
 
 
 // Mimimum memory limits
 static constexpr util::stat::slong_t MINIMUM_SYSTEM_MEMORY = 200 << 10;
 static constexpr util::stat::slong_t MINIMUM_DOMAIN_MEMORY = 100 << 10;
 
-// Movement coefficients
-static constexpr std::double_t SUPPLY_COEFFICIENT = 0.115;
-static constexpr std::double_t DEMAND_COEFFICIENT = 0.085;
-static constexpr std::double_t CHANGE_COEFFICIENT = 0.200;
+
+/**
+ *  @brief NUMA Cell Budget
+ *
+ *  @param cells memory: memory ready to be consumed on each NUMA cell
+ *  @param datum:        domain to determine budget for
+ *
+ *  @details Domains of unknown placement, or any domain when cells are not
+ *  tracked, are bound only by the system total
+ *
+ *  @return memory a domain may grow by without leaving its NUMA cells
+ */
+util::stat::slong_t
+static cell_budget
+(
+    const libvirt::hardware::cells_t &cells_memory,
+    const libvirt::domain::datum_t   &datum
+) noexcept
+{
+    if (cells_memory.empty() || datum.cells.empty())
+        return std::numeric_limits<util::stat::slong_t>::max();
+
+    util::stat::slong_t budget = 0;
+    for (const libvirt::hardware::cell_t cell: datum.cells)
+    {
+        if (cell < 0 || static_cast<std::size_t>(cell) >= cells_memory.size())
+            continue;
+
+        budget += std::max<util::stat::slong_t>(cells_memory[cell], 0);
+    }
+
+    return budget;
+}
+
+
+/**
+ *  @brief NUMA Cell Charger
+ *
+ *  @param cells memory: memory ready to be consumed on each NUMA cell
+ *  @param datum:        domain whose memory changed
+ *  @param change:       memory change of domain; negative when domain loses
+ *
+ *  @details Memory taken by a domain is drawn from its cells in order, while
+ *  memory given up by a domain is returned evenly to its cells
+ */
+void
+static charge_cells
+(
+          libvirt::hardware::cells_t &cells_memory,
+    const libvirt::domain::datum_t   &datum,
+          util::stat::slong_t         change
+) noexcept
+{
+    std::vector<libvirt::hardware::cell_t> cells;
+    for (const libvirt::hardware::cell_t cell: datum.cells)
+    {
+        if (cell >= 0 && static_cast<std::size_t>(cell) < cells_memory.size())
+            cells.push_back(cell);
+    }
+    if (cells.empty())
+        return;
+
+    // Return memory given up evenly
+    if (change < 0)
+    {
+        const util::stat::slong_t share 
+            = -change / static_cast<util::stat::slong_t>(cells.size());
+        for (const libvirt::hardware::cell_t cell: cells)
+            cells_memory[cell] += share;
+
+        return;
+    }
+
+    // Draw memory taken in order
+    for (const libvirt::hardware::cell_t cell: cells)
+    {
+        const util::stat::slong_t drawn = std::min
+        (
+            change, 
+            std::max<util::stat::slong_t>(cells_memory[cell], 0)
+        );
+        cells_memory[cell] -= drawn;
+        change             -= drawn;
+    }
+}
+
+
+/**
+ *  @brief Domain Memory Floor
+ *
+ *  @param reservation: domain's reservation
+ *
+ *  @return memory a domain is never ballooned below
+ */
+util::stat::slong_t
+static domain_floor
+(
+    const manager::reservation::reservation_t &reservation
+) noexcept
+{
+    return std::max(MINIMUM_DOMAIN_MEMORY, reservation.reservation);
+}
+
+
+/**
+ *  @brief Reclaimable Disk Caches
+ *
+ *  @param datum:  domain to estimate for
+ *  @param policy: scheduler tunables
+ *
+ *  @details Clean page cache is dropped by a guest under balloon pressure at
+ *  little cost, so the configured fraction of it counts toward the memory a
+ *  domain can give up; guests not reporting caches have none
+ *
+ *  @return disk cache memory counted as reclaimable
+ */
+std::double_t
+static reclaimable_caches
+(
+    const libvirt::domain::datum_t &datum,
+    const manager::policy_t        &policy
+) noexcept
+{
+    if (datum.disk_caches <= 0)
+        return 0.0;
+
+    return policy.cache_fraction 
+        * static_cast<std::double_t>(datum.disk_caches);
+}
+
+
+/**
+ *  @brief Reclaimable Memory Share
+ *
+ *  @param datum:  domain to estimate for
+ *  @param policy: scheduler tunables
+ *
+ *  @details Domains with more of their memory unused or in cheaply dropped
+ *  caches lose less by giving some up
+ *
+ *  @return reclaimable memory as a fraction of the domain's limit
+ */
+std::double_t
+static reclaimable_share
+(
+    const libvirt::domain::datum_t &datum,
+    const manager::policy_t        &policy
+) noexcept
+{
+    if (datum.domain_memory_limit <= 0)
+        return 0.0;
+
+    return (static_cast<std::double_t>(datum.domain_memory_extra) 
+            + reclaimable_caches(datum, policy))
+        / static_cast<std::double_t>(datum.domain_memory_limit);
+}
+
+
+/**
+ *  @brief Domain Memory Ceiling
+ *
+ *  @param datum:       domain to determine ceiling for
+ *  @param reservation: domain's reservation
+ *  @param headroom:    memory domain's virtio-mem device can still plug
+ *
+ *  @return memory a domain is never grown above
+ */
+util::stat::slong_t
+static domain_ceiling
+(
+    const libvirt::domain::datum_t            &datum,
+    const manager::reservation::reservation_t &reservation,
+          util::stat::slong_t                  headroom
+) noexcept
+{
+    const util::stat::slong_t limit = datum.domain_memory_limit + headroom;
+    if (reservation.limit > 0)
+        return std::min(limit, reservation.limit);
+
+    return limit;
+}
+
+
+/**
+ *  @brief Memory Provider
+ *
+ *  @param demanders:    domains requesting memory
+ *  @param group:        indices of demanders dividing the same supply
+ *  @param supply:       memory to divide amongst group
+ *  @param policy:       scheduler tunables
+ *  @param reservations: reservations of domains
+ *  @param devices:      virtio-mem devices of domains
+ *  @param cells memory: memory ready to be consumed on each NUMA cell
+ *  @param grants:       balloon targets to append to
+ *
+ *  @details Each domain claims its requested change capped by its limit and
+ *  by the free memory of its NUMA cells, with growth up to its reservation 
+ *  guaranteed, weighted by its working set pressure score and priority class.
+ *  Claims are divided by water-filling and memory granted is charged to the
+ *  domains' cells.
+ *
+ *  @return memory granted to group
+ */
+util::stat::slong_t
+static provide
+(
+    const libvirt::domain::data_t              &demanders,
+    const std::vector<std::size_t>             &group,
+          util::stat::slong_t                   supply,
+    const manager::policy_t                    &policy,
+    const manager::reservation::reservations_t &reservations,
+    const manager::hotplug::table_t            &devices,
+          libvirt::hardware::cells_t           &cells_memory,
+          manager::actuator::requests_t        &grants
+) noexcept
+{
+    manager::allocator::claims_t claims(group.size());
+    for (std::size_t member = 0; member < group.size(); ++member)
+    {
+        const libvirt::domain::datum_t &datum = demanders[group[member]];
+        manager::allocator::claim_t    &claim = claims[member];
+        const manager::reservation::reservation_t &reservation 
+            = reservations.at(datum.uuid);
+        const util::stat::slong_t domain_memory_ceiling = domain_ceiling
+        (
+            datum, reservation,
+            manager::hotplug::headroom(devices, policy.hotplug, datum.uuid)
+        );
+
+        claim.request = std::min
+        (
+            {
+                static_cast<util::stat::slong_t>(datum.domain_memory_delta),
+                domain_memory_ceiling - datum.balloon_memory_used,
+                cell_budget(cells_memory, datum)
+            }
+        );
+        claim.guarantee = domain_floor(reservation) - datum.balloon_memory_used;
+        claim.weight    = (1.0 + datum.domain_memory_pressure)
+            * manager::reservation::weight
+              (
+                  policy.reservation, reservation.priority_class
+              );
+        if (claim.request <= 0)
+        {
+            util::log::record
+            (
+                "Domain " + datum.uuid 
+                    + " is at its limit or its NUMA nodes have no memory free",
+                util::log::type::FLAG
+            );
+        }
+    }
+
+    manager::allocator::shares_t shares;
+    const util::stat::slong_t granted 
+        = manager::allocator::water_fill(claims, supply, shares);
+
+    for (std::size_t member = 0; member < group.size(); ++member)
+    {
+        if (shares[member] <= 0)
+            continue;
+
+        const libvirt::domain::datum_t &datum = demanders[group[member]];
+        grants.push_back({&datum, datum.balloon_memory_used + shares[member]});
+        charge_cells(cells_memory, datum, shares[member]);
+    }
+
+    return granted;
+}
 
 
 /**
@@ -28,28 +319,66 @@ static constexpr std::double_t CHANGE_COEFFICIENT = 0.200;
  *
  *  @param domain data:         Collection of data about domains for scheduler's 
  *                              required reallocation policies
- *  @param system memory limit: Memory limit dictated by hardware
+ *  @param hardware datum:      Memory limit and NUMA cells' free memory 
+ *                              dictated by hardware
+ *  @param policy:              Scheduler tunables
+ *  @param state:               Scheduler state kept between iterations
  *
  *  @details Determine how much and where to reallocate memory between domains
  *  to ensure fairness of performance amongst all domains.
  *
  *  Scheduler determines whether a domain can afford to supply or is in need of
- *  more memmory based much memory is unused by the balloon driver. Then it 
- *  proceeds to reclaim as much memory as possible from those domains which can 
- *  prvoided without degrading their performance.
+ *  more memmory based much memory is unused by the balloon driver, counting
+ *  the configured fraction of its disk caches as unused, or whether it is
+ *  thrashing regardless of its unused memory. Then it proceeds to 
+ *  reclaim as much memory as possible from those domains which can prvoided 
+ *  without degrading their performance. How much memory a domain
+ *  moves is sized by the balloon controller from how far its unused memory is
+ *  from the headroom band, or by a fixed step when the controller is disabled.
+ *
+ *  Once done, the memory left is divided amongst the domains requiring more
+ *  by max-min fair water-filling, weighted by their working set pressure 
+ *  scores from guest fault and swap rates. When memory is short, every domain
+ *  gets the same share per weight, regardless of where it is in the list.
+ *
+ *  Memory is balanced within each NUMA node first: domains placed on a single
+ *  node divide its free memory before domains spanning nodes divide what is
+ *  left, and no domain grows by more than what is free on its nodes, counting 
+ *  memory reclaimed from suppliers on the same nodes.
+ *
+ *  Domains within the band are also moved early when their unused memory is
+ *  projected to fall below the band within the forecast horizon, or when
+ *  their memory use is in sustained decline.
+ *
+ *  Domains near the band's edges do not flip between supplying and demanding
+ *  on consecutive iterations: a domain starts moving only once beyond the
+ *  band by a dead band and after dwelling in its phase, and waits out a
+ *  cooldown before reversing. Moves past its limit or under working set
+ *  pressure are never held back.
+ *
+ *  Balloon targets are applied concurrently, first to all suppliers and then,
+ *  counting only memory suppliers actually gave up, to all demanders.
+ *
+ *  Domains whose vCPUs have been idle for long enough are reclaimed down to
+ *  an idle floor regardless of how much they report unused, a step at a
+ *  time, and given back what was taken as soon as their vCPUs wake.
+ *
+ *  Hugepage backed domains are not ballooned; the host's hugepage pools are
+ *  sized to the pages they reserve on each node instead.
  *
- *  Once done, the domains requiring more memory are sorted based on their
- *  memory pressures from how many vCPUs they have. Finally, domains are served 
- *  in this priority, and if the amount the require is unsatisfieable, they will 
- *  get a portion of what is left.
+ *  Domains with a virtio-mem device have changes of at least the hotplug
+ *  threshold, and growth past their maximum memory, applied by resizing the
+ *  device instead of their balloon.
  *
  *  @return execution status code
  */
 manager::status_code
 manager::scheduler
 (
-    libvirt::domain::data_t &domain_data, 
-    util::stat::slong_t      system_memory_limit
+          libvirt::domain::data_t    &domain_data, 
+    const libvirt::hardware::datum_t &hardware_datum,
+    const manager::policy_t          &policy,
+          manager::state_t           &state
 )
 {
     // Check domain consistency 
@@ -64,6 +393,25 @@ manager::scheduler
         return EXIT_FAILURE;
     }
 
+    // Time of this iteration
+    const std::chrono::steady_clock::time_point now = state.clock();
+
+    // Forget state of domains no longer running
+    libvirt::domain::uuid_set_t domain_uuids;
+    for (const libvirt::domain::datum_t &datum: domain_data)
+        domain_uuids.insert(datum.uuid);
+
+    manager::prune(state.controller,  domain_uuids);
+    manager::prune(state.pressure,    domain_uuids);
+    manager::prune(state.forecast,    domain_uuids);
+    manager::prune(state.reservation, domain_uuids);
+    manager::prune(state.balloon,     domain_uuids);
+    manager::prune(state.hotplug,     domain_uuids);
+    manager::prune(state.hysteresis,  domain_uuids);
+    manager::prune(state.idle,        domain_uuids);
+    manager::prune(state.backstop,    domain_uuids);
+    manager::prune(state.tuner.watches, domain_uuids);
+
 
     /******************** DETERMINE HOW MEMORY NEEDS TO MOVE ******************/
  
@@ -75,7 +423,40 @@ manager::scheduler
   
     // Memory ready to be consumed; domain changes subtract from system total
     util::stat::slong_t available_memory 
-        = system_memory_limit - MINIMUM_SYSTEM_MEMORY;
+        = hardware_datum.memory_limit - MINIMUM_SYSTEM_MEMORY;
+
+    // Pages merged by KSM are counted by every domain sharing them but backed
+    // by the host only once
+    if (policy.deduplication.enabled)
+    {
+        available_memory += manager::deduplication::credit
+        (
+            state.deduplication, policy.deduplication
+        );
+    }
+
+    // Pages idle in hugepage pools cannot back ballooned domains
+    manager::hugepage::demands_t hugepage_demands;
+    if (policy.hugepage.enabled)
+    {
+        available_memory -= manager::hugepage::idle
+        (
+            state.hugepage, policy.hugepage
+        );
+    }
+
+    // Memory ready to be consumed on each NUMA cell less cell reserve
+    libvirt::hardware::cells_t cells_memory;
+    if (policy.numa_enabled)
+        cells_memory = hardware_datum.cells_memory_free;
+    for (util::stat::slong_t &cell_memory: cells_memory)
+        cell_memory -= policy.numa_cell_reserve;
+
+    // Reservations of domains for this iteration
+    manager::reservation::reservations_t reservations;
+
+    // Memory granted to domains whose balloons have yet to grow into it
+    util::stat::slong_t pending_growth = 0;
 
     // Determine memory movement of each domain
     libvirt::domain::data_t::iterator datum;
@@ -94,23 +475,268 @@ manager::scheduler
             return EXIT_FAILURE;
         }
 
-        // Domain's unused memory and memory limit
-        const std::double_t domain_memory_extra = 
-            static_cast<std::double_t>(datum->domain_memory_extra);
+        // Hugepage backed domain is not ballooned; its pool is sized to it
+        if (datum->hugepage_size != 0)
+        {
+            manager::hugepage::reserve
+            (
+                hugepage_demands, policy.hugepage, *datum
+            );
+
+            continue;
+        }
+
+        // Stale domain is held at its last statistics until it answers
+        if (datum->stale)
+            continue;
+
+        // Domain's reclaimable memory, unused plus cheaply dropped caches, and
+        // memory limit
+        const std::double_t domain_memory_caches 
+            = reclaimable_caches(*datum, policy);
+        const std::double_t domain_memory_extra = domain_memory_caches 
+            + static_cast<std::double_t>(datum->domain_memory_extra);
         const std::double_t domain_memory_limit = 
             static_cast<std::double_t>(datum->domain_memory_limit);
 
-        // Movement thresholds
+        // Domain's reservation, limit and priority class
+        const manager::reservation::reservation_t &reservation 
+            = reservations[datum->uuid] = policy.reservation.enabled
+            ? manager::reservation::resolve
+              (
+                  state.reservation[datum->uuid], policy.reservation, *datum,
+                  now
+              )
+            : manager::reservation::reservation_t();
+
+        // Outcome of domain's last reclaim or grant judged once settled
+        manager::tuner::judge
+        (
+            state.tuner, policy.tuner, *datum, now, state.metrics
+        );
+
+        // Movement thresholds and fixed step of domain's class
+        const manager::tuner::coefficients_t coefficients
+            = manager::tuner::coefficients
+              (
+                  state.tuner, policy.tuner, reservation.priority_class
+              );
         const std::double_t SUPPLY_THRESHOLD 
-            = SUPPLY_COEFFICIENT * domain_memory_limit;
+            = coefficients.supply * domain_memory_limit;
         const std::double_t DEMAND_THRESHOLD 
-            = DEMAND_COEFFICIENT * domain_memory_limit;
+            = coefficients.demand * domain_memory_limit;
+        const std::double_t CHANGE_STEP 
+            = MINIMUM_DOMAIN_MEMORY * coefficients.change;
+
+        // Domain's balloon controller
+        manager::controller::state_t &controller_state 
+            = state.controller[datum->uuid];
+        const bool use_controller = policy.controller.enabled;
+
+        // Domain's movement phase; a domain leaves steady or cooldown only
+        // once beyond a threshold by the dead band and after its dwell
+        manager::hysteresis::state_t &hysteresis_state 
+            = state.hysteresis[datum->uuid];
+        const std::double_t DEAD_BAND 
+            = policy.hysteresis.dead_band * domain_memory_limit;
+        const std::function<bool (manager::hysteresis::phase, std::double_t)>
+        admitted = [&](manager::hysteresis::phase wanted, std::double_t margin)
+        {
+            return manager::hysteresis::admit
+            (
+                hysteresis_state, policy.hysteresis, wanted, margin, 
+                DEAD_BAND, now, state.metrics
+            );
+        };
+
+        // Domain's working set pressure from fault and swap activity
+        datum->domain_memory_pressure = policy.pressure.enabled
+            ? manager::pressure::score
+              (
+                  state.pressure[datum->uuid], policy.pressure, *datum, now
+              )
+            : 0.0;
+
+        // Domain's vCPU idleness from its CPU time
+        manager::idle::state_t &idle_state = state.idle[datum->uuid];
+        if (policy.idle.enabled)
+        {
+            manager::idle::observe
+            (
+                idle_state, policy.idle, *datum, now, state.metrics
+            );
+        }
+
+        // Domain's reclaimable memory projected from its recent trend of
+        // unused memory
+        manager::forecast::projection_t projection 
+            = policy.forecast.enabled
+            ? manager::forecast::project
+              (
+                  state.forecast[datum->uuid], policy.forecast, *datum
+              )
+            : manager::forecast::projection_t
+              {
+                  static_cast<std::double_t>(datum->domain_memory_extra), false
+              };
+        projection.domain_memory_extra += domain_memory_caches;
+
+        // Domain's virtio-mem device, if any
+        if (policy.hotplug.enabled)
+        {
+            manager::hotplug::refresh
+            (
+                state.hotplug[datum->uuid], policy.hotplug, *datum, now
+            );
+        }
+
+        // Domain still moving toward its last balloon target is left to reach
+        // it before being issued another, and growth still to come is held
+        // for it
+        manager::balloon::state_t &balloon_state = state.balloon[datum->uuid];
+        const bool converging = policy.balloon.enabled 
+            && manager::balloon::converging
+               (
+                   balloon_state, policy.balloon, *datum, now, state.metrics
+               );
+
+        // Domain whose guest ignores a reclaim is bounded from the host
+        if (policy.backstop.enabled)
+        {
+            const manager::backstop::status_code backstop_status
+                = manager::backstop::enforce
+                (
+                    state.backstop[datum->uuid], policy.backstop, 
+                    balloon_state, *datum, state.metrics
+                );
+            if (static_cast<bool>(backstop_status))
+            {
+                util::log::record
+                (
+                    "Unable to bound scope of domain " + datum->uuid,
+                    util::log::type::FLAG
+                );
+            }
+        }
+        if (converging)
+        {
+            pending_growth += std::max<util::stat::slong_t>
+            (
+                balloon_state.target - datum->balloon_memory_used, 0
+            );
+
+            continue;
+        }
+
+        // Domain above its limit gives back the excess (domain loses memory)
+        const util::stat::slong_t domain_memory_ceiling = domain_ceiling
+        (
+            *datum, reservation,
+            manager::hotplug::headroom
+            (
+                state.hotplug, policy.hotplug, datum->uuid
+            )
+        );
+        if (datum->balloon_memory_used > domain_memory_ceiling)
+        {
+            manager::hysteresis::force
+            (
+                hysteresis_state, manager::hysteresis::phase::SHRINKING, now,
+                state.metrics
+            );
+            datum->domain_memory_delta 
+                = domain_memory_ceiling - datum->balloon_memory_used;
+            suppliers.emplace_back(std::move(*datum));
+
+            continue;
+        }
+
+        // Domain under working set pressure needs memory regardless of how
+        // much it reports unused (domain takes memory)
+        if (datum->domain_memory_pressure >= policy.pressure.demand_score)
+        {
+            manager::hysteresis::force
+            (
+                hysteresis_state, manager::hysteresis::phase::GROWING, now,
+                state.metrics
+            );
+            datum->domain_memory_delta = use_controller
+                ? manager::controller::delta
+                  (
+                      controller_state, policy.controller, 
+                      0.0, SUPPLY_THRESHOLD, DEMAND_THRESHOLD
+                  )
+                : CHANGE_STEP;
+            demanders.emplace_back(std::move(*datum));
+
+            continue;
+        }
+
+        // Domain woken from idleness gets back what deep reclaim took at once,
+        // asking again until its balloon reaches the size it had before
+        // (domain takes memory)
+        if (!idle_state.idle 
+            && idle_state.memory_before > datum->balloon_memory_used)
+        {
+            manager::hysteresis::force
+            (
+                hysteresis_state, manager::hysteresis::phase::GROWING, now,
+                state.metrics
+            );
+            datum->domain_memory_delta 
+                = idle_state.memory_before - datum->balloon_memory_used;
+            demanders.emplace_back(std::move(*datum));
+
+            continue;
+        }
+        if (!idle_state.idle)
+            idle_state.memory_before = 0;
+
+        // Idle domain is reclaimed down to its idle floor regardless of how
+        // much it reports unused, and otherwise left alone while idle (domain
+        // loses memory)
+        if (idle_state.idle)
+        {
+            const util::stat::slong_t domain_memory_floor = std::max
+            (
+                manager::idle::reclaim_floor(policy.idle, *datum),
+                domain_floor(reservation)
+            );
+            if (datum->balloon_memory_used <= domain_memory_floor)
+                continue;
+
+            manager::hysteresis::force
+            (
+                hysteresis_state, manager::hysteresis::phase::SHRINKING, now,
+                state.metrics
+            );
+            datum->domain_memory_delta = -1.0 * std::min
+            (
+                policy.idle.step, 
+                datum->balloon_memory_used - domain_memory_floor
+            );
+            suppliers.emplace_back(std::move(*datum));
+
+            continue;
+        }
         
         // Domain can supply memory relative to its limit (domain loses memory)
         if (domain_memory_extra > SUPPLY_THRESHOLD)
         {
-            datum->domain_memory_delta
-                = -1 * MINIMUM_DOMAIN_MEMORY * CHANGE_COEFFICIENT;
+            if (!admitted
+                (
+                    manager::hysteresis::phase::SHRINKING, 
+                    domain_memory_extra - SUPPLY_THRESHOLD
+                ))
+                continue;
+
+            datum->domain_memory_delta = use_controller
+                ? manager::controller::delta
+                  (
+                      controller_state, policy.controller, 
+                      domain_memory_extra, SUPPLY_THRESHOLD, DEMAND_THRESHOLD
+                  )
+                : -1 * CHANGE_STEP;
             suppliers.emplace_back(std::move(*datum));
 
             continue;
@@ -119,30 +745,241 @@ manager::scheduler
         // Domain needs more memory relative to it's limit (domain takes memory)
         if (domain_memory_extra < DEMAND_THRESHOLD)
         {
-            datum->domain_memory_delta 
-                = MINIMUM_DOMAIN_MEMORY * CHANGE_COEFFICIENT;
+            if (!admitted
+                (
+                    manager::hysteresis::phase::GROWING, 
+                    DEMAND_THRESHOLD - domain_memory_extra
+                ))
+                continue;
+
+            datum->domain_memory_delta = use_controller
+                ? manager::controller::delta
+                  (
+                      controller_state, policy.controller, 
+                      domain_memory_extra, SUPPLY_THRESHOLD, DEMAND_THRESHOLD
+                  )
+                : CHANGE_STEP;
             demanders.emplace_back(std::move(*datum));
 
             continue;
         }
+
+        // Domain within its headroom band is projected to need more memory
+        // before long (domain takes memory early)
+        if (projection.domain_memory_extra < DEMAND_THRESHOLD)
+        {
+            if (!admitted
+                (
+                    manager::hysteresis::phase::GROWING, 
+                    DEMAND_THRESHOLD - projection.domain_memory_extra
+                ))
+                continue;
+
+            datum->domain_memory_delta = use_controller
+                ? manager::controller::delta
+                  (
+                      controller_state, policy.controller, 
+                      projection.domain_memory_extra, 
+                      SUPPLY_THRESHOLD, DEMAND_THRESHOLD
+                  )
+                : CHANGE_STEP;
+            demanders.emplace_back(std::move(*datum));
+
+            continue;
+        }
+
+        // Domain within its headroom band has memory use in sustained decline
+        // (domain loses memory early)
+        if (projection.declining 
+            && projection.domain_memory_extra > SUPPLY_THRESHOLD)
+        {
+            if (!admitted
+                (
+                    manager::hysteresis::phase::SHRINKING, 
+                    projection.domain_memory_extra - SUPPLY_THRESHOLD
+                ))
+                continue;
+
+            datum->domain_memory_delta = use_controller
+                ? manager::controller::delta
+                  (
+                      controller_state, policy.controller, 
+                      projection.domain_memory_extra, 
+                      SUPPLY_THRESHOLD, DEMAND_THRESHOLD
+                  )
+                : -1 * CHANGE_STEP;
+            suppliers.emplace_back(std::move(*datum));
+
+            continue;
+        }
+
+        // Domain is within its headroom band
+        manager::controller::settle(controller_state, datum->uuid);
+        manager::hysteresis::settle
+        (
+            hysteresis_state, policy.hysteresis, now, state.metrics
+        );
     }
     domain_data.clear();
- 
-    // Save the number of domains needing memory
-    std::size_t number_of_requesting_domains = demanders.size();
+
+    // Publish forecast accuracy for horizon tuning
+    if (policy.forecast.enabled)
+    {
+        manager::forecast::export_accuracy
+        (
+            state.forecast, policy.forecast, state.metrics
+        );
+    }
+
+    // Publish balloon response of domains
+    if (policy.balloon.enabled)
+        manager::balloon::export_response(state.balloon, state.metrics);
+
+    // Publish idle domains
+    if (policy.idle.enabled)
+        manager::idle::export_idle(state.idle, state.metrics);
+
+    // Publish domains bounded from the host
+    if (policy.backstop.enabled)
+        manager::backstop::export_engaged(state.backstop, state.metrics);
+
+    // Publish movement coefficients of each class
+    if (policy.tuner.enabled)
+    {
+        manager::tuner::export_coefficients
+        (
+            state.tuner, policy.tuner, state.metrics
+        );
+    }
+
+    // Hugepage pools follow hugepage backed domains
+    if (policy.hugepage.enabled)
+    {
+        const manager::hugepage::status_code pool_status 
+            = manager::hugepage::balance
+            (
+                state.hugepage, policy.hugepage, hugepage_demands, 
+                state.metrics
+            );
+        if (static_cast<bool>(pool_status))
+        {
+            util::log::record
+            (
+                "Unable to size hugepage pools",
+                util::log::type::FLAG
+            );
+        }
+    }
+
+    // Fragmentation of host memory
+    bool fragmentation_sampled = false;
+    if (policy.compaction.enabled)
+    {
+        fragmentation_sampled = !static_cast<bool>
+        (
+            manager::compaction::sample
+            (
+                state.compaction, policy.compaction, state.metrics
+            )
+        );
+        if (!fragmentation_sampled)
+        {
+            util::log::record
+            (
+                "Unable to sample memory fragmentation",
+                util::log::type::FLAG
+            );
+        }
+    }
 
 
     /********************** RECLAIM MEMORY FROM SUPPLIERS *********************/
      
-    // System reclaiming memory from supplying domains
-    libvirt::status_code status;
+    // Memory already granted is not given out twice
+    available_memory = std::max<util::stat::slong_t>
+    (
+        available_memory - pending_growth, 0
+    );
+
+    // Guest memory the host swapped out must come back before any is given
+    if (policy.swap.enabled)
+    {
+        available_memory = std::max<util::stat::slong_t>
+        (
+            available_memory
+                - manager::swap::debt(state.swap, policy.swap, now), 0
+        );
+        manager::swap::export_activity(state.swap, state.metrics);
+    }
+
+    // Memory demanders would take were none short
+    util::stat::slong_t demanded_memory = 0;
+    for (const libvirt::domain::datum_t &datum: demanders)
+    {
+        const util::stat::slong_t domain_memory_ceiling = domain_ceiling
+        (
+            datum, reservations.at(datum.uuid),
+            manager::hotplug::headroom
+            (
+                state.hotplug, policy.hotplug, datum.uuid
+            )
+        );
+
+        demanded_memory += std::clamp<util::stat::slong_t>
+        (
+            datum.domain_memory_delta, 
+            0, 
+            std::max<util::stat::slong_t>
+            (
+                domain_memory_ceiling - datum.balloon_memory_used, 0
+            )
+        );
+    }
+
+    // KSM scans faster while memory is short and slower while plentiful
+    if (policy.deduplication.enabled)
+    {
+        const manager::deduplication::status_code tuning_status 
+            = manager::deduplication::tune
+            (
+                state.deduplication, policy.deduplication, 
+                available_memory - demanded_memory, hardware_datum.memory_limit
+            );
+        if (static_cast<bool>(tuning_status))
+        {
+            util::log::record
+            (
+                "Unable to tune KSM scan rate",
+                util::log::type::FLAG
+            );
+        }
+
+        manager::deduplication::export_savings
+        (
+            state.deduplication, state.metrics
+        );
+    }
+
+    // Balloon targets of supplying domains by priority class; memory above a 
+    // limit, and memory of idle domains, is always taken back
+    std::map
+    <
+        manager::reservation::priority, 
+        manager::actuator::requests_t
+    > reclaim_tiers;
+    libvirt::domain::uuid_set_t untuned_reclaims;
     for (const libvirt::domain::datum_t &datum: suppliers)
     {
-        // Domain memory footprint with change
+        const manager::reservation::reservation_t &reservation 
+            = reservations.at(datum.uuid);
+
+        // Domain memory footprint with change, never below reservation
         util::stat::slong_t memory_chunk = datum.balloon_memory_used
                                          + datum.domain_memory_delta;
-        if (memory_chunk < MINIMUM_DOMAIN_MEMORY)
-            memory_chunk = MINIMUM_DOMAIN_MEMORY;
+        if (memory_chunk < domain_floor(reservation))
+            memory_chunk = domain_floor(reservation);
+        if (memory_chunk >= datum.balloon_memory_used)
+            continue;
 
         // Check feasibilty of reallocation
         const util::stat::slong_t resultant_available_memory
@@ -157,168 +994,402 @@ manager::scheduler
 
             return EXIT_FAILURE;
         }
-        
-        // Take back memory if from supplying domain
-        status = libvirt::virDomainSetMemory
+
+        const bool above_limit = datum.balloon_memory_used > domain_ceiling
         (
-            datum.domain.get(), 
-            static_cast<util::stat::ulong_t>(memory_chunk)
-        );
-        if (static_cast<bool>(status))
-        {
-            util::log::record
+            datum, reservation,
+            manager::hotplug::headroom
             (
-                "Unable to set domain " + datum.uuid
-                    + "'s memory to " + std::to_string(memory_chunk) 
-                    + " bytes",
-                util::log::type::FLAG
-            );
+                state.hotplug, policy.hotplug, datum.uuid
+            )
+        );
+        const manager::idle::table_t::const_iterator idle_entry
+            = state.idle.find(datum.uuid);
+        const bool idle = policy.idle.enabled
+            && idle_entry != state.idle.end() && idle_entry->second.idle;
+        const manager::reservation::priority tier = above_limit || idle
+            ? manager::reservation::priority::BEST_EFFORT
+            : reservation.priority_class;
+        reclaim_tiers[tier].push_back({&datum, memory_chunk});
 
-            continue;
-        }
-        available_memory = resultant_available_memory; 
+        // Reclaims the thresholds did not decide are not judged
+        if (above_limit || idle)
+            untuned_reclaims.insert(datum.uuid);
     }
 
- 
-    /**************** PRIOTITZE DEMANDERS BY MEMORY PRESSURE ******************/
-
-    // Sort by memory pressure per vCPU in non-increasing order to prioritize 
-    // domains that require the most memory per vCPU
-    std::sort
+    // System reclaiming memory from supplying domains, best-effort classes
+    // and idle domains first; more protected classes give up memory only
+    // while demand is unmet, cheapest reclaims first, and every reclaim
+    // finishes before any grant is issued
+    manager::actuator::outcomes_t outcomes;
+    manager::status_code status;
+    for 
     (
-        demanders.begin(), demanders.end(), [] 
+        auto tier = reclaim_tiers.rbegin(); 
+        tier != reclaim_tiers.rend(); 
+        ++tier
+    )
+    {
+        if (tier->first != manager::reservation::priority::BEST_EFFORT
+            && available_memory >= demanded_memory)
+            break;
+
+        // Domains with the most reclaimable memory lose least by giving up
+        manager::actuator::requests_t &reclaims = tier->second;
+        std::sort
         (
-            const libvirt::domain::datum_t &datum_A, 
-            const libvirt::domain::datum_t &datum_B
-        )
-        {
-            std::double_t pressure_per_vCPU_A 
-                = datum_A.domain_memory_delta 
-                / datum_A.number_of_vCPUs;
+            reclaims.begin(), reclaims.end(), [&policy]
+            (
+                const manager::actuator::request_t &reclaim_A,
+                const manager::actuator::request_t &reclaim_B
+            )
+            {
+                const std::double_t share_A 
+                    = reclaimable_share(*reclaim_A.datum, policy);
+                const std::double_t share_B 
+                    = reclaimable_share(*reclaim_B.datum, policy);
+                if (share_A != share_B)
+                    return share_A > share_B;
 
-            std::double_t pressure_per_vCPU_B
-                = datum_B.domain_memory_delta 
-                / datum_B.number_of_vCPUs;
+                return reclaim_A.datum->uuid < reclaim_B.datum->uuid;
+            }
+        );
 
-            return pressure_per_vCPU_A > pressure_per_vCPU_B;
+        // Protected classes give up only what covers unmet demand
+        if (tier->first != manager::reservation::priority::BEST_EFFORT)
+        {
+            util::stat::slong_t planned = 0;
+            std::size_t number_of_reclaims = 0;
+            while (number_of_reclaims < reclaims.size()
+                   && available_memory + planned < demanded_memory)
+            {
+                const manager::actuator::request_t &reclaim 
+                    = reclaims[number_of_reclaims++];
+                planned += reclaim.datum->balloon_memory_used 
+                         - reclaim.memory_chunk;
+            }
+            reclaims.resize(number_of_reclaims);
         }
-    );
 
+        // Large reclaims unplug virtio-mem blocks instead of ballooning
+        manager::hotplug::route(state.hotplug, policy.hotplug, reclaims);
 
-    /*********************** PROVIDE MEMORY TO CONSUMERS **********************/
+        status = manager::actuator::apply(reclaims, policy.actuation, outcomes);
+        if (static_cast<bool>(status))
+            return EXIT_FAILURE;
 
-    // System providing memory to requesting domains
-    for (const libvirt::domain::datum_t &datum: demanders)
-    {   
-        util::stat::slong_t maximum_chunk_size = datum.domain_memory_limit;
-
-        // Requesting memory size is satisfiable by system
-        std::double_t domain_memory_delta = datum.domain_memory_delta;
-        if (std::abs(domain_memory_delta) < available_memory)
-        {   
-            util::stat::slong_t memory_chunk 
-                = datum.balloon_memory_used + domain_memory_delta;
-
-            // Memory chunk is limited by domain's set limit
-            if (memory_chunk > maximum_chunk_size)
-                memory_chunk = maximum_chunk_size;
-
-            // Check feasibilty of reallocation
-            const util::stat::slong_t resultant_available_memory
-                = available_memory - memory_chunk + datum.balloon_memory_used;
-            if (resultant_available_memory < 0 || memory_chunk < 0)
-            {
-                util::log::record
-                (
-                    "Currupted domain memory usage totals",
-                    util::log::type::ERROR
-                );
+        // Only memory actually taken back is made available
+        for (std::size_t index = 0; index < reclaims.size(); ++index)
+        {
+            if (outcomes[index].status != util::task::outcome::SUCCESS)
+                continue;
 
-                return EXIT_FAILURE;
-            }
-            
-            // Give memory to domain consuming
-            status = libvirt::virDomainSetMemory
+            const manager::actuator::request_t &reclaim = reclaims[index];
+            const util::stat::slong_t memory_change
+                = reclaim.memory_chunk - reclaim.datum->balloon_memory_used;
+
+            available_memory -= memory_change;
+            charge_cells(cells_memory, *reclaim.datum, memory_change);
+            manager::hotplug::commit(state.hotplug, reclaim);
+            manager::balloon::issue
             (
-                datum.domain.get(), 
-                static_cast<util::stat::ulong_t>(memory_chunk)
+                state.balloon[reclaim.datum->uuid], 
+                reclaim.datum->balloon_memory_used, reclaim.memory_chunk, now
             );
-            if (static_cast<bool>(status))
+            if (untuned_reclaims.find(reclaim.datum->uuid) 
+                == untuned_reclaims.end())
             {
-                util::log::record
+                manager::tuner::watch
                 (
-                    "Unable to set domain " + datum.uuid
-                        + "'s memory to " + std::to_string(memory_chunk) 
-                        + " bytes",
-                    util::log::type::FLAG
+                    state.tuner, policy.tuner, *reclaim.datum, 
+                    reservations.at(reclaim.datum->uuid).priority_class,
+                    manager::tuner::action::RECLAIM, now
                 );
-
-                continue;
             }
-            available_memory = resultant_available_memory;
+        }
+    }
+
+    // Growing balloons while the host swaps guest memory back in only pushes
+    // more of it out again
+    if (policy.swap.enabled && state.swap.holding)
+        return EXIT_SUCCESS;
 
-            // Single domain served per iteration
-            if (number_of_requesting_domains > 1)
-                --number_of_requesting_domains;
 
+    /****************** GROUP DEMANDERS BY NUMA PLACEMENT *********************/
+
+    // Domains placed on a single NUMA node divide the free memory of their
+    // node first, then domains spanning nodes divide what is left
+    std::map<libvirt::hardware::cell_t, std::vector<std::size_t>> cell_groups;
+    std::vector<std::size_t> spanning_group;
+    for (std::size_t index = 0; index < demanders.size(); ++index)
+    {
+        const libvirt::domain::cell_set_t &cells = demanders[index].cells;
+        if (cells.size() == 1 && *cells.begin() >= 0 
+            && static_cast<std::size_t>(*cells.begin()) < cells_memory.size())
+        {
+            cell_groups[*cells.begin()].push_back(index);
             continue;
         }
 
-        // Equally split remaining if size not satisfiable
-        util::stat::ulong_t partitioned_memory_chunk = std::ceil
+        spanning_group.push_back(index);
+    }
+
+
+    /*********************** PROVIDE MEMORY TO CONSUMERS **********************/
+
+    // Balloon targets of requesting domains from max-min fair division
+    manager::actuator::requests_t grants;
+    grants.reserve(demanders.size());
+    for (const auto &[cell, group]: cell_groups)
+    {
+        const util::stat::slong_t cell_supply = std::min
         (
-            static_cast<std::double_t>(std::abs(available_memory))
-                / number_of_requesting_domains
+            available_memory,
+            std::max<util::stat::slong_t>(cells_memory[cell], 0)
         );
-        bool domains_requesting = number_of_requesting_domains > 0;
-
-        if (domains_requesting && partitioned_memory_chunk < available_memory)
-        {   
-            util::stat::slong_t memory_chunk = datum.balloon_memory_used
-                + (domain_memory_delta / number_of_requesting_domains);
-            
-            // Memory chunk is limited by domain's set limit
-            if (memory_chunk > maximum_chunk_size)
-                memory_chunk = maximum_chunk_size;
-
-            // Check feasibilty of reallocation
-            const util::stat::slong_t resultant_available_memory
-                = available_memory - memory_chunk + datum.balloon_memory_used;
-            if (resultant_available_memory < 0 || memory_chunk < 0)
-            {
-                util::log::record
-                (
-                    "Currupted domain memory usage totals",
-                    util::log::type::ERROR
-                );
+        available_memory -= provide
+        (
+            demanders, group, cell_supply, 
+            policy, reservations, state.hotplug, cells_memory, grants
+        );
+    }
+    available_memory -= provide
+    (
+        demanders, spanning_group, available_memory, 
+        policy, reservations, state.hotplug, cells_memory, grants
+    );
 
-                return EXIT_FAILURE;
-            }
+    // System providing memory to requesting domains; large grants plug
+    // virtio-mem blocks instead of ballooning
+    manager::hotplug::route(state.hotplug, policy.hotplug, grants);
+
+    status = manager::actuator::apply(grants, policy.actuation, outcomes);
+    if (static_cast<bool>(status))
+        return EXIT_FAILURE;
 
-            // Give memory to domain consuming
-            status = libvirt::virDomainSetMemory
+    for (std::size_t index = 0; index < grants.size(); ++index)
+    {
+        if (outcomes[index].status != util::task::outcome::SUCCESS)
+            continue;
+
+        const manager::actuator::request_t &grant = grants[index];
+        manager::hotplug::commit(state.hotplug, grant);
+        manager::balloon::issue
+        (
+            state.balloon[grant.datum->uuid], 
+            grant.datum->balloon_memory_used, grant.memory_chunk, now
+        );
+
+        // Grants forced by working set pressure are not judged
+        if (grant.datum->domain_memory_pressure < policy.pressure.demand_score)
+        {
+            manager::tuner::watch
             (
-                datum.domain.get(), 
-                static_cast<util::stat::ulong_t>(memory_chunk)
+                state.tuner, policy.tuner, *grant.datum, 
+                reservations.at(grant.datum->uuid).priority_class,
+                manager::tuner::action::GRANT, now
             );
-            if (static_cast<bool>(status))
-            {
-                util::log::record
-                (
-                    "Unable to set domain " + datum.uuid
-                        + "'s memory to " + std::to_string(memory_chunk) 
-                        + " bytes",
-                    util::log::type::ERROR
-                );
+        }
+    }
+
+    // Fragmented nodes are compacted only while no grant is in flight, such
+    // that compaction never competes with balloons deflating
+    if (fragmentation_sampled && grants.empty() && pending_growth == 0)
+    {
+        status = manager::compaction::compact
+        (
+            state.compaction, policy.compaction, now, state.metrics
+        );
+        if (static_cast<bool>(status))
+        {
+            util::log::record
+            (
+                "Unable to compact fragmented memory",
+                util::log::type::FLAG
+            );
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
 
-                return EXIT_FAILURE;
-            }           
-            available_memory = resultant_available_memory;
 
-            // Single domain served per iteration
-            if (number_of_requesting_domains > 1)
-                --number_of_requesting_domains;
+/**
+ *  @brief Emergency Memory Reclaimer
+ *
+ *  @param domain data: Collection of data about domains for reclaimer's 
+ *                      required reallocation policies
+ *  @param policy:      Scheduler tunables
+ *  @param state:       Scheduler state carried between iterations
+ *
+ *  @details Takes memory back from the domains with the most unused memory
+ *  when the host itself comes under memory pressure between scheduler
+ *  iterations, without providing memory to any domain.
+ *
+ *  Only supplying domains not still converging on an earlier balloon
+ *  target are considered; best-effort domains are taken from
+ *  before more protected classes, and within a class the largest by how far 
+ *  their reclaimable memory, unused memory plus the configured fraction of 
+ *  their disk caches, is above the middle of their headroom band have their
+ *  balloons inflated straight down to that middle, but never below their
+ *  reservation.
+ *
+ *  @return execution status code
+ */
+manager::status_code
+manager::reclaimer
+(
+          libvirt::domain::data_t &domain_data, 
+    const manager::policy_t       &policy,
+          manager::state_t        &state
+)
+{
+    // Check domain consistency 
+    if (domain_data.empty())
+    {
+        util::log::record
+        (
+            "Domain data is empty and unavailable",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+
+    /*********************** DETERMINE SUPPLIERS' SURPLUS *********************/
+
+    // Surplus memory above middle of headroom band for supplying domains
+    using surplus_t = std::pair<std::double_t, libvirt::domain::datum_t *>;
+    std::vector<surplus_t> surplus;
+    surplus.reserve(domain_data.size());
+    manager::reservation::reservations_t reservations;
+    const std::chrono::steady_clock::time_point now = state.clock();
+    for (libvirt::domain::datum_t &datum: domain_data)
+    {
+        // Hugepage backed and stale domains are not ballooned
+        if (datum.hugepage_size != 0 || datum.stale)
+            continue;
+
+        // Domain still moving toward its last balloon target is left to reach
+        // it, as in the scheduler, rather than being issued another
+        const bool converging = policy.balloon.enabled 
+            && manager::balloon::converging
+               (
+                   state.balloon[datum.uuid], policy.balloon, datum, now, 
+                   state.metrics
+               );
+        if (converging)
+            continue;
+
+        reservations[datum.uuid] = policy.reservation.enabled
+            ? manager::reservation::resolve
+              (
+                  state.reservation[datum.uuid], policy.reservation, datum,
+                  now
+              )
+            : manager::reservation::reservation_t();
+
+        const std::double_t domain_memory_extra = reclaimable_caches
+        (
+            datum, policy
+        ) + static_cast<std::double_t>(datum.domain_memory_extra);
+        const std::double_t domain_memory_limit = 
+            static_cast<std::double_t>(datum.domain_memory_limit);
+
+        const manager::tuner::coefficients_t coefficients
+            = manager::tuner::coefficients
+              (
+                  state.tuner, policy.tuner, 
+                  reservations.at(datum.uuid).priority_class
+              );
+        const std::double_t SUPPLY_THRESHOLD 
+            = coefficients.supply * domain_memory_limit;
+        const std::double_t DEMAND_THRESHOLD 
+            = coefficients.demand * domain_memory_limit;
+
+        if (domain_memory_extra <= SUPPLY_THRESHOLD)
+            continue;
+
+        surplus.emplace_back
+        (
+            domain_memory_extra - (SUPPLY_THRESHOLD + DEMAND_THRESHOLD) / 2, 
+            &datum
+        );
+    }
+
+    // Least protected classes first, then largest suppliers
+    std::sort
+    (
+        surplus.begin(), surplus.end(), [&reservations] 
+        (
+            const surplus_t &surplus_A, 
+            const surplus_t &surplus_B
+        )
+        {
+            const manager::reservation::priority priority_A
+                = reservations.at(surplus_A.second->uuid).priority_class;
+            const manager::reservation::priority priority_B
+                = reservations.at(surplus_B.second->uuid).priority_class;
+            if (priority_A != priority_B)
+                return priority_A > priority_B;
+
+            return surplus_A.first > surplus_B.first;
         }
+    );
+    if (surplus.size() > policy.emergency_suppliers)
+        surplus.resize(policy.emergency_suppliers);
+
+
+    /********************** RECLAIM MEMORY FROM SUPPLIERS *********************/
+
+    // Balloon targets of largest suppliers
+    manager::actuator::requests_t reclaims;
+    reclaims.reserve(surplus.size());
+    for (const auto &[domain_memory_surplus, datum]: surplus)
+    {
+        // Domain memory footprint with surplus removed, never below reservation
+        const util::stat::slong_t domain_memory_floor
+            = domain_floor(reservations.at(datum->uuid));
+        util::stat::slong_t memory_chunk = datum->balloon_memory_used
+                                         - domain_memory_surplus;
+        if (memory_chunk < domain_memory_floor)
+            memory_chunk = domain_memory_floor;
+        if (memory_chunk >= datum->balloon_memory_used)
+            continue;
+
+        reclaims.push_back({datum, memory_chunk});
+    }
+
+    // Take back memory from supplying domains
+    manager::actuator::outcomes_t outcomes;
+    manager::status_code status
+        = manager::actuator::apply(reclaims, policy.actuation, outcomes);
+    if (static_cast<bool>(status))
+        return EXIT_FAILURE;
+
+    for (std::size_t index = 0; index < reclaims.size(); ++index)
+    {
+        if (outcomes[index].status != util::task::outcome::SUCCESS)
+            continue;
+
+        const manager::actuator::request_t &reclaim = reclaims[index];
+        manager::balloon::issue
+        (
+            state.balloon[reclaim.datum->uuid], 
+            reclaim.datum->balloon_memory_used, reclaim.memory_chunk,
+            state.clock()
+        );
+
+        util::log::record
+        (
+            "Emergency reclaim of "
+                + std::to_string
+                  (
+                      reclaim.datum->balloon_memory_used - reclaim.memory_chunk
+                  )
+                + " KiB from domain " + reclaim.datum->uuid
+        );
     }
 
     return EXIT_SUCCESS;
@@ -5,12 +5,15 @@
 #include <stat/statistics.hpp>
 
 #include "domain/domain.hpp"
+#include "hardware/hardware.hpp"
+
+#include "policy.hpp"
 
 
 /**
  *  @brief Memory Scheduler Header
  *
- *  @details Defines scheduler's rountine
+ *  @details Defines scheduler's and emergency reclaimer's rountines
  */
 namespace manager 
 {
@@ -21,8 +24,19 @@ using status_code = std::uint8_t;
 status_code
 scheduler
 (
-    libvirt::domain::data_t &domain_data,
-    util::stat::slong_t      hardware_memory_limit
+          libvirt::domain::data_t    &domain_data,
+    const libvirt::hardware::datum_t &hardware_datum,
+    const policy_t                   &policy,
+          state_t                    &state
+);
+
+[[nodiscard("Reclaimer exit status must be checked")]]
+status_code
+reclaimer
+(
+          libvirt::domain::data_t &domain_data,
+    const policy_t                &policy,
+          state_t                 &state
 );
 
 } // manager namespace
@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
+
+#include <log/record.hpp>
+#include <metric/registry.hpp>
+#include <stat/statistics.hpp>
+
+#include "vm/vm.hpp"
+
+#include "swap.hpp"
+
+
+/**
+ *  @brief Counter Rate Between Iterations
+ *
+ *  @param current:  counter value this iteration
+ *  @param previous: counter value last iteration
+ *  @param seconds:  time elapsed between both values
+ *
+ *  @return counter change per second; zero when counter went backwards
+ */
+std::double_t
+static rate
+(
+    util::stat::slong_t current,
+    util::stat::slong_t previous,
+    std::double_t       seconds
+) noexcept
+{
+    if (current < previous || seconds <= 0)
+        return 0.0;
+
+    return static_cast<std::double_t>(current - previous) / seconds;
+}
+
+
+/**
+ *  @brief Host Swap Debt
+ *
+ *  @param state:      host counters from last iteration
+ *  @param parameters: swap tunables
+ *  @param now:        time of this iteration
+ *
+ *  @details Domains' balloon sizes count guest memory the host has swapped
+ *  out as though it were resident, so host memory is overstated by the swap
+ *  in use, less pages also still cached in memory, plus the memory the zswap
+ *  pool holds compressed pages in. That debt, scaled by the debit fraction,
+ *  is taken off host memory.
+ *
+ *  Grants are held while the host swap in rate is above threshold and no
+ *  lower than last iteration, as growing balloons would only push more guest
+ *  memory out to swap. Unreadable counters neither debit nor hold.
+ *
+ *  @return memory owed by host in KiB
+ */
+util::stat::slong_t
+manager::swap::debt
+(
+          manager::swap::state_t                &state,
+    const manager::swap::parameters_t           &parameters,
+    const std::chrono::steady_clock::time_point &now
+) noexcept
+{
+    os::vm::datum_t datum;
+    os::vm::status_code status = os::vm::read
+    (
+        parameters.meminfo_path, parameters.vmstat_path, datum
+    );
+    if (static_cast<bool>(status))
+    {
+        state.sampled = false;
+        state.holding = false;
+
+        return 0;
+    }
+
+    // Paging rates since last iteration
+    const std::double_t previous_swap_in_rate = state.swap_in_rate;
+    if (state.sampled)
+    {
+        const std::double_t seconds 
+            = std::chrono::duration<std::double_t>(now - state.sampled_at)
+              .count();
+
+        state.swap_in_rate  
+            = rate(datum.swap_in,  state.datum.swap_in,  seconds);
+        state.swap_out_rate 
+            = rate(datum.swap_out, state.datum.swap_out, seconds);
+        state.major_fault_rate 
+            = rate(datum.major_faults, state.datum.major_faults, seconds);
+    }
+
+    state.datum      = datum;
+    state.sampled    = true;
+    state.sampled_at = now;
+
+    // Hold grants while swap in rises
+    const bool holding = state.swap_in_rate >= parameters.swap_in_threshold
+                      && state.swap_in_rate >= previous_swap_in_rate;
+    if (holding && !state.holding)
+    {
+        util::log::record
+        (
+            "Host swap in rising at " + std::to_string(state.swap_in_rate)
+                + " pages/s; holding memory grants",
+            util::log::type::FLAG
+        );
+    }
+    state.holding = holding;
+
+    const util::stat::slong_t swapped = std::max<util::stat::slong_t>
+    (
+        datum.swap_total - datum.swap_free - datum.swap_cached, 0
+    );
+
+    return static_cast<util::stat::slong_t>
+    (
+        parameters.debit * (swapped + datum.zswap)
+    );
+}
+
+
+/**
+ *  @brief Host Swap Metric Exporter
+ *
+ *  @param state:    host counters of this iteration
+ *  @param registry: registry to publish metrics to
+ */
+void
+manager::swap::export_activity
+(
+    const manager::swap::state_t   &state,
+          util::metric::registry_t &registry
+) noexcept
+{
+    if (!state.sampled)
+        return;
+
+    util::metric::set
+    (
+        registry, "memoryman_host_swap_used_kib",
+        "Host swap in use in KiB", {},
+        static_cast<std::double_t>
+        (
+            state.datum.swap_total - state.datum.swap_free
+        )
+    );
+    util::metric::set
+    (
+        registry, "memoryman_host_zswap_pool_kib",
+        "Host memory holding zswap compressed pages in KiB", {},
+        static_cast<std::double_t>(state.datum.zswap)
+    );
+    util::metric::set
+    (
+        registry, "memoryman_host_zswapped_kib",
+        "Host memory stored compressed in zswap in KiB", {},
+        static_cast<std::double_t>(state.datum.zswapped)
+    );
+    util::metric::set
+    (
+        registry, "memoryman_host_swap_in_rate",
+        "Host pages swapped in per second", {},
+        state.swap_in_rate
+    );
+    util::metric::set
+    (
+        registry, "memoryman_host_swap_out_rate",
+        "Host pages swapped out per second", {},
+        state.swap_out_rate
+    );
+    util::metric::set
+    (
+        registry, "memoryman_host_major_fault_rate",
+        "Host major page faults per second", {},
+        state.major_fault_rate
+    );
+    util::metric::set
+    (
+        registry, "memoryman_host_grants_held",
+        "Whether memory grants are held for host swap in", {},
+        state.holding ? 1.0 : 0.0
+    );
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <string>
+
+#include <metric/registry.hpp>
+#include <stat/statistics.hpp>
+
+#include "vm/vm.hpp"
+
+
+/**
+ *  @brief Host Swap Header
+ *
+ *  @details Defines the accounting of guest memory the host has swapped out
+ *  and the hold on grants while the host swaps it back in
+ */
+namespace manager
+{
+
+namespace swap
+{
+
+// Tunables; debit is the fraction of swapped guest memory taken off host
+// memory, swap in threshold in pages per second
+typedef struct parameters_t
+{
+    bool          enabled           = false;
+    std::string   meminfo_path      = "/proc/meminfo";
+    std::string   vmstat_path       = "/proc/vmstat";
+    std::double_t debit             = 1.000;
+    std::double_t swap_in_threshold = 256.0;
+} parameters_t;
+
+// Host paging counters and rates kept between load balancer iterations
+typedef struct state_t
+{
+    os::vm::datum_t                       datum;
+    bool                                  sampled          = false;
+    std::chrono::steady_clock::time_point sampled_at;
+    std::double_t                         swap_in_rate     = 0.0;
+    std::double_t                         swap_out_rate    = 0.0;
+    std::double_t                         major_fault_rate = 0.0;
+    bool                                  holding          = false;
+} state_t;
+
+// Swap routines
+[[nodiscard("Must use memory debited to call")]]
+util::stat::slong_t
+debt
+(
+          state_t                               &state,
+    const parameters_t                          &parameters,
+    const std::chrono::steady_clock::time_point &now
+) noexcept;
+
+void
+export_activity
+(
+    const state_t                  &state,
+          util::metric::registry_t &registry
+) noexcept;
+
+} // swap namespace
+
+} // manager namespace
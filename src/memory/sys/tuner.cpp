@@ -0,0 +1,379 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <string>
+#include <utility>
+
+#include <log/record.hpp>
+#include <metric/registry.hpp>
+#include <stat/statistics.hpp>
+
+#include "domain/domain.hpp"
+
+#include "reservation.hpp"
+#include "tuner.hpp"
+
+
+/**
+ *  @brief Priority Class Name
+ *
+ *  @param priority class: class to name
+ *
+ *  @return class name as configured
+ */
+std::string
+static class_name
+(
+    manager::reservation::priority priority_class
+)
+{
+    switch (priority_class)
+    {
+        case manager::reservation::priority::LATENCY_CRITICAL:
+            return "latency-critical";
+        case manager::reservation::priority::GUARANTEED:
+            return "guaranteed";
+        default:
+            return "best-effort";
+    }
+}
+
+
+/**
+ *  @brief Coefficient Mover
+ *
+ *  @param coefficient:    coefficient to move
+ *  @param moved:          value to move coefficient to
+ *  @param name:           coefficient name
+ *  @param priority class: class coefficient belongs to
+ *  @param evidence:       outcomes behind move
+ *  @param registry:       registry to count moves in
+ *
+ *  @details Logs every move along with the evidence behind it
+ */
+void
+static move
+(
+          std::double_t                   &coefficient,
+          std::double_t                    moved,
+    const std::string                     &name,
+          manager::reservation::priority   priority_class,
+    const std::string                     &evidence,
+          util::metric::registry_t        &registry
+)
+{
+    if (std::abs(moved - coefficient) < 1e-9)
+        return;
+
+    util::log::record
+    (
+        "Tuned " + class_name(priority_class) + " " + name
+            + " coefficient from " + std::to_string(coefficient) + " to "
+            + std::to_string(moved) + " after " + evidence
+    );
+    util::metric::increment
+    (
+        registry, "memoryman_tuner_adjustments_total",
+        "Movement coefficient adjustments from judged outcomes",
+        {
+            {"class", class_name(priority_class)}, {"coefficient", name},
+            {"direction", moved > coefficient ? "up" : "down"}
+        }
+    );
+
+    coefficient = moved;
+}
+
+
+/**
+ *  @brief Class Coefficient Adjuster
+ *
+ *  @param state:          tuner state
+ *  @param parameters:     tuner tunables
+ *  @param priority class: class whose window of outcomes is complete
+ *  @param registry:       registry to count moves in
+ *
+ *  @details Reclaims followed by guest swap-in raise the supply threshold,
+ *  keeping more headroom before memory is taken back, and grants left unused
+ *  lower the demand threshold, asking for memory later. Either shrinks the
+ *  fixed step. A class doing well on both loosens back by the same step, and
+ *  the supply threshold is always kept the gap above the demand threshold.
+ */
+void
+static adjust
+(
+          manager::tuner::state_t        &state,
+    const manager::tuner::parameters_t   &parameters,
+          manager::reservation::priority  priority_class,
+          util::metric::registry_t       &registry
+)
+{
+    const manager::tuner::evidence_t &evidence
+        = state.evidence[priority_class];
+    manager::tuner::coefficients_t &coefficients
+        = state.coefficients.try_emplace
+          (
+              priority_class, parameters.coefficients
+          ).first->second;
+
+    const std::double_t swapped_share = evidence.reclaims > 0
+        ? static_cast<std::double_t>(evidence.swapped) / evidence.reclaims
+        : 0.0;
+    const std::double_t unused_share = evidence.grants > 0
+        ? static_cast<std::double_t>(evidence.unused) / evidence.grants
+        : 0.0;
+    const bool swapping = swapped_share > parameters.target;
+    const bool wasting  = unused_share  > parameters.target;
+    const std::string description
+        = std::to_string(evidence.swapped) + " of "
+        + std::to_string(evidence.reclaims)
+        + " reclaims were followed by guest swap-in and "
+        + std::to_string(evidence.unused) + " of "
+        + std::to_string(evidence.grants) + " grants were left unused";
+
+    manager::tuner::coefficients_t moved = coefficients;
+    if (evidence.reclaims > 0 && swapping)
+        moved.supply += parameters.step;
+    else if (evidence.reclaims > 0 && swapped_share < parameters.target / 2)
+        moved.supply -= parameters.step;
+
+    if (evidence.grants > 0 && wasting)
+        moved.demand -= parameters.step;
+    else if (evidence.grants > 0 && unused_share < parameters.target / 2)
+        moved.demand += parameters.step;
+
+    if (swapping || wasting)
+        moved.change -= parameters.step;
+    else if (evidence.reclaims > 0 && evidence.grants > 0
+             && swapped_share < parameters.target / 2
+             && unused_share  < parameters.target / 2)
+        moved.change += parameters.step;
+
+    // Coefficients stay within their bounds and the headroom band open
+    moved.supply = std::clamp
+    (
+        moved.supply, parameters.lower.supply, parameters.upper.supply
+    );
+    moved.demand = std::clamp
+    (
+        std::min(moved.demand, moved.supply - parameters.gap),
+        parameters.lower.demand, parameters.upper.demand
+    );
+    moved.change = std::clamp
+    (
+        moved.change, parameters.lower.change, parameters.upper.change
+    );
+
+    move
+    (
+        coefficients.supply, moved.supply, "supply", priority_class,
+        description, registry
+    );
+    move
+    (
+        coefficients.demand, moved.demand, "demand", priority_class,
+        description, registry
+    );
+    move
+    (
+        coefficients.change, moved.change, "change", priority_class,
+        description, registry
+    );
+
+    state.evidence[priority_class] = manager::tuner::evidence_t();
+}
+
+
+/**
+ *  @brief Class Coefficients
+ *
+ *  @param state:          tuner state
+ *  @param parameters:     tuner tunables
+ *  @param priority class: domain's priority class
+ *
+ *  @return movement coefficients of class, as tuned so far
+ */
+manager::tuner::coefficients_t
+manager::tuner::coefficients
+(
+    const manager::tuner::state_t        &state,
+    const manager::tuner::parameters_t   &parameters,
+          manager::reservation::priority  priority_class
+) noexcept
+{
+    if (!parameters.enabled)
+        return parameters.coefficients;
+
+    const auto coefficients = state.coefficients.find(priority_class);
+    if (coefficients == state.coefficients.end())
+        return parameters.coefficients;
+
+    return coefficients->second;
+}
+
+
+/**
+ *  @brief Action Watcher
+ *
+ *  @param state:          tuner state
+ *  @param parameters:     tuner tunables
+ *  @param datum:          domain action was issued to
+ *  @param priority class: domain's priority class
+ *  @param kind:           action issued
+ *  @param now:            time of this iteration
+ *
+ *  @details A domain's earliest action of a kind still awaiting judgement
+ *  is kept, such that consecutive steps are judged from the first
+ */
+void
+manager::tuner::watch
+(
+          manager::tuner::state_t               &state,
+    const manager::tuner::parameters_t          &parameters,
+    const libvirt::domain::datum_t              &datum,
+          manager::reservation::priority         priority_class,
+          manager::tuner::action                 kind,
+    const std::chrono::steady_clock::time_point &now
+) noexcept
+{
+    if (!parameters.enabled)
+        return;
+
+    try
+    {
+        const auto [watch, inserted] = state.watches.try_emplace(datum.uuid);
+        if (!inserted && watch->second.kind == kind)
+            return;
+
+        watch->second.kind           = kind;
+        watch->second.priority_class = priority_class;
+        watch->second.issued_at      = now;
+        watch->second.swap_in        = datum.swap_in;
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Unable to watch action issued to " + datum.uuid,
+            util::log::type::ERROR
+        );
+    }
+}
+
+
+/**
+ *  @brief Outcome Judge
+ *
+ *  @param state:      tuner state
+ *  @param parameters: tuner tunables
+ *  @param datum:      domain's current statistics
+ *  @param now:        time of this iteration
+ *  @param registry:   registry to count coefficient moves in
+ *
+ *  @details Judges the action awaiting judgement of a domain once settled;
+ *  a reclaim is bad if the guest swapped in since, and a grant if the
+ *  domain's unused memory is above its class's supply threshold. A class's
+ *  coefficients move once it has a window of judged outcomes.
+ */
+void
+manager::tuner::judge
+(
+          manager::tuner::state_t               &state,
+    const manager::tuner::parameters_t          &parameters,
+    const libvirt::domain::datum_t              &datum,
+    const std::chrono::steady_clock::time_point &now,
+          util::metric::registry_t              &registry
+) noexcept
+{
+    if (!parameters.enabled)
+        return;
+
+    const manager::tuner::watches_t::iterator watch
+        = state.watches.find(datum.uuid);
+    if (watch == state.watches.end()
+        || now - watch->second.issued_at < parameters.settle)
+        return;
+
+    const manager::tuner::watch_t outcome = watch->second;
+    state.watches.erase(watch);
+
+    manager::tuner::evidence_t &evidence
+        = state.evidence[outcome.priority_class];
+    if (outcome.kind == manager::tuner::action::RECLAIM)
+    {
+        // Guests not reporting swap give no evidence
+        if (datum.swap_in < 0 || outcome.swap_in < 0)
+            return;
+
+        ++evidence.reclaims;
+        evidence.swapped += datum.swap_in > outcome.swap_in;
+    }
+    else
+    {
+        const manager::tuner::coefficients_t coefficients
+            = manager::tuner::coefficients
+              (
+                  state, parameters, outcome.priority_class
+              );
+
+        ++evidence.grants;
+        evidence.unused += static_cast<std::double_t>(datum.domain_memory_extra)
+            > coefficients.supply
+            * static_cast<std::double_t>(datum.domain_memory_limit);
+    }
+
+    if (evidence.reclaims + evidence.grants >= parameters.window)
+        adjust(state, parameters, outcome.priority_class, registry);
+}
+
+
+/**
+ *  @brief Coefficient Exporter
+ *
+ *  @param state:      tuner state
+ *  @param parameters: tuner tunables
+ *  @param registry:   registry to publish coefficients in
+ */
+void
+manager::tuner::export_coefficients
+(
+    const manager::tuner::state_t      &state,
+    const manager::tuner::parameters_t &parameters,
+          util::metric::registry_t     &registry
+) noexcept
+{
+    for
+    (
+        const manager::reservation::priority priority_class:
+        {
+            manager::reservation::priority::LATENCY_CRITICAL,
+            manager::reservation::priority::GUARANTEED,
+            manager::reservation::priority::BEST_EFFORT
+        }
+    )
+    {
+        const manager::tuner::coefficients_t coefficients
+            = manager::tuner::coefficients(state, parameters, priority_class);
+        const std::string name = class_name(priority_class);
+        for
+        (
+            const auto &[coefficient, value]:
+            {
+                std::make_pair("supply", coefficients.supply),
+                std::make_pair("demand", coefficients.demand),
+                std::make_pair("change", coefficients.change)
+            }
+        )
+        {
+            util::metric::set
+            (
+                registry, "memoryman_tuner_coefficient",
+                "Movement coefficients of each priority class",
+                {{"class", name}, {"coefficient", coefficient}}, value
+            );
+        }
+    }
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+
+#include <metric/registry.hpp>
+#include <stat/statistics.hpp>
+
+#include "domain/domain.hpp"
+
+#include "reservation.hpp"
+
+
+/**
+ *  @brief Coefficient Tuner Header
+ *
+ *  @details Defines the feedback tuning of the supply, demand and change
+ *  coefficients of each priority class from the outcomes of the reclaims and
+ *  grants issued under them
+ */
+namespace manager
+{
+
+namespace tuner
+{
+
+// Movement coefficients; supply and demand thresholds as fractions of a
+// domain's memory limit, and change as the fraction of the minimum domain
+// memory moved per fixed step
+typedef struct coefficients_t
+{
+    std::double_t supply = 0.115;
+    std::double_t demand = 0.085;
+    std::double_t change = 0.200;
+} coefficients_t;
+
+// Action whose outcome is judged
+enum class action: std::uint8_t
+{
+    RECLAIM = 0x00,
+    GRANT   = 0x01
+};
+
+// Tunables; coefficients are those used untuned and tuning starts from, a
+// reclaim followed by guest swap-in or a grant leaving memory above the
+// supply threshold after the settle time is a bad outcome, and every window
+// of outcomes of a class moves its coefficients by the step should the share
+// of bad outcomes exceed the target, or back should it stay under half
+typedef struct parameters_t
+{
+    bool                 enabled = false;
+    coefficients_t       coefficients;
+    coefficients_t       lower   = {0.050, 0.030, 0.050};
+    coefficients_t       upper   = {0.300, 0.200, 0.500};
+    std::double_t        step    = 0.005;
+    std::double_t        gap     = 0.010;
+    std::chrono::seconds settle  = std::chrono::seconds(30);
+    std::size_t          window  = 16;
+    std::double_t        target  = 0.100;
+} parameters_t;
+
+// Latest action issued to a domain awaiting judgement
+typedef struct watch_t
+{
+    action                                kind = action::RECLAIM;
+    reservation::priority                 priority_class
+        = reservation::priority::BEST_EFFORT;
+    std::chrono::steady_clock::time_point issued_at;
+    util::stat::slong_t                   swap_in = 0;
+} watch_t;
+
+// Outcomes of a class judged since its coefficients last moved
+typedef struct evidence_t
+{
+    std::size_t reclaims = 0;
+    std::size_t swapped  = 0;
+    std::size_t grants   = 0;
+    std::size_t unused   = 0;
+} evidence_t;
+
+using watches_t = std::unordered_map<libvirt::domain::uuid_t, watch_t>;
+
+// Coefficients and evidence of each class, and actions awaiting judgement
+typedef struct state_t
+{
+    watches_t                                       watches;
+    std::map<reservation::priority, coefficients_t> coefficients;
+    std::map<reservation::priority, evidence_t>     evidence;
+} state_t;
+
+// Coefficient tuning routines
+[[nodiscard("Must use class coefficients to call")]]
+coefficients_t
+coefficients
+(
+    const state_t               &state,
+    const parameters_t          &parameters,
+          reservation::priority  priority_class
+) noexcept;
+
+void
+watch
+(
+          state_t                               &state,
+    const parameters_t                          &parameters,
+    const libvirt::domain::datum_t              &datum,
+          reservation::priority                  priority_class,
+          action                                 kind,
+    const std::chrono::steady_clock::time_point &now
+) noexcept;
+
+void
+judge
+(
+          state_t                               &state,
+    const parameters_t                          &parameters,
+    const libvirt::domain::datum_t              &datum,
+    const std::chrono::steady_clock::time_point &now,
+          util::metric::registry_t              &registry
+) noexcept;
+
+void
+export_coefficients
+(
+    const state_t                  &state,
+    const parameters_t             &parameters,
+          util::metric::registry_t &registry
+) noexcept;
+
+} // tuner namespace
+
+} // manager namespace
@@ -0,0 +1,111 @@
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include <log/record.hpp>
+
+#include "config.hpp"
+
+
+/**
+ *  @brief Trim Surrounding Whitespace
+ *
+ *  @param string: string to trim
+ *
+ *  @return string without leading and trailing whitespace
+ */
+std::string
+static trim
+(
+    const std::string &string
+) noexcept
+{
+    const std::string whitespace = " \t\r\n";
+
+    const std::size_t first = string.find_first_not_of(whitespace);
+    if (first == std::string::npos)
+        return std::string();
+
+    const std::size_t last = string.find_last_not_of(whitespace);
+
+    return string.substr(first, last - first + 1);
+}
+
+
+/**
+ *  @brief Configuration File Loader
+ *
+ *  @param path:  path to configuration file
+ *  @param table: structure reference to write to
+ *
+ *  @details Reads every "key = value" line of the file into the table, where
+ *  blank lines and anything following a comment character are ignored and
+ *  later assignments of a key override earlier ones
+ *
+ *  @return execution status code
+ */
+util::conf::status_code
+util::conf::load
+(
+    const std::string         &path,
+          util::conf::table_t &table
+) noexcept
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        util::log::record
+        (
+            "Unable to open configuration file " + path,
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    std::string line;
+    std::size_t line_number = 0;
+    while (std::getline(file, line))
+    {
+        ++line_number;
+
+        // Drop comments and skip blank lines
+        const std::size_t comment = line.find(util::conf::COMMENT);
+        if (comment != std::string::npos)
+            line.erase(comment);
+
+        line = trim(line);
+        if (line.empty())
+            continue;
+
+        // Split on assignment
+        const std::size_t assignment = line.find(util::conf::ASSIGNMENT);
+        if (assignment == std::string::npos)
+        {
+            util::log::record
+            (
+                "Configuration line " + std::to_string(line_number)
+                    + " of " + path + " has no assignment; skipping",
+                util::log::type::FLAG
+            );
+
+            continue;
+        }
+
+        const util::conf::key_t key = trim(line.substr(0, assignment));
+        if (key.empty())
+        {
+            util::log::record
+            (
+                "Configuration line " + std::to_string(line_number)
+                    + " of " + path + " has no key; skipping",
+                util::log::type::FLAG
+            );
+
+            continue;
+        }
+        table[key] = trim(line.substr(assignment + 1));
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+#include <log/record.hpp>
+
+
+/**
+ *  @brief Configuration Utility Header
+ *
+ *  @details Defines data types and routines to read runtime tunables from a
+ *  plain "key = value" configuration file
+ */
+namespace util
+{
+
+namespace conf
+{
+
+using status_code = std::uint8_t;
+
+// data and structure types
+using key_t   = std::string;
+using table_t = std::unordered_map<key_t, std::string>;
+
+// Comment and assignment characters
+constexpr char COMMENT    = '#';
+constexpr char ASSIGNMENT = '=';
+
+// Read configuration file into table
+[[nodiscard("Configuration load status must be checked")]]
+status_code
+load
+(
+    const std::string &path,
+          table_t     &table
+) noexcept;
+
+
+/**
+ *  @brief Configuration Value Lookup
+ *
+ *  @param table:    configuration table to look through
+ *  @param key:      key of tunable
+ *  @param fallback: value to use when key is absent or malformed
+ *
+ *  @details Converts the string value of a key into the requested type,
+ *  where booleans accept true/false, on/off, yes/no, and 1/0
+ *
+ *  @return converted value or fallback
+ */
+template <typename value_t>
+[[nodiscard("Must use configuration value to call")]]
+value_t
+value
+(
+    const table_t &table,
+    const key_t   &key,
+    const value_t &fallback
+) noexcept
+{
+    const table_t::const_iterator entry = table.find(key);
+    if (entry == table.end())
+        return fallback;
+
+    const std::string &string = entry->second;
+    if constexpr (std::is_same_v<value_t, std::string>)
+        return string;
+
+    else if constexpr (std::is_same_v<value_t, bool>)
+    {
+        if (string == "true" || string == "on" || string == "yes"
+            || string == "1")
+            return true;
+
+        if (string == "false" || string == "off" || string == "no"
+            || string == "0")
+            return false;
+    }
+
+    else
+    {
+        std::istringstream stream(string);
+        value_t converted;
+        if (stream >> converted && stream.eof())
+            return converted;
+    }
+
+    util::log::record
+    (
+        "Configuration value \"" + string + "\" of " + key
+            + " is malformed; using default",
+        util::log::type::FLAG
+    );
+
+    return fallback;
+}
+
+} // conf namespace
+
+} // util namespace
@@ -0,0 +1,351 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include <log/record.hpp>
+
+#include "registry.hpp"
+
+
+/**
+ *  @brief Metric Family Lookup
+ *
+ *  @param registry: registry to look through
+ *  @param name:     metric name
+ *  @param help:     metric description
+ *  @param kind:     metric type
+ *
+ *  @details Creates the family on first use
+ *
+ *  @return family reference, or null when name is taken by another type
+ */
+util::metric::family_t
+static *family
+(
+          util::metric::registry_t &registry,
+    const util::metric::name_t     &name,
+    const std::string              &help,
+          util::metric::type        kind
+) noexcept
+{
+    const auto [entry, created] = registry.try_emplace(name);
+    util::metric::family_t &family = entry->second;
+    if (created)
+    {
+        family.kind = kind;
+        family.help = help;
+    }
+
+    if (family.kind != kind)
+    {
+        util::log::record
+        (
+            "Metric " + name + " is already registered with another type",
+            util::log::type::FLAG
+        );
+
+        return nullptr;
+    }
+
+    return &family;
+}
+
+
+/**
+ *  @brief Sample Value Formatter
+ *
+ *  @param value: sample value
+ *
+ *  @return value as exposition format expects
+ */
+std::string
+static format
+(
+    std::double_t value
+) noexcept
+{
+    if (std::isnan(value))
+        return "NaN";
+    if (std::isinf(value))
+        return value > 0 ? "+Inf" : "-Inf";
+
+    std::ostringstream stream;
+    stream << std::setprecision(12) << value;
+
+    return stream.str();
+}
+
+
+/**
+ *  @brief Label Set Formatter
+ *
+ *  @param labels: label names and values
+ *  @param extra:  additional label appended last, such as a bucket bound
+ *
+ *  @details Escapes backslashes, quotes and newlines of label values
+ *
+ *  @return label set in braces, or nothing when no labels
+ */
+std::string
+static format
+(
+    const util::metric::labels_t &labels,
+    const std::string            &extra = std::string()
+) noexcept
+{
+    if (labels.empty() && extra.empty())
+        return std::string();
+
+    std::string formatted = "{";
+    for (const auto &[label, value]: labels)
+    {
+        if (formatted.size() > 1)
+            formatted += ",";
+
+        formatted += label + "=\"";
+        for (const char character: value)
+        {
+            if (character == '\\' || character == '"')
+                formatted += '\\';
+            if (character == '\n')
+            {
+                formatted += "\\n";
+                continue;
+            }
+            formatted += character;
+        }
+        formatted += "\"";
+    }
+    if (!extra.empty())
+    {
+        if (formatted.size() > 1)
+            formatted += ",";
+        formatted += extra;
+    }
+
+    return formatted + "}";
+}
+
+
+/**
+ *  @brief Gauge Setter
+ *
+ *  @param registry: registry to update
+ *  @param name:     metric name
+ *  @param help:     metric description
+ *  @param labels:   labels of series
+ *  @param value:    current value
+ */
+void
+util::metric::set
+(
+          util::metric::registry_t &registry,
+    const util::metric::name_t     &name,
+    const std::string              &help,
+    const util::metric::labels_t   &labels,
+          std::double_t             value
+) noexcept
+{
+    util::metric::family_t *gauge
+        = family(registry, name, help, util::metric::type::GAUGE);
+    if (gauge == nullptr)
+        return;
+
+    gauge->series[labels].value = value;
+}
+
+
+/**
+ *  @brief Counter Incrementer
+ *
+ *  @param registry: registry to update
+ *  @param name:     metric name
+ *  @param help:     metric description
+ *  @param labels:   labels of series
+ *  @param amount:   non-negative amount to count
+ */
+void
+util::metric::increment
+(
+          util::metric::registry_t &registry,
+    const util::metric::name_t     &name,
+    const std::string              &help,
+    const util::metric::labels_t   &labels,
+          std::double_t             amount
+) noexcept
+{
+    util::metric::family_t *counter
+        = family(registry, name, help, util::metric::type::COUNTER);
+    if (counter == nullptr || amount < 0)
+        return;
+
+    counter->series[labels].value += amount;
+}
+
+
+/**
+ *  @brief Histogram Observer
+ *
+ *  @param registry: registry to update
+ *  @param name:     metric name
+ *  @param help:     metric description
+ *  @param bounds:   increasing bucket upper bounds, used on first observation
+ *  @param labels:   labels of series
+ *  @param value:    observed value
+ */
+void
+util::metric::observe
+(
+          util::metric::registry_t &registry,
+    const util::metric::name_t     &name,
+    const std::string              &help,
+    const util::metric::bounds_t   &bounds,
+    const util::metric::labels_t   &labels,
+          std::double_t             value
+) noexcept
+{
+    util::metric::family_t *histogram
+        = family(registry, name, help, util::metric::type::HISTOGRAM);
+    if (histogram == nullptr)
+        return;
+
+    if (histogram->bounds.empty())
+        histogram->bounds = bounds;
+
+    util::metric::series_t &series = histogram->series[labels];
+    series.buckets.resize(histogram->bounds.size(), 0);
+    for (std::size_t bucket = 0; bucket < histogram->bounds.size(); ++bucket)
+    {
+        if (value <= histogram->bounds[bucket])
+            ++series.buckets[bucket];
+    }
+    series.sum += value;
+    ++series.count;
+}
+
+
+/**
+ *  @brief Metric Family Clearer
+ *
+ *  @param registry: registry to update
+ *  @param name:     metric name
+ *
+ *  @details Drops every series of a family, such as series of domains no
+ *  longer running, keeping its type and description
+ */
+void
+util::metric::clear
+(
+          util::metric::registry_t &registry,
+    const util::metric::name_t     &name
+) noexcept
+{
+    util::metric::registry_t::iterator entry = registry.find(name);
+    if (entry != registry.end())
+        entry->second.series.clear();
+}
+
+
+/**
+ *  @brief Metric Registry Writer
+ *
+ *  @param registry: registry to export
+ *  @param path:     exposition file path
+ *
+ *  @details Writes every family in the text exposition format to a temporary
+ *  file then renames it over the path, such that a collector never reads a
+ *  partially written file
+ *
+ *  @return execution status code
+ */
+util::metric::status_code
+util::metric::write
+(
+    const util::metric::registry_t &registry,
+    const std::string              &path
+) noexcept
+{
+    const std::string temporary_path = path + ".tmp";
+    std::ofstream file(temporary_path, std::ios::trunc);
+    if (!file.is_open())
+    {
+        util::log::record
+        (
+            "Unable to open metric file " + temporary_path,
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    for (const auto &[name, family]: registry)
+    {
+        if (family.series.empty())
+            continue;
+
+        file << "# HELP " << name << " " << family.help << "\n";
+        switch (family.kind)
+        {
+            case util::metric::type::COUNTER:
+                file << "# TYPE " << name << " counter\n";
+                break;
+
+            case util::metric::type::GAUGE:
+                file << "# TYPE " << name << " gauge\n";
+                break;
+
+            case util::metric::type::HISTOGRAM:
+                file << "# TYPE " << name << " histogram\n";
+                break;
+        }
+
+        for (const auto &[labels, series]: family.series)
+        {
+            if (family.kind != util::metric::type::HISTOGRAM)
+            {
+                file << name << format(labels) << " "
+                     << format(series.value) << "\n";
+
+                continue;
+            }
+
+            for (std::size_t bucket = 0; bucket < series.buckets.size();
+                 ++bucket)
+            {
+                file << name << "_bucket"
+                     << format
+                        (
+                            labels,
+                            "le=\"" + format(family.bounds[bucket]) + "\""
+                        )
+                     << " " << series.buckets[bucket] << "\n";
+            }
+            file << name << "_bucket" << format(labels, "le=\"+Inf\"")
+                 << " " << series.count << "\n";
+            file << name << "_sum"   << format(labels)
+                 << " " << format(series.sum) << "\n";
+            file << name << "_count" << format(labels)
+                 << " " << series.count << "\n";
+        }
+    }
+
+    file.close();
+    if (file.fail() || std::rename(temporary_path.c_str(), path.c_str()))
+    {
+        util::log::record
+        (
+            "Unable to write metric file " + path,
+            util::log::type::ERROR
+        );
+
+        std::remove(temporary_path.c_str());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
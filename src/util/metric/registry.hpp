@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+
+/**
+ *  @brief Metric Registry Utility Header
+ *
+ *  @details Defines data types and routines to keep counters, gauges and
+ *  histograms and to export them in the Prometheus text exposition format,
+ *  as read by the node exporter's textfile collector
+ */
+namespace util
+{
+
+namespace metric
+{
+
+using status_code = std::uint8_t;
+
+// data and structure types
+using name_t   = std::string;
+using labels_t = std::map<std::string, std::string>;
+using bounds_t = std::vector<std::double_t>;
+
+enum class type: std::uint8_t
+{
+    COUNTER   = 0x00,
+    GAUGE     = 0x01,
+    HISTOGRAM = 0x02
+};
+
+// Single labelled series; buckets are cumulative as exported
+typedef struct series_t
+{
+    std::double_t              value = 0.0;
+    std::vector<std::uint64_t> buckets;
+    std::double_t              sum   = 0.0;
+    std::uint64_t              count = 0;
+} series_t;
+
+typedef struct family_t
+{
+    type                         kind = type::GAUGE;
+    std::string                  help;
+    bounds_t                     bounds;
+    std::map<labels_t, series_t> series;
+} family_t;
+
+using registry_t = std::map<name_t, family_t>;
+
+// Registry update routines
+void
+set
+(
+          registry_t  &registry,
+    const name_t      &name,
+    const std::string &help,
+    const labels_t    &labels,
+          std::double_t value
+) noexcept;
+
+void
+increment
+(
+          registry_t  &registry,
+    const name_t      &name,
+    const std::string &help,
+    const labels_t    &labels,
+          std::double_t amount = 1.0
+) noexcept;
+
+void
+observe
+(
+          registry_t  &registry,
+    const name_t      &name,
+    const std::string &help,
+    const bounds_t    &bounds,
+    const labels_t    &labels,
+          std::double_t value
+) noexcept;
+
+void
+clear
+(
+          registry_t &registry,
+    const name_t     &name
+) noexcept;
+
+// Write registry to file atomically
+[[nodiscard("Metric export status must be checked")]]
+status_code
+write
+(
+    const registry_t  &registry,
+    const std::string &path
+) noexcept;
+
+} // metric namespace
+
+} // util namespace
@@ -0,0 +1,312 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <log/record.hpp>
+
+#include "pool.hpp"
+
+
+using steady_clock = std::chrono::steady_clock;
+
+
+// Workers of all batches stuck in calls given up on
+static std::atomic<std::size_t> number_of_abandoned_workers(0);
+
+
+// Batch shared between caller and worker threads; workers stuck in a timed
+// out call keep it alive until they return
+typedef struct batch_t
+{
+    util::task::tasks_t                   tasks;
+    util::task::parameters_t              parameters;
+    std::mutex                            mutex;
+    std::condition_variable               condition;
+    std::size_t                           next    = 0;
+    std::size_t                           workers = 0;
+    std::vector<bool>                     started;
+    std::vector<bool>                     finished;
+    std::vector<steady_clock::time_point> started_at;
+    util::task::results_t                 results;
+} batch_t;
+
+
+/**
+ *  @brief Task Pool Worker
+ *
+ *  @param batch: batch of tasks to take from
+ *
+ *  @details Takes tasks from the batch until none are left, retrying failed
+ *  calls after a backoff. A worker returning from a call the caller already
+ *  gave up on exits without taking more tasks, whether or not it was
+ *  replaced.
+ */
+void
+static work
+(
+    std::shared_ptr<batch_t> batch
+) noexcept
+{
+    while (true)
+    {
+        std::size_t index;
+        {
+            std::lock_guard<std::mutex> lock(batch->mutex);
+            if (batch->next >= batch->tasks.size())
+                return;
+
+            index = batch->next++;
+            batch->started[index]    = true;
+            batch->started_at[index] = steady_clock::now();
+        }
+
+        // Call task until success or out of attempts
+        util::task::result_t result;
+        const steady_clock::time_point begin = steady_clock::now();
+        const std::size_t number_of_retries
+            = batch->parameters.number_of_retries;
+        for (std::size_t attempt = 0; attempt <= number_of_retries; ++attempt)
+        {
+            ++result.attempts;
+
+            util::task::status_code status;
+            try
+            {
+                status = batch->tasks[index]();
+            }
+
+            catch (const std::exception &exception)
+            {
+                status = EXIT_FAILURE;
+            }
+
+            if (!static_cast<bool>(status))
+            {
+                result.status = util::task::outcome::SUCCESS;
+                break;
+            }
+            if (attempt < number_of_retries)
+                std::this_thread::sleep_for(batch->parameters.backoff);
+        }
+        result.latency = std::chrono::duration_cast<std::chrono::microseconds>
+        (
+            steady_clock::now() - begin
+        );
+
+        // Report result unless caller timed task out
+        bool replaced;
+        {
+            std::lock_guard<std::mutex> lock(batch->mutex);
+            replaced = batch->finished[index];
+            if (!replaced)
+            {
+                batch->results[index]  = result;
+                batch->finished[index] = true;
+            }
+        }
+        batch->condition.notify_all();
+
+        if (replaced)
+        {
+            --number_of_abandoned_workers;
+            return;
+        }
+    }
+}
+
+
+/**
+ *  @brief Task Pool Worker Launcher
+ *
+ *  @param batch: batch of tasks for worker to take from
+ *
+ *  @return whether worker was launched
+ */
+bool
+static launch
+(
+    const std::shared_ptr<batch_t> &batch
+) noexcept
+{
+    try
+    {
+        std::thread(work, batch).detach();
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Unable to launch task pool worker thread",
+            util::log::type::FLAG
+        );
+
+        return false;
+    }
+
+    return true;
+}
+
+
+/**
+ *  @brief Task Pool Runner
+ *
+ *  @param tasks:      batch of independent calls to run
+ *  @param parameters: pool size, retries, backoff, and per call timeout
+ *  @param results:    structure reference to write to
+ *
+ *  @details Runs every task on a pool of worker threads and waits for each
+ *  to succeed, fail after its retries, or time out. A call still running past
+ *  its timeout is given up on and its worker is replaced, such that one hung
+ *  call delays neither the caller nor the remaining tasks.
+ *
+ *  Workers are no longer replaced once the configured number are stuck in
+ *  calls given up on, so a hung hypervisor cannot pile up threads. Tasks left
+ *  without a worker to take them time out without being called.
+ *
+ *  Results are in the same order as the tasks.
+ *
+ *  @return execution status code
+ */
+util::task::status_code
+util::task::run
+(
+    const util::task::tasks_t      &tasks,
+    const util::task::parameters_t &parameters,
+          util::task::results_t    &results
+) noexcept
+{
+    const std::size_t number_of_tasks = tasks.size();
+    results.assign(number_of_tasks, util::task::result_t());
+    if (number_of_tasks == 0)
+        return EXIT_SUCCESS;
+
+    // Share batch with workers
+    std::shared_ptr<batch_t> batch;
+    try
+    {
+        batch = std::make_shared<batch_t>();
+        batch->tasks      = tasks;
+        batch->parameters = parameters;
+        batch->started.assign(number_of_tasks, false);
+        batch->finished.assign(number_of_tasks, false);
+        batch->started_at.resize(number_of_tasks);
+        batch->results.resize(number_of_tasks);
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Unable to allocate task pool batch",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Launch workers
+    const std::size_t number_of_workers = std::clamp
+    (
+        parameters.number_of_workers,
+        static_cast<std::size_t>(1),
+        number_of_tasks
+    );
+    std::size_t number_of_launched_workers = 0;
+    for (std::size_t worker = 0; worker < number_of_workers; ++worker)
+        number_of_launched_workers += launch(batch);
+    if (number_of_launched_workers == 0)
+    {
+        util::log::record
+        (
+            "Unable to launch any task pool worker threads",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Wait for every task to finish or time out
+    std::unique_lock<std::mutex> lock(batch->mutex);
+    batch->workers = number_of_launched_workers;
+    while (true)
+    {
+        const steady_clock::time_point now = steady_clock::now();
+        steady_clock::time_point wake = now + parameters.timeout;
+
+        bool pending = false;
+        for (std::size_t index = 0; index < number_of_tasks; ++index)
+        {
+            if (batch->finished[index])
+                continue;
+
+            // Tasks are started in order, so none after this one will be
+            if (!batch->started[index])
+            {
+                if (batch->workers == 0)
+                {
+                    util::log::record
+                    (
+                        "Unable to run " + std::to_string
+                        (
+                            number_of_tasks - index
+                        ) + " tasks with every task pool worker stuck",
+                        util::log::type::FLAG
+                    );
+
+                    for (; index < number_of_tasks; ++index)
+                    {
+                        batch->results[index].status
+                            = util::task::outcome::TIMEOUT;
+                        batch->finished[index] = true;
+                    }
+                    batch->next = number_of_tasks;
+
+                    break;
+                }
+
+                pending = true;
+                continue;
+            }
+
+            // Give up on call and replace its worker
+            const steady_clock::time_point deadline
+                = batch->started_at[index] + parameters.timeout;
+            if (now >= deadline)
+            {
+                util::task::result_t &result = batch->results[index];
+                result.status  = util::task::outcome::TIMEOUT;
+                result.latency = std::chrono::duration_cast
+                <
+                    std::chrono::microseconds
+                >(now - batch->started_at[index]);
+                batch->finished[index] = true;
+
+                // Replace worker unless too many are stuck already
+                --batch->workers;
+                const std::size_t abandoned = number_of_abandoned_workers++;
+                if (abandoned < parameters.number_of_abandoned && launch(batch))
+                    ++batch->workers;
+
+                continue;
+            }
+            pending = true;
+            wake    = std::min(wake, deadline);
+        }
+        if (!pending)
+            break;
+
+        batch->condition.wait_until(lock, wake);
+    }
+    results = batch->results;
+
+    return EXIT_SUCCESS;
+}
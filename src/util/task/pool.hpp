@@ -0,0 +1,69 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+
+/**
+ *  @brief Task Pool Utility Header
+ *
+ *  @details Defines data types and routines to run a batch of independent,
+ *  possibly blocking, calls concurrently on a small pool of worker threads
+ *  with per call timeouts and retries
+ */
+namespace util
+{
+
+namespace task
+{
+
+using status_code = std::uint8_t;
+
+// data and structure types
+using task_t  = std::function<status_code ()>;
+using tasks_t = std::vector<task_t>;
+
+enum class outcome: std::uint8_t
+{
+    SUCCESS = 0x00,
+    FAILURE = 0x01,
+    TIMEOUT = 0x02
+};
+
+// Tunables; timeout covers all attempts of a call, and workers stuck in
+// calls given up on are only replaced while fewer than number_of_abandoned
+// are stuck across all batches
+typedef struct parameters_t
+{
+    std::size_t               number_of_workers   = 8;
+    std::size_t               number_of_retries   = 1;
+    std::size_t               number_of_abandoned = 32;
+    std::chrono::milliseconds timeout = std::chrono::milliseconds(5000);
+    std::chrono::milliseconds backoff = std::chrono::milliseconds(50);
+} parameters_t;
+
+typedef struct result_t
+{
+    outcome                   status   = outcome::FAILURE;
+    std::size_t               attempts = 0;
+    std::chrono::microseconds latency  = std::chrono::microseconds(0);
+} result_t;
+
+using results_t = std::vector<result_t>;
+
+// Run batch of tasks to completion or timeout
+[[nodiscard("Task pool exit status must be checked")]]
+status_code
+run
+(
+    const tasks_t      &tasks,
+    const parameters_t &parameters,
+          results_t    &results
+) noexcept;
+
+} // task namespace
+
+} // util namespace
@@ -0,0 +1,276 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <log/record.hpp>
+#include <task/pool.hpp>
+
+#include "domain/domain.hpp"
+
+#include "actuator.hpp"
+
+
+// Synthetic balloon driver latencies; one in sixteen guests is slow
+static constexpr std::size_t  SEED                 = 0x5eed;
+static constexpr std::size_t  SLOW_DOMAIN_RATIO    = 16;
+static constexpr std::int64_t FAST_LATENCY_MINIMUM = 1;
+static constexpr std::int64_t FAST_LATENCY_MAXIMUM = 8;
+static constexpr std::int64_t SLOW_LATENCY         = 120;
+
+static const std::vector<std::size_t> DOMAIN_COUNTS = {1, 8, 32, 128};
+
+
+/**
+ *  @brief Synthetic Balloon Tasks
+ *
+ *  @param number_of_domains: number of balloon targets to apply
+ *
+ *  @details Each task sleeps as long as a balloon driver takes to reach its
+ *  target; the same seed yields the same latencies for every run
+ *
+ *  @return tasks standing in for balloon calls
+ */
+util::task::tasks_t
+static balloon_tasks
+(
+    std::size_t number_of_domains
+)
+{
+    std::mt19937_64 generator(SEED + number_of_domains);
+    std::uniform_int_distribution<std::int64_t> fast_latency
+    (
+        FAST_LATENCY_MINIMUM, FAST_LATENCY_MAXIMUM
+    );
+
+    util::task::tasks_t tasks;
+    tasks.reserve(number_of_domains);
+    for (std::size_t domain = 0; domain < number_of_domains; ++domain)
+    {
+        const std::chrono::milliseconds latency
+        (
+            generator() % SLOW_DOMAIN_RATIO == 0
+                ? SLOW_LATENCY
+                : fast_latency(generator)
+        );
+
+        tasks.emplace_back
+        (
+            [latency]() -> util::task::status_code
+            {
+                std::this_thread::sleep_for(latency);
+                return EXIT_SUCCESS;
+            }
+        );
+    }
+
+    return tasks;
+}
+
+
+int
+main()
+{
+    util::task::parameters_t parameters;
+    parameters.timeout = std::chrono::milliseconds(1000);
+
+    util::log::record
+    (
+        "domains, serial apply (ms), pooled apply (ms), speedup"
+    );
+
+    for (const std::size_t number_of_domains: DOMAIN_COUNTS)
+    {
+        const util::task::tasks_t tasks = balloon_tasks(number_of_domains);
+
+        // Apply one domain after another
+        std::chrono::steady_clock::time_point begin
+            = std::chrono::steady_clock::now();
+        for (const util::task::task_t &task: tasks)
+        {
+            if (static_cast<bool>(task()))
+                return EXIT_FAILURE;
+        }
+        const std::chrono::duration<double, std::milli> serial
+            = std::chrono::steady_clock::now() - begin;
+
+        // Apply all domains on worker pool
+        util::task::results_t results;
+        begin = std::chrono::steady_clock::now();
+        if (static_cast<bool>(util::task::run(tasks, parameters, results)))
+        {
+            util::log::record
+            (
+                "Unable to run balloon tasks on worker pool",
+                util::log::type::ERROR
+            );
+
+            return EXIT_FAILURE;
+        }
+        const std::chrono::duration<double, std::milli> pooled
+            = std::chrono::steady_clock::now() - begin;
+
+        // Every target must be reached
+        for (const util::task::result_t &result: results)
+        {
+            if (result.status != util::task::outcome::SUCCESS)
+            {
+                util::log::record
+                (
+                    "Balloon task did not succeed on worker pool",
+                    util::log::type::ERROR
+                );
+
+                return EXIT_FAILURE;
+            }
+        }
+
+        util::log::record
+        (
+            std::to_string(number_of_domains) + ", "
+                + std::to_string(serial.count()) + ", "
+                + std::to_string(pooled.count()) + ", "
+                + std::to_string(serial.count() / pooled.count())
+        );
+    }
+
+    // A hung balloon call must time out without holding up the others
+    util::task::tasks_t tasks = balloon_tasks(DOMAIN_COUNTS.back());
+    tasks.front() = []() -> util::task::status_code
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(3000));
+        return EXIT_SUCCESS;
+    };
+
+    util::task::results_t results;
+    const std::chrono::steady_clock::time_point begin
+        = std::chrono::steady_clock::now();
+    if (static_cast<bool>(util::task::run(tasks, parameters, results)))
+        return EXIT_FAILURE;
+    const std::chrono::duration<double, std::milli> pooled
+        = std::chrono::steady_clock::now() - begin;
+
+    std::size_t number_of_timeouts = 0;
+    for (const util::task::result_t &result: results)
+        number_of_timeouts += result.status == util::task::outcome::TIMEOUT;
+    if (results.front().status != util::task::outcome::TIMEOUT
+        || number_of_timeouts != 1 || pooled > 2 * parameters.timeout)
+    {
+        util::log::record
+        (
+            "Hung balloon task was not timed out on its own",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    util::log::record
+    (
+        "Hung domain timed out; pooled apply of "
+            + std::to_string(DOMAIN_COUNTS.back()) + " domains took "
+            + std::to_string(pooled.count()) + " ms"
+    );
+
+    // Workers stuck in hung calls must only be replaced up to the limit
+    util::task::parameters_t capped;
+    capped.number_of_workers   = 2;
+    capped.number_of_retries   = 0;
+    capped.number_of_abandoned = 4;
+    capped.timeout             = std::chrono::milliseconds(100);
+
+    const std::shared_ptr<std::atomic<std::size_t>> calls
+        = std::make_shared<std::atomic<std::size_t>>(0);
+    tasks.assign
+    (
+        DOMAIN_COUNTS.back(),
+        [calls]() -> util::task::status_code
+        {
+            ++*calls;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+            return EXIT_SUCCESS;
+        }
+    );
+    if (static_cast<bool>(util::task::run(tasks, capped, results)))
+        return EXIT_FAILURE;
+
+    number_of_timeouts = 0;
+    for (const util::task::result_t &result: results)
+        number_of_timeouts += result.status == util::task::outcome::TIMEOUT;
+    const std::size_t calls_limit
+        = capped.number_of_workers + capped.number_of_abandoned;
+    if (number_of_timeouts != tasks.size() || calls->load() > calls_limit)
+    {
+        util::log::record
+        (
+            "Hung balloon tasks were given more workers than the limit",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    util::log::record
+    (
+        "Hung domains left " + std::to_string(calls->load())
+            + " of " + std::to_string(tasks.size()) + " calls issued"
+    );
+
+    // A domain whose call was given up on is not called again until it
+    // returns, so a stale target cannot land after a newer one
+    const std::shared_ptr<std::atomic<std::size_t>> setter_calls
+        = std::make_shared<std::atomic<std::size_t>>(0);
+    manager::actuator::hook
+    (
+        [setter_calls]
+        (
+            const libvirt::domain::uuid_t &,
+            util::stat::slong_t
+        ) -> manager::actuator::status_code
+        {
+            ++*setter_calls;
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            return EXIT_SUCCESS;
+        }
+    );
+
+    libvirt::domain::datum_t datum;
+    datum.uuid = "hung";
+    const manager::actuator::requests_t requests = {{&datum, 1 << 20}};
+
+    capped.number_of_workers = 1;
+    manager::actuator::outcomes_t outcomes;
+    bool ordered = !static_cast<bool>
+    (
+        manager::actuator::apply(requests, capped, outcomes)
+    ) && outcomes[0].status == util::task::outcome::TIMEOUT;
+    ordered &= !static_cast<bool>
+    (
+        manager::actuator::apply(requests, capped, outcomes)
+    ) && setter_calls->load() == 1;
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    ordered &= !static_cast<bool>
+    (
+        manager::actuator::apply(requests, capped, outcomes)
+    ) && setter_calls->load() == 2;
+    manager::actuator::hook(manager::actuator::setter_t());
+    if (!ordered)
+    {
+        util::log::record
+        (
+            "Domain with a balloon call in flight was called again",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,225 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <log/record.hpp>
+#include <stat/statistics.hpp>
+
+#include "allocator.hpp"
+
+
+// Synthetic demanders; memory in KiB as the scheduler sees it
+static constexpr std::size_t         SEED               = 0x5eed;
+static constexpr util::stat::slong_t MINIMUM_REQUEST    = 1 << 10;
+static constexpr util::stat::slong_t MAXIMUM_REQUEST    = 512 << 10;
+static constexpr util::stat::slong_t MAXIMUM_GUARANTEE  = 64 << 10;
+static constexpr std::size_t         GUARANTEE_RATIO    = 4;
+static constexpr std::double_t       SUPPLY_FRACTION    = 0.400;
+static constexpr std::size_t         NUMBER_OF_REPEATS  = 10;
+
+static const std::vector<std::size_t> DOMAIN_COUNTS
+    = {1000, 4000, 16000, 64000};
+
+
+/**
+ *  @brief Synthetic Memory Claims
+ *
+ *  @param number_of_domains: number of demanders
+ *
+ *  @details One in four domains is below its guaranteed minimum; the same
+ *  seed yields the same claims for every run
+ *
+ *  @return claims of demanders
+ */
+manager::allocator::claims_t
+static synthetic_claims
+(
+    std::size_t number_of_domains
+)
+{
+    std::mt19937_64 generator(SEED + number_of_domains);
+    std::uniform_int_distribution<util::stat::slong_t> request
+    (
+        MINIMUM_REQUEST, MAXIMUM_REQUEST
+    );
+    std::uniform_int_distribution<util::stat::slong_t> guarantee
+    (
+        0, MAXIMUM_GUARANTEE
+    );
+    std::uniform_real_distribution<std::double_t> pressure(0.0, 1.0);
+
+    manager::allocator::claims_t claims(number_of_domains);
+    for (manager::allocator::claim_t &claim: claims)
+    {
+        claim.request   = request(generator);
+        claim.guarantee = generator() % GUARANTEE_RATIO == 0
+            ? guarantee(generator)
+            : 0;
+        claim.weight    = 1.0 + pressure(generator);
+    }
+
+    return claims;
+}
+
+
+/**
+ *  @brief Max-Min Fairness Check
+ *
+ *  @param claims: claims divided
+ *  @param supply: memory divided
+ *  @param shares: division to check
+ *  @param given:  memory reported given out
+ *
+ *  @details Shares must not exceed requests or supply, must cover the
+ *  guarantees, and every claim left short must sit at the same water level
+ *  per weight, with no fully served claim above it
+ *
+ *  @return whether division is max-min fair
+ */
+bool
+static fair
+(
+    const manager::allocator::claims_t &claims,
+          util::stat::slong_t           supply,
+    const manager::allocator::shares_t &shares,
+          util::stat::slong_t           given
+)
+{
+    const util::stat::slong_t total = std::accumulate
+    (
+        shares.begin(), shares.end(), static_cast<util::stat::slong_t>(0)
+    );
+    if (total != given || given > supply)
+        return false;
+
+    // Every share is within its request and covers its guarantee
+    std::double_t level = -1;
+    for (std::size_t claim = 0; claim < claims.size(); ++claim)
+    {
+        const util::stat::slong_t guarantee
+            = std::min(claims[claim].guarantee, claims[claim].request);
+        if (shares[claim] > claims[claim].request || shares[claim] < guarantee)
+            return false;
+
+        if (shares[claim] < claims[claim].request)
+        {
+            level = std::max
+            (
+                level, (shares[claim] - guarantee) / claims[claim].weight
+            );
+        }
+    }
+
+    // Supply ran out only if some claim is short
+    if (level < 0)
+        return true;
+    if (supply - given > static_cast<util::stat::slong_t>(claims.size()))
+        return false;
+
+    // Claims short of their request share one level; rounding allows a KiB
+    for (std::size_t claim = 0; claim < claims.size(); ++claim)
+    {
+        const util::stat::slong_t guarantee
+            = std::min(claims[claim].guarantee, claims[claim].request);
+        const std::double_t claim_level
+            = (shares[claim] - guarantee) / claims[claim].weight;
+
+        if (shares[claim] < claims[claim].request
+            && claim_level < level - 1 / claims[claim].weight - 1e-6)
+            return false;
+        if (claim_level > level + 1e-6)
+            return false;
+    }
+
+    return true;
+}
+
+
+int
+main()
+{
+    util::log::record("domains, water-fill (us), memory short (%)");
+
+    for (const std::size_t number_of_domains: DOMAIN_COUNTS)
+    {
+        const manager::allocator::claims_t claims
+            = synthetic_claims(number_of_domains);
+
+        util::stat::slong_t total_request = 0;
+        for (const manager::allocator::claim_t &claim: claims)
+            total_request += claim.request;
+        const util::stat::slong_t supply = static_cast<util::stat::slong_t>
+        (
+            SUPPLY_FRACTION * total_request
+        );
+
+        // Divide repeatedly to time
+        manager::allocator::shares_t shares;
+        util::stat::slong_t given = 0;
+        const std::chrono::steady_clock::time_point begin
+            = std::chrono::steady_clock::now();
+        for (std::size_t repeat = 0; repeat < NUMBER_OF_REPEATS; ++repeat)
+            given = manager::allocator::water_fill(claims, supply, shares);
+        const std::chrono::duration<double, std::micro> elapsed
+            = std::chrono::steady_clock::now() - begin;
+
+        if (!fair(claims, supply, shares, given))
+        {
+            util::log::record
+            (
+                "Division of " + std::to_string(number_of_domains)
+                    + " domains is not max-min fair",
+                util::log::type::ERROR
+            );
+
+            return EXIT_FAILURE;
+        }
+
+        // Division must not depend on order of domains
+        std::vector<std::size_t> order(number_of_domains);
+        std::iota(order.begin(), order.end(), 0);
+        std::shuffle(order.begin(), order.end(), std::mt19937_64(SEED));
+
+        manager::allocator::claims_t shuffled_claims(number_of_domains);
+        for (std::size_t position = 0; position < number_of_domains; ++position)
+            shuffled_claims[position] = claims[order[position]];
+
+        manager::allocator::shares_t shuffled_shares;
+        manager::allocator::water_fill
+        (
+            shuffled_claims, supply, shuffled_shares
+        );
+        for (std::size_t position = 0; position < number_of_domains; ++position)
+        {
+            if (shuffled_shares[position] != shares[order[position]])
+            {
+                util::log::record
+                (
+                    "Division of " + std::to_string(number_of_domains)
+                        + " domains depends on their order",
+                    util::log::type::ERROR
+                );
+
+                return EXIT_FAILURE;
+            }
+        }
+
+        util::log::record
+        (
+            std::to_string(number_of_domains) + ", "
+                + std::to_string(elapsed.count() / NUMBER_OF_REPEATS) + ", "
+                + std::to_string
+                  (
+                      100.0 * (total_request - given) / total_request
+                  )
+        );
+    }
+
+    return EXIT_SUCCESS;
+}
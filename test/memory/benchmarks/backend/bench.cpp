@@ -0,0 +1,287 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <string>
+
+#include <backend/backend.hpp>
+#include <backend/mock.hpp>
+#include <lib/libvirt.hpp>
+#include <log/record.hpp>
+#include <registry/registry.hpp>
+#include <stat/statistics.hpp>
+
+#include "cpuman.hpp"
+#include "memoryman.hpp"
+
+#include "check.hpp"
+
+
+// Simulated host; memory in KiB
+static constexpr std::size_t         NUMBER_OF_DOMAINS = 10000;
+static constexpr std::size_t         NUMBER_OF_PCPUS   = 256;
+static constexpr util::stat::ulong_t MEMORY_LIMIT      = 4 << 20;
+static constexpr util::stat::ulong_t INITIAL_MEMORY    = 2 << 20;
+
+// Load balancer iterations driven per path
+static constexpr std::size_t NUMBER_OF_ITERATIONS = 8;
+
+// Calls neither backend can answer are left out of the run
+static const std::string CONFIGURATION =
+    "numa.enabled = false\n"
+    "reservation.enabled = false\n"
+    "attributes.events = false\n";
+
+
+/**
+ *  @brief Scripted Load
+ *
+ *  @param domain rank: rank of domain on host
+ *  @param step:        host step
+ *
+ *  @details Every third domain outgrows its balloon while every other third
+ *  idles, and domains first pinned on the lowest quarter of pCPUs keep their
+ *  vCPUs busy, leaving those pCPUs loaded well above the rest
+ *
+ *  @return domain's load at step
+ */
+libvirt::mock::load_t
+static script
+(
+    std::size_t         domain_rank,
+    util::stat::ulong_t /* step */
+)
+{
+    libvirt::mock::load_t load;
+
+    switch (domain_rank % 3)
+    {
+        case 0:
+            load.memory_used = INITIAL_MEMORY + (INITIAL_MEMORY / 2);
+            break;
+        case 1:
+            load.memory_used = INITIAL_MEMORY / 4;
+            break;
+        default:
+            load.memory_used = INITIAL_MEMORY / 2;
+            break;
+    }
+
+    // Domains' vCPUs are pinned in turn, two per domain
+    const std::size_t first_pCPU = (2 * domain_rank) % NUMBER_OF_PCPUS;
+    load.cpu_share = first_pCPU < NUMBER_OF_PCPUS / 4 ? 0.9 : 0.1;
+
+    return load;
+}
+
+
+/**
+ *  @brief Load Balancer Benchmark
+ *
+ *  @param host:     simulated host installed as the backend
+ *  @param balancer: load balancer path to drive
+ *  @param name:     path's name to report under
+ *
+ *  @details Steps the host between iterations, as time passing between
+ *  intervals would
+ *
+ *  @return whether every iteration succeeded
+ */
+template <typename balancer_t>
+bool
+static drive
+(
+          libvirt::mock::host_t &host,
+          balancer_t             balancer,
+    const std::string           &name
+)
+{
+    using std::chrono::steady_clock;
+
+    const util::stat::ulong_t calls = host.calls.load();
+    std::chrono::duration<double, std::milli> slowest(0), total(0);
+    for
+    (
+        std::size_t iteration = 0;
+        iteration < NUMBER_OF_ITERATIONS;
+        ++iteration
+    )
+    {
+        const steady_clock::time_point begin = steady_clock::now();
+        if (static_cast<bool>(balancer()))
+        {
+            util::log::record
+            (
+                name + " load balancer failed on iteration "
+                    + std::to_string(iteration),
+                util::log::type::ERROR
+            );
+
+            return false;
+        }
+        const std::chrono::duration<double, std::milli> elapsed
+            = steady_clock::now() - begin;
+
+        slowest = std::max(slowest, elapsed);
+        total  += elapsed;
+        libvirt::mock::advance(host);
+    }
+
+    util::log::record
+    (
+        name + ", " + std::to_string(NUMBER_OF_DOMAINS) + ", "
+            + std::to_string(total.count() / NUMBER_OF_ITERATIONS) + ", "
+            + std::to_string(slowest.count()) + ", "
+            + std::to_string
+              (
+                  (host.calls.load() - calls) / NUMBER_OF_ITERATIONS
+              )
+    );
+
+    return true;
+}
+
+
+/**
+ *  @brief End to End Checks
+ *
+ *  @details Drives both managers' load balancers over the simulated host,
+ *  expecting overloaded pCPUs to be relieved by repinning, the emergency
+ *  balancer to reclaim from idle domains, and hungry domains to be given
+ *  memory
+ *
+ *  @return whether all checks passed
+ */
+bool
+static backend_checks()
+{
+    // Memory manager reads its tunables from a configuration file
+    const std::string configuration = "backend_benchmark.conf";
+    std::ofstream(configuration) << CONFIGURATION;
+
+    manager::memory::parameters_t memory_parameters;
+    memory_parameters.configuration = configuration;
+    if (static_cast<bool>(manager::memory::configure(memory_parameters)))
+        return check(false, "memory manager configures");
+
+    // Install simulated host in place of libvirt
+    libvirt::mock::parameters_t parameters;
+    parameters.number_of_domains = NUMBER_OF_DOMAINS;
+    parameters.number_of_pCPUs   = NUMBER_OF_PCPUS;
+    parameters.memory_limit      = MEMORY_LIMIT;
+    parameters.initial_memory    = INITIAL_MEMORY;
+    parameters.step_period       = memory_parameters.interval;
+    parameters.script            = script;
+
+    libvirt::mock::host_t host;
+    if (static_cast<bool>(libvirt::mock::create(host, parameters)))
+        return check(false, "mock host is created");
+    libvirt::backend::install(libvirt::mock::backend(host));
+
+    // Managers share a connection, unused by the mock, and a registry
+    const libvirt::connection_t connection
+    (
+        nullptr, [](libvirt::virConnect *) {}
+    );
+    libvirt::registry::registry_t registry;
+
+    util::log::record
+    (
+        "path, domains, mean iteration (ms), slowest iteration (ms), "
+        "backend calls per iteration"
+    );
+
+    // CPU load balancer repins vCPUs off overloaded pCPUs
+    bool passed = check
+    (
+        drive
+        (
+            host,
+            [&]()
+            {
+                return manager::cpu::load_balancer(connection, registry);
+            },
+            "cpu"
+        ),
+        "CPU load balancer iterations succeed"
+    );
+    passed &= check(host.pins.load() > 0, "overloaded pCPUs are relieved");
+
+    // Emergency balancer reclaims from idle suppliers
+    passed &= check
+    (
+        drive
+        (
+            host,
+            [&]()
+            {
+                return manager::memory::emergency_balancer
+                (
+                    connection, registry
+                );
+            },
+            "emergency"
+        ),
+        "emergency balancer iterations succeed"
+    );
+    passed &= check(host.balloons.load() > 0, "memory is reclaimed");
+
+    // Memory load balancer grows hungry domains' balloons
+    passed &= check
+    (
+        drive
+        (
+            host,
+            [&]()
+            {
+                return manager::memory::load_balancer
+                (
+                    connection, registry, memory_parameters.interval
+                );
+            },
+            "memory"
+        ),
+        "memory load balancer iterations succeed"
+    );
+    passed &= check
+    (
+        host.domains[0].balloon > INITIAL_MEMORY,
+        "hungry domain is given memory"
+    );
+
+    libvirt::backend::install(libvirt::backend::native());
+    std::remove(configuration.c_str());
+
+    return passed;
+}
+
+
+int
+main()
+{
+    bool passed = false;
+    try
+    {
+        passed = backend_checks();
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Unable to build backend fixture",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+    if (!passed)
+        return EXIT_FAILURE;
+
+    util::log::record("Backend checks passed");
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,240 @@
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <log/record.hpp>
+#include <metric/registry.hpp>
+#include <stat/statistics.hpp>
+
+#include "cgroup/cgroup.hpp"
+#include "domain/domain.hpp"
+
+#include "backstop.hpp"
+#include "balloon.hpp"
+
+#include "check.hpp"
+
+
+// Fixture's domain; memory in KiB
+static constexpr util::stat::uint_t  DOMAIN_ID      = 3;
+static constexpr util::stat::slong_t INITIAL_MEMORY = 4 << 20;
+static constexpr util::stat::slong_t TARGET_MEMORY  = 3 << 20;
+
+
+/**
+ *  @brief Scope Writer
+ *
+ *  @param root: cgroup tree to write to
+ *  @param name: scope directory name
+ *
+ *  @return scope directory
+ */
+std::string
+static write_scope
+(
+    const std::string &root,
+    const std::string &name
+)
+{
+    const std::filesystem::path scope
+        = std::filesystem::path(root) / "machine.slice" / name;
+    std::filesystem::create_directories(scope);
+
+    std::ofstream(scope / os::cgroup::memory_high) << "max" << std::endl;
+    std::ofstream(scope / os::cgroup::memory_max)  << "max" << std::endl;
+
+    return scope.string();
+}
+
+
+/**
+ *  @brief Limit Reader
+ *
+ *  @param scope: scope directory
+ *  @param file:  memory controller file
+ *
+ *  @return limit as written
+ */
+std::string
+static read_limit
+(
+    const std::string &scope,
+    const std::string &file
+)
+{
+    std::ifstream stream(scope + "/" + file);
+    std::string limit;
+    stream >> limit;
+
+    return limit;
+}
+
+
+/**
+ *  @brief Backstop Checks
+ *
+ *  @param root: cgroup tree to build fixture in
+ *
+ *  @details Finds a domain's scope among scopes of similar IDs, then bounds
+ *  it through a stalled reclaim and lifts the bound through a grant
+ *
+ *  @return whether all checks passed
+ */
+bool
+static backstop_checks
+(
+    const std::string &root
+)
+{
+    std::filesystem::remove_all(root);
+    write_scope(root, "machine-qemu\\x2d31\\x2dother.scope");
+    const std::string scope
+        = write_scope(root, "machine-qemu\\x2d3\\x2dguest.scope");
+
+    // Scopes are matched by whole ID
+    std::string path;
+    os::cgroup::status_code status
+        = os::cgroup::scope(root, "machine.slice", DOMAIN_ID, path);
+    bool passed = check
+    (
+        !static_cast<bool>(status) && path == scope,
+        "scope is found by domain ID"
+    );
+    status = os::cgroup::scope(root, "machine.slice", 4, path);
+    passed &= check
+    (
+        static_cast<bool>(status) && path.empty(),
+        "missing scope is not found"
+    );
+
+    manager::backstop::parameters_t parameters;
+    parameters.enabled = true;
+    parameters.root    = root;
+    parameters.margin  = 128 << 10;
+
+    manager::backstop::state_t state;
+    state.path = scope;
+
+    libvirt::domain::datum_t datum;
+    datum.uuid                = "guest";
+    datum.balloon_memory_used = INITIAL_MEMORY;
+
+    manager::balloon::state_t balloon;
+    manager::balloon::issue(balloon, INITIAL_MEMORY, TARGET_MEMORY, {});
+
+    // Reclaim in flight is left to the balloon
+    util::metric::registry_t registry;
+    status = manager::backstop::enforce
+    (
+        state, parameters, balloon, datum, registry
+    );
+    passed &= check
+    (
+        !static_cast<bool>(status) && !state.engaged
+            && read_limit(scope, os::cgroup::memory_high) == "max",
+        "reclaim in flight is not bounded"
+    );
+
+    // Stalled reclaim bounds the scope to its target
+    balloon.pending = false;
+    ++balloon.stalls;
+    status = manager::backstop::enforce
+    (
+        state, parameters, balloon, datum, registry
+    );
+    const util::stat::slong_t limit = TARGET_MEMORY + parameters.overhead;
+    passed &= check
+    (
+        !static_cast<bool>(status) && state.engaged
+            && read_limit(scope, os::cgroup::memory_high)
+               == std::to_string(limit * 1024)
+            && read_limit(scope, os::cgroup::memory_max)
+               == std::to_string((limit + parameters.margin) * 1024),
+        "stalled reclaim bounds scope to target"
+    );
+
+    status = manager::backstop::enforce
+    (
+        state, parameters, balloon, datum, registry
+    );
+    passed &= check
+    (
+        !static_cast<bool>(status) && state.engaged,
+        "bound holds while guest stays above target"
+    );
+
+    // Grant lifts the bound
+    datum.balloon_memory_used = INITIAL_MEMORY;
+    manager::balloon::issue(balloon, INITIAL_MEMORY, 5 << 20, {});
+    status = manager::backstop::enforce
+    (
+        state, parameters, balloon, datum, registry
+    );
+    passed &= check
+    (
+        !static_cast<bool>(status) && !state.engaged
+            && read_limit(scope, os::cgroup::memory_high) == "max"
+            && read_limit(scope, os::cgroup::memory_max) == "max",
+        "grant lifts bound"
+    );
+
+    // Unwritable scope fails
+    state.path = root + "/missing";
+    manager::balloon::issue(balloon, INITIAL_MEMORY, TARGET_MEMORY, {});
+    balloon.pending = false;
+    ++balloon.stalls;
+    status = manager::backstop::enforce
+    (
+        state, parameters, balloon, datum, registry
+    );
+    passed &= check
+    (
+        static_cast<bool>(status) && !state.engaged,
+        "unwritable scope is not bounded"
+    );
+
+    std::filesystem::remove_all(root);
+
+    return passed;
+}
+
+
+int
+main(int argc, char *argv[])
+{
+    if (argc != 2)
+    {
+        util::log::record
+        (
+            "Usage: backstop_benchmark <cgroup directory>",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    bool passed = false;
+    try
+    {
+        passed = backstop_checks(argv[1]);
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Unable to build cgroup fixture under " + std::string(argv[1]),
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+    if (!passed)
+        return EXIT_FAILURE;
+
+    util::log::record("Backstop checks passed");
+
+    return EXIT_SUCCESS;
+}
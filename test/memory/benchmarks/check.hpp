@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+
+#include <log/record.hpp>
+
+
+/**
+ *  @brief Benchmark Check Header
+ *
+ *  @details Defines the reporter benchmarks log their failed checks through
+ */
+
+
+/**
+ *  @brief Check Reporter
+ *
+ *  @param passed: whether check passed
+ *  @param check:  description of check
+ *
+ *  @return whether check passed
+ */
+inline bool
+check
+(
+          bool         passed,
+    const std::string &check
+)
+{
+    if (!passed)
+        util::log::record("Check failed: " + check, util::log::type::ERROR);
+
+    return passed;
+}
@@ -0,0 +1,185 @@
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <string>
+
+#include <log/record.hpp>
+#include <metric/registry.hpp>
+#include <stat/statistics.hpp>
+
+#include "attribute/attribute.hpp"
+#include "domain/domain.hpp"
+
+#include "collector.hpp"
+
+#include "check.hpp"
+
+
+// Last balloon sizes of fixture's domains; memory in KiB
+static constexpr util::stat::slong_t KNOWN_MEMORY = 2 << 20;
+static constexpr util::stat::slong_t SLOW_MEMORY  = 3 << 20;
+
+
+/**
+ *  @brief Domain Table Builder
+ *
+ *  @param uuids: domains to list
+ *
+ *  @details Handles are left empty, so every statistics call fails at once
+ *  as a domain gone unresponsive would
+ *
+ *  @return UUID-to-domain table
+ */
+libvirt::domain::table_t
+static table
+(
+    const libvirt::domain::uuid_set_t &uuids
+)
+{
+    libvirt::domain::table_t domain_table;
+    for (const libvirt::domain::uuid_t &uuid: uuids)
+    {
+        domain_table[uuid] = libvirt::domain::domain_t
+        (
+            nullptr, [](libvirt::virDomain *) {}
+        );
+    }
+
+    return domain_table;
+}
+
+
+/**
+ *  @brief Collection Checks
+ *
+ *  @details Serves failing and slow domains from their last statistics,
+ *  keeps statistics of slow calls once they return, and leaves out failing
+ *  and slow domains never collected
+ *
+ *  @return whether all checks passed
+ */
+bool
+static collection_checks()
+{
+    manager::collector::parameters_t parameters;
+    parameters.deadline = std::chrono::milliseconds(100);
+
+    const libvirt::attribute::handle_t attribute_cache
+        = std::make_shared<libvirt::attribute::cache_t>();
+    util::metric::registry_t registry;
+
+    manager::collector::state_t state;
+    state.last["known"].uuid                = "known";
+    state.last["known"].balloon_memory_used = KNOWN_MEMORY;
+
+    // Failing domain is served from its last statistics
+    libvirt::domain::table_t domain_table = table({"known"});
+    libvirt::domain::data_t  domain_data;
+    manager::collector::status_code status = manager::collector::collect
+    (
+        state, parameters, domain_table, domain_data, attribute_cache,
+        registry
+    );
+    bool passed = check
+    (
+        !static_cast<bool>(status) && domain_data.size() == 1
+            && domain_data[0].stale
+            && domain_data[0].balloon_memory_used == KNOWN_MEMORY
+            && state.slow.empty(),
+        "failing domain is served stale"
+    );
+
+    // Slow domain in flight is not probed again
+    std::shared_ptr<manager::collector::probe_t> pending
+        = std::make_shared<manager::collector::probe_t>();
+    state.slow["slow"] = pending;
+
+    domain_table = table({"known", "slow"});
+    domain_data.clear();
+    status = manager::collector::collect
+    (
+        state, parameters, domain_table, domain_data, attribute_cache,
+        registry
+    );
+    passed &= check
+    (
+        !static_cast<bool>(status) && domain_data.size() == 1
+            && domain_data[0].uuid == "known"
+            && state.slow.count("slow") == 1
+            && state.slow["slow"] == pending,
+        "slow domain never collected is left out"
+    );
+
+    // Slow call returning is kept, and domain is probed again
+    pending->datum.uuid                = "slow";
+    pending->datum.balloon_memory_used = SLOW_MEMORY;
+    pending->status                    = EXIT_SUCCESS;
+    pending->done.store(true);
+
+    domain_table = table({"slow"});
+    domain_data.clear();
+    status = manager::collector::collect
+    (
+        state, parameters, domain_table, domain_data, attribute_cache,
+        registry
+    );
+    passed &= check
+    (
+        !static_cast<bool>(status) && domain_data.size() == 1
+            && domain_data[0].stale
+            && domain_data[0].balloon_memory_used == SLOW_MEMORY
+            && state.slow.empty(),
+        "returned slow call is kept"
+    );
+    passed &= check
+    (
+        state.last.count("known") == 0 && state.last.count("slow") == 1,
+        "domains gone from host are forgotten"
+    );
+
+    // Failing domain never collected is left out without failing the rest
+    domain_table = table({"slow", "new"});
+    domain_data.clear();
+    status = manager::collector::collect
+    (
+        state, parameters, domain_table, domain_data, attribute_cache,
+        registry
+    );
+    passed &= check
+    (
+        !static_cast<bool>(status) && domain_data.size() == 1
+            && domain_data[0].uuid == "slow",
+        "failing domain never collected is left out"
+    );
+
+    return passed;
+}
+
+
+int
+main()
+{
+    bool passed = false;
+    try
+    {
+        passed = collection_checks();
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Unable to build collection fixture",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+    if (!passed)
+        return EXIT_FAILURE;
+
+    util::log::record("Collection checks passed");
+
+    return EXIT_SUCCESS;
+}
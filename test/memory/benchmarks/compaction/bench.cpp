@@ -0,0 +1,229 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <log/record.hpp>
+#include <metric/registry.hpp>
+#include <stat/statistics.hpp>
+
+#include "buddy/buddy.hpp"
+
+#include "compaction.hpp"
+
+#include "check.hpp"
+
+
+// Fixture's free blocks by order; node 0 is fragmented, node 1 holds mostly
+// large blocks, and node 2 has nothing free
+static const std::string BUDDYINFO
+    = "Node 0, zone      DMA      1      1      1      0      2      1"
+      "      1      0      1      1      3\n"
+      "Node 0, zone   Normal   2000   1500    800    300     50      4"
+      "      0      0      0      0      0\n"
+      "Node 1, zone   Normal     10     10     10     10     10     10"
+      "     10     10     10    100    500\n"
+      "Node 2, zone   Normal      0      0      0      0      0      0"
+      "      0      0      0      0      0\n"
+      "malformed line\n";
+
+// Fragmentation index of node 0 for order 9, from its free pages
+static constexpr std::double_t FRAGMENTED_INDEX
+    = (15503.0 - 3584.0) / 15503.0;
+
+
+/**
+ *  @brief Compaction File Reader
+ *
+ *  @param path: compaction file
+ *
+ *  @return whether compaction was triggered through file
+ */
+bool
+static triggered
+(
+    const std::string &path
+)
+{
+    std::ifstream file(path);
+    std::string contents;
+    file >> contents;
+
+    return contents == "1";
+}
+
+
+/**
+ *  @brief Compaction File Writer
+ *
+ *  @param path: compaction file to create or reset
+ */
+void
+static reset
+(
+    const std::string &path
+)
+{
+    std::filesystem::create_directories
+    (
+        std::filesystem::path(path).parent_path()
+    );
+    std::ofstream file(path, std::ios::trunc);
+}
+
+
+/**
+ *  @brief Compaction Checks
+ *
+ *  @param root: directory to build fixtures in
+ *
+ *  @details Reads a buddy allocator fixture of three nodes and compacts the
+ *  fragmented one through its node's compact file, then through the host
+ *  wide file once the node's is gone
+ *
+ *  @return whether all checks passed
+ */
+bool
+static compaction_checks
+(
+    const std::string &root
+)
+{
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root);
+    std::ofstream(root + "/buddyinfo") << BUDDYINFO;
+
+    const std::string node_file = root + "/node/node0/compact";
+    const std::string host_file = root + "/compact_memory";
+    reset(node_file);
+    reset(host_file);
+
+    manager::compaction::parameters_t parameters;
+    parameters.enabled   = true;
+    parameters.buddyinfo = root + "/buddyinfo";
+    parameters.root      = root + "/node";
+    parameters.fallback  = host_file;
+
+    // Zones are read and indexed per node
+    util::metric::registry_t registry;
+    manager::compaction::state_t state;
+    manager::compaction::status_code status
+        = manager::compaction::sample(state, parameters, registry);
+    bool passed
+        = check(!static_cast<bool>(status), "buddy information is read");
+    passed &= check
+    (
+        state.zones.size() == 4 && state.zones[1].name == "Normal"
+            && state.zones[1].free_blocks.size() == 11,
+        "zones are read with free blocks of every order"
+    );
+    passed &= check
+    (
+        state.index.size() == 3
+            && std::abs(state.index[0] - FRAGMENTED_INDEX) < 1e-9
+            && state.index[1] < 0.050 && state.index[2] == 0.0,
+        "nodes are indexed by free memory below the compaction order"
+    );
+
+    // Only the fragmented node is compacted, once per interval
+    const std::chrono::steady_clock::time_point start
+        = std::chrono::steady_clock::now();
+    status = manager::compaction::compact(state, parameters, start, registry);
+    passed &= check
+    (
+        !static_cast<bool>(status) && triggered(node_file)
+            && !triggered(host_file),
+        "fragmented node is compacted through its compact file"
+    );
+    passed &= check
+    (
+        state.compacted_at.size() == 1 && state.compacted_at.count(0) == 1,
+        "only fragmented node is compacted"
+    );
+
+    reset(node_file);
+    status = manager::compaction::compact
+    (
+        state, parameters, start + parameters.interval / 2, registry
+    );
+    passed &= check
+    (
+        !static_cast<bool>(status) && !triggered(node_file),
+        "node is not compacted again within interval"
+    );
+
+    // Nodes without compact files are compacted host wide
+    std::filesystem::remove(node_file);
+    status = manager::compaction::compact
+    (
+        state, parameters, start + parameters.interval, registry
+    );
+    passed &= check
+    (
+        !static_cast<bool>(status) && triggered(host_file),
+        "host is compacted without node compact files"
+    );
+
+    // Missing buddy information compacts nothing
+    parameters.buddyinfo = root + "/missing";
+    status = manager::compaction::sample(state, parameters, registry);
+    passed &= check
+    (
+        static_cast<bool>(status) && !state.sampled && state.index.empty(),
+        "missing buddy information is not sampled"
+    );
+    status = manager::compaction::compact
+    (
+        state, parameters, start + 2 * parameters.interval, registry
+    );
+    passed &= check
+    (
+        static_cast<bool>(status), "unsampled nodes are not compacted"
+    );
+
+    std::filesystem::remove_all(root);
+
+    return passed;
+}
+
+
+int
+main(int argc, char *argv[])
+{
+    if (argc != 2)
+    {
+        util::log::record
+        (
+            "Usage: compaction_benchmark <fixture directory>",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    bool passed = false;
+    try
+    {
+        passed = compaction_checks(argv[1]);
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Unable to build fixtures under " + std::string(argv[1]),
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+    if (!passed)
+        return EXIT_FAILURE;
+
+    util::log::record("Compaction checks passed");
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,334 @@
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <lib/libvirt.hpp>
+#include <log/record.hpp>
+#include <stat/statistics.hpp>
+
+#include "domain/domain.hpp"
+#include "hotplug/hotplug.hpp"
+
+#include "actuator.hpp"
+#include "hotplug.hpp"
+
+#include "check.hpp"
+
+
+// Fixture's virtio-mem device; memory in KiB
+static constexpr util::stat::slong_t DEVICE_SIZE      = 16 << 20;
+static constexpr util::stat::slong_t DEVICE_BLOCK     = 2 << 10;
+static constexpr util::stat::slong_t DEVICE_REQUESTED = 4 << 20;
+static constexpr util::stat::slong_t DOMAIN_MEMORY    = 8 << 20;
+static constexpr util::stat::slong_t THRESHOLD        = 1 << 20;
+
+static const std::string TEST_DRIVER_URI = "test:///default";
+
+
+/**
+ *  @brief Fixture Device Checks
+ *
+ *  @param XML: domain definition of fixture
+ *
+ *  @details Parses the fixture's device, aligns requested sizes and parses
+ *  the device definition built for an update back
+ *
+ *  @return whether all checks passed
+ */
+bool
+static fixture_checks
+(
+    const std::string &xml
+)
+{
+    libvirt::hotplug::device_t device;
+    libvirt::status_code status = libvirt::hotplug::parse(xml, device);
+    bool passed = check(!static_cast<bool>(status), "fixture parses");
+    passed &= check(device.found, "fixture has a virtio-mem device");
+    passed &= check(device.size == DEVICE_SIZE, "size is read in GiB");
+    passed &= check(device.block == DEVICE_BLOCK, "block is read in MiB");
+    passed &= check(device.requested == DEVICE_REQUESTED, "requested size");
+    passed &= check(device.current == DEVICE_REQUESTED, "current size");
+    passed &= check(device.node == 0, "target node");
+    passed &= check(device.alias == "virtiomem0", "device alias");
+
+    // Whole blocks within the device only
+    passed &= check
+    (
+        libvirt::hotplug::align(device, DEVICE_REQUESTED + DEVICE_BLOCK + 1)
+            == DEVICE_REQUESTED + DEVICE_BLOCK,
+        "requested size rounds down to whole blocks"
+    );
+    passed &= check
+    (
+        libvirt::hotplug::align(device, 2 * DEVICE_SIZE) == DEVICE_SIZE,
+        "requested size is bounded by device size"
+    );
+    passed &= check
+    (
+        libvirt::hotplug::align(device, -DEVICE_BLOCK) == 0,
+        "requested size is not negative"
+    );
+
+    // Update definition carries new requested size
+    libvirt::hotplug::device_t updated;
+    status = libvirt::hotplug::parse
+    (
+        libvirt::hotplug::definition(device, 2 * DEVICE_REQUESTED), updated
+    );
+    passed &= check(!static_cast<bool>(status), "update definition parses");
+    passed &= check
+    (
+        updated.requested == 2 * DEVICE_REQUESTED
+            && updated.size == device.size && updated.block == device.block
+            && updated.node == device.node && updated.alias == device.alias,
+        "update definition matches device"
+    );
+
+    // Domains without a device are not an error
+    status = libvirt::hotplug::parse("<domain type='kvm'/>", updated);
+    passed &= check
+    (
+        !static_cast<bool>(status) && !updated.found,
+        "definition without device parses as no device"
+    );
+
+    return passed;
+}
+
+
+/**
+ *  @brief Routing Checks
+ *
+ *  @param XML: domain definition of fixture
+ *
+ *  @details Routes targets of a domain with the fixture's device and checks
+ *  which go to the balloon and which resize the device
+ *
+ *  @return whether all checks passed
+ */
+bool
+static routing_checks
+(
+    const std::string &xml
+)
+{
+    libvirt::domain::datum_t datum;
+    datum.uuid                = "6695eb01-f6a4-8304-79aa-97f2502e193f";
+    datum.balloon_memory_used = DOMAIN_MEMORY;
+    datum.domain_memory_limit = DOMAIN_MEMORY;
+
+    manager::hotplug::parameters_t parameters;
+    parameters.enabled   = true;
+    parameters.threshold = THRESHOLD;
+
+    manager::hotplug::table_t table;
+    libvirt::status_code status
+        = libvirt::hotplug::parse(xml, table[datum.uuid].device);
+    bool passed = check(!static_cast<bool>(status), "fixture parses");
+
+    manager::actuator::requests_t requests =
+    {
+        {&datum, DOMAIN_MEMORY - THRESHOLD / 2},
+        {&datum, DOMAIN_MEMORY - THRESHOLD - DEVICE_BLOCK / 2},
+        {&datum, DOMAIN_MEMORY + DEVICE_BLOCK + 1},
+        {&datum, DOMAIN_MEMORY + 2 * DEVICE_SIZE},
+        {&datum, DOMAIN_MEMORY + DEVICE_BLOCK / 2}
+    };
+    manager::hotplug::route(table, parameters, requests);
+
+    passed &= check
+    (
+        requests[0].device == nullptr
+            && requests[0].memory_chunk == DOMAIN_MEMORY - THRESHOLD / 2,
+        "small reclaim is ballooned"
+    );
+    passed &= check
+    (
+        requests[1].device != nullptr
+            && requests[1].memory_chunk == DOMAIN_MEMORY - THRESHOLD,
+        "large reclaim unplugs whole blocks, rounded toward current size"
+    );
+    passed &= check
+    (
+        requests[2].device != nullptr
+            && requests[2].memory_chunk == DOMAIN_MEMORY + DEVICE_BLOCK,
+        "growth past maximum memory plugs whole blocks"
+    );
+    passed &= check
+    (
+        requests[3].device != nullptr
+            && requests[3].memory_chunk
+                == DOMAIN_MEMORY + DEVICE_SIZE - DEVICE_REQUESTED,
+        "growth is bounded by device size"
+    );
+    passed &= check
+    (
+        requests[4].device == nullptr,
+        "growth smaller than a block stays with balloon"
+    );
+
+    // Headroom shrinks as blocks are committed
+    passed &= check
+    (
+        manager::hotplug::headroom(table, parameters, datum.uuid)
+            == DEVICE_SIZE - DEVICE_REQUESTED,
+        "headroom is device memory not yet requested"
+    );
+    manager::hotplug::commit(table, requests[2]);
+    passed &= check
+    (
+        table[datum.uuid].device.requested == DEVICE_REQUESTED + DEVICE_BLOCK,
+        "commit carries requested size into cached device"
+    );
+
+    parameters.enabled = false;
+    passed &= check
+    (
+        manager::hotplug::headroom(table, parameters, datum.uuid) == 0,
+        "disabled hotplug has no headroom"
+    );
+
+    return passed;
+}
+
+
+/**
+ *  @brief Test Driver Checks
+ *
+ *  @param XML: domain definition of fixture
+ *
+ *  @details Defines and starts the fixture on libvirt's test driver, then
+ *  discovers and resizes its device. Skipped when the test driver is not
+ *  available; a driver rejecting live device updates is flagged only.
+ *
+ *  @return whether all checks passed
+ */
+bool
+static driver_checks
+(
+    const std::string &xml
+)
+{
+    libvirt::virConnectPtr connection
+        = libvirt::virConnectOpen(TEST_DRIVER_URI.c_str());
+    if (connection == nullptr)
+    {
+        util::log::record
+        (
+            "Test driver unavailable; skipping live device checks",
+            util::log::type::FLAG
+        );
+
+        return true;
+    }
+
+    libvirt::domain::datum_t datum;
+    datum.uuid   = "6695eb01-f6a4-8304-79aa-97f2502e193f";
+    datum.domain = libvirt::domain::domain_t
+    (
+        libvirt::virDomainDefineXML(connection, xml.c_str()),
+        [](libvirt::virDomain *domain)
+        {
+            if (domain != nullptr)
+                libvirt::virDomainFree(domain);
+        }
+    );
+
+    bool passed = check(datum.domain != nullptr, "test driver defines fixture");
+    if (passed)
+    {
+        passed = check
+        (
+            !libvirt::virDomainCreate(datum.domain.get()),
+            "test driver starts fixture"
+        );
+    }
+
+    libvirt::hotplug::device_t device;
+    if (passed)
+    {
+        libvirt::status_code status
+            = libvirt::hotplug::discover(datum, device);
+        passed = check
+        (
+            !static_cast<bool>(status) && device.found
+                && device.requested == DEVICE_REQUESTED,
+            "device is discovered from live definition"
+        );
+    }
+
+    if (passed)
+    {
+        libvirt::status_code status = libvirt::hotplug::resize
+        (
+            datum.domain.get(), device, DEVICE_REQUESTED + THRESHOLD
+        );
+        if (static_cast<bool>(status))
+        {
+            util::log::record
+            (
+                "Test driver rejected live device update",
+                util::log::type::FLAG
+            );
+        }
+        else
+        {
+            status = libvirt::hotplug::discover(datum, device);
+            passed = check
+            (
+                !static_cast<bool>(status)
+                    && device.requested == DEVICE_REQUESTED + THRESHOLD,
+                "resized device reports new requested size"
+            );
+        }
+    }
+
+    datum.domain.reset();
+    libvirt::virConnectClose(connection);
+
+    return passed;
+}
+
+
+int
+main(int argc, char *argv[])
+{
+    if (argc != 2)
+    {
+        util::log::record
+        (
+            "Usage: hotplug_benchmark <domain.xml>",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream file(argv[1]);
+    if (!file.is_open())
+    {
+        util::log::record
+        (
+            "Unable to open domain fixture " + std::string(argv[1]),
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+    std::stringstream stream;
+    stream << file.rdbuf();
+    const std::string xml = stream.str();
+
+    const bool passed
+        =  fixture_checks(xml)
+        && routing_checks(xml)
+        && driver_checks(xml);
+    if (!passed)
+        return EXIT_FAILURE;
+
+    util::log::record("Hotplug checks passed");
+
+    return EXIT_SUCCESS;
+}
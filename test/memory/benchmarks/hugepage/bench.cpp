@@ -0,0 +1,302 @@
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <log/record.hpp>
+#include <metric/registry.hpp>
+#include <stat/statistics.hpp>
+
+#include "domain/domain.hpp"
+#include "hugepage/hugepage.hpp"
+
+#include "hugepage.hpp"
+
+#include "check.hpp"
+
+
+// Fixture's pools; page sizes in KiB and counts in pages
+static constexpr util::stat::slong_t SMALL_PAGE  = 2 << 10;
+static constexpr util::stat::slong_t LARGE_PAGE  = 1 << 20;
+static constexpr util::stat::ulong_t SMALL_PAGES = 10;
+static constexpr util::stat::ulong_t LARGE_PAGES = 2;
+static constexpr util::stat::ulong_t PAGES_USED  = 300;
+
+
+/**
+ *  @brief Pool Writer
+ *
+ *  @param root:      sysfs tree to write to
+ *  @param node:      pool's node
+ *  @param page size: pool's page size in KiB
+ *  @param total:     pages in pool
+ *  @param free:      pages free in pool
+ */
+void
+static write_pool
+(
+    const std::string         &root,
+          util::stat::sint_t   node,
+          util::stat::slong_t  page_size,
+          util::stat::ulong_t  total,
+          util::stat::ulong_t  free
+)
+{
+    const std::filesystem::path directory
+        = std::filesystem::path(root) / ("node" + std::to_string(node))
+        / "hugepages" / ("hugepages-" + std::to_string(page_size) + "kB");
+    std::filesystem::create_directories(directory);
+
+    std::ofstream(directory / "nr_hugepages")   << total << std::endl;
+    std::ofstream(directory / "free_hugepages") << free  << std::endl;
+}
+
+
+/**
+ *  @brief Pool Size Reader
+ *
+ *  @param root:      sysfs tree to read from
+ *  @param node:      pool's node
+ *  @param page size: pool's page size in KiB
+ *
+ *  @return pages pool was sized to
+ */
+util::stat::ulong_t
+static pool_size
+(
+    const std::string         &root,
+          util::stat::sint_t   node,
+          util::stat::slong_t  page_size
+)
+{
+    std::ifstream file
+    (
+        root + "/node" + std::to_string(node) + "/hugepages/hugepages-"
+            + std::to_string(page_size) + "kB/nr_hugepages"
+    );
+    util::stat::ulong_t pages = 0;
+    file >> pages;
+
+    return pages;
+}
+
+
+/**
+ *  @brief Memory Backing Checks
+ *
+ *  @details Parses hugepage backing of domain definitions
+ *
+ *  @return whether all checks passed
+ */
+bool
+static backing_checks()
+{
+    util::stat::slong_t size = 0;
+    libvirt::status_code status = libvirt::domain::memory_backing
+    (
+        "<domain><memoryBacking>\n  <hugepages>\n"
+        "    <page size='1' unit='GiB' nodeset='0'/>\n  </hugepages>\n"
+        "</memoryBacking></domain>",
+        size
+    );
+    bool passed = check
+    (
+        !static_cast<bool>(status) && size == LARGE_PAGE,
+        "page size is read in GiB"
+    );
+
+    status = libvirt::domain::memory_backing
+    (
+        "<domain><memoryBacking><hugepages/></memoryBacking></domain>", size
+    );
+    passed &= check
+    (
+        !static_cast<bool>(status)
+            && size == libvirt::domain::hugepage_default_size,
+        "hugepages without page size are of default size"
+    );
+
+    status = libvirt::domain::memory_backing
+    (
+        "<domain><memoryBacking><locked/></memoryBacking></domain>", size
+    );
+    passed &= check
+    (
+        !static_cast<bool>(status) && size == 0,
+        "backing without hugepages is not hugepage backed"
+    );
+
+    status = libvirt::domain::memory_backing("<domain/>", size);
+    passed &= check
+    (
+        !static_cast<bool>(status) && size == 0,
+        "definition without backing is not hugepage backed"
+    );
+
+    status = libvirt::domain::memory_backing
+    (
+        "<domain><memoryBacking><hugepages><page size='two'/></hugepages>"
+        "</memoryBacking></domain>",
+        size
+    );
+    passed &= check
+    (
+        static_cast<bool>(status)
+            && size == libvirt::domain::hugepage_default_size,
+        "malformed page size stays hugepage backed"
+    );
+
+    return passed;
+}
+
+
+/**
+ *  @brief Pool Checks
+ *
+ *  @param root: sysfs tree to build fixture in
+ *
+ *  @details Builds two nodes with pools of both page sizes, then sizes them
+ *  to a domain placed on the first node and an unplaced domain of default
+ *  page size
+ *
+ *  @return whether all checks passed
+ */
+bool
+static pool_checks
+(
+    const std::string &root
+)
+{
+    std::filesystem::remove_all(root);
+    for (util::stat::sint_t node = 0; node < 2; ++node)
+    {
+        write_pool(root, node, SMALL_PAGE, SMALL_PAGES, SMALL_PAGES);
+        write_pool(root, node, LARGE_PAGE, LARGE_PAGES, LARGE_PAGES);
+    }
+    std::filesystem::create_directories(root + "/cpu0");
+
+    manager::hugepage::parameters_t parameters;
+    parameters.enabled = true;
+    parameters.root    = root;
+
+    // Pools are read ordered with their free pages idle
+    manager::hugepage::state_t state;
+    const util::stat::slong_t memory_idle
+        = manager::hugepage::idle(state, parameters);
+    bool passed = check(state.sampled, "pools are read");
+    passed &= check(state.pools.size() == 4, "pools of both nodes are read");
+    passed &= check
+    (
+        state.pools.size() == 4 && state.pools[0].node == 0
+            && state.pools[0].page_size == SMALL_PAGE
+            && state.pools[3].node == 1
+            && state.pools[3].page_size == LARGE_PAGE,
+        "pools are ordered by node and page size"
+    );
+    passed &= check
+    (
+        memory_idle
+            == 2 * (SMALL_PAGES * SMALL_PAGE + LARGE_PAGES * LARGE_PAGE),
+        "free pages are idle memory"
+    );
+
+    // Placed and unplaced domains
+    libvirt::domain::datum_t placed;
+    placed.hugepage_size       = SMALL_PAGE;
+    placed.domain_memory_limit = 8 << 20;
+    placed.cells               = {0};
+
+    libvirt::domain::datum_t unplaced;
+    unplaced.hugepage_size       = libvirt::domain::hugepage_default_size;
+    unplaced.domain_memory_limit = (1 << 20) + 1;
+
+    manager::hugepage::demands_t demands;
+    manager::hugepage::reserve(demands, parameters, placed);
+    manager::hugepage::reserve(demands, parameters, unplaced);
+    passed &= check
+    (
+        demands.size() == 2 && demands[0].pages == 4096
+            && demands[1].pages == 513 && demands[1].page_size == SMALL_PAGE,
+        "domains reserve their memory in whole pages"
+    );
+
+    util::metric::registry_t registry;
+    manager::hugepage::status_code status
+        = manager::hugepage::balance(state, parameters, demands, registry);
+    passed &= check(!static_cast<bool>(status), "pools are resized");
+    passed &= check
+    (
+        pool_size(root, 0, SMALL_PAGE) == 4096 + 257
+            && pool_size(root, 1, SMALL_PAGE) == 256,
+        "pools follow reservations of placed and unplaced domains"
+    );
+    passed &= check
+    (
+        pool_size(root, 0, LARGE_PAGE) == LARGE_PAGES
+            && pool_size(root, 1, LARGE_PAGE) == LARGE_PAGES,
+        "pools of sizes no domain uses are left as configured"
+    );
+
+    // Pages in use are never freed
+    write_pool(root, 1, SMALL_PAGE, PAGES_USED, 0);
+    status = os::hugepage::read(root, state.pools);
+    passed &= check(!static_cast<bool>(status), "pools are reread");
+    status = manager::hugepage::balance(state, parameters, demands, registry);
+    passed &= check
+    (
+        !static_cast<bool>(status)
+            && pool_size(root, 1, SMALL_PAGE) == PAGES_USED,
+        "pools do not shrink below pages in use"
+    );
+
+    // Missing tree fails without resizing
+    parameters.root = root + "/missing";
+    static_cast<void>(manager::hugepage::idle(state, parameters));
+    passed &= check(!state.sampled, "missing tree is not sampled");
+    status = manager::hugepage::balance(state, parameters, demands, registry);
+    passed &= check(static_cast<bool>(status), "unsampled pools are not sized");
+
+    std::filesystem::remove_all(root);
+
+    return passed;
+}
+
+
+int
+main(int argc, char *argv[])
+{
+    if (argc != 2)
+    {
+        util::log::record
+        (
+            "Usage: hugepage_benchmark <sysfs directory>",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    bool passed = false;
+    try
+    {
+        passed = backing_checks() && pool_checks(argv[1]);
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Unable to build sysfs fixture under " + std::string(argv[1]),
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+    if (!passed)
+        return EXIT_FAILURE;
+
+    util::log::record("Hugepage checks passed");
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,240 @@
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <log/record.hpp>
+#include <stat/statistics.hpp>
+
+#include "sys/policy.hpp"
+
+#include "model.hpp"
+#include "trace.hpp"
+
+
+// Testcase guests; memory in KiB
+static constexpr std::size_t         GUESTS         = 4;
+static constexpr util::stat::slong_t MEMORY_LIMIT   = 4 << 20;
+static constexpr util::stat::slong_t INITIAL_MEMORY = 512 << 10;
+static constexpr util::stat::slong_t IDLE_SET       = 256 << 10;
+static constexpr util::stat::slong_t GROWN_SET      = 1536 << 10;
+
+
+/**
+ *  @brief Report Equality
+ *
+ *  @param report_A: first report
+ *  @param report_B: second report
+ *
+ *  @return whether both runs behaved identically
+ */
+bool
+static identical
+(
+    const simulator::model::report_t &report_A,
+    const simulator::model::report_t &report_B
+)
+{
+    return report_A.intervals           == report_B.intervals
+        && report_A.disturbances        == report_B.disturbances
+        && report_A.convergences        == report_B.convergences
+        && report_A.mean_convergence    == report_B.mean_convergence
+        && report_A.maximum_convergence == report_B.maximum_convergence
+        && report_A.peak_guest_swap     == report_B.peak_guest_swap
+        && report_A.peak_host_swap      == report_B.peak_host_swap
+        && report_A.balloon_operations  == report_B.balloon_operations;
+}
+
+
+/**
+ *  @brief Policy Simulation
+ *
+ *  @param name:   policy name to report under
+ *  @param trace:  working set trace to replay
+ *  @param policy: scheduler tunables under test
+ *  @param report: outcome of the run
+ *
+ *  @details Replays the trace twice, which must behave identically, and
+ *  reports the run
+ *
+ *  @return whether replay was deterministic
+ */
+bool
+static simulate
+(
+    const std::string                &name,
+    const simulator::trace::trace_t  &trace,
+    const manager::policy_t          &policy,
+          simulator::model::report_t &report
+)
+{
+    const simulator::model::parameters_t parameters;
+    simulator::model::report_t report_A, report_B;
+    simulator::model::status_code status_A
+        = simulator::model::run(trace, parameters, policy, report_A);
+    simulator::model::status_code status_B
+        = simulator::model::run(trace, parameters, policy, report_B);
+    if (static_cast<bool>(status_A) || static_cast<bool>(status_B))
+        return false;
+
+    if (!identical(report_A, report_B))
+    {
+        util::log::record
+        (
+            "Replay of " + name + " policy is not deterministic",
+            util::log::type::ERROR
+        );
+
+        return false;
+    }
+
+    util::log::record
+    (
+        name + ", " 
+            + std::to_string(report_A.convergences) + "/"
+            + std::to_string(report_A.disturbances) + ", "
+            + std::to_string(report_A.mean_convergence) + ", "
+            + std::to_string(report_A.maximum_convergence) + ", "
+            + std::to_string(report_A.peak_guest_swap) + ", "
+            + std::to_string(report_A.peak_host_swap) + ", "
+            + std::to_string(report_A.overcommit_ratio) + ", "
+            + std::to_string(report_A.operations_per_hour)
+    );
+    report = report_A;
+
+    return true;
+}
+
+
+/**
+ *  @brief Testcase Trace
+ *
+ *  @param flip:  whether every other guest exits at its barrier, as in
+ *                flip_exit, rather than all growing, as in even_split
+ *  @param trace: trace to build
+ *
+ *  @details Models the guests of the memory testcases on a host of half
+ *  their total limit, each started at 512 MiB and suddenly needing several
+ *  times that shortly after, but for flip_exit's barrier guests stopping
+ *  512 MiB on and exiting some time after
+ */
+void
+static testcase
+(
+    bool                       flip,
+    simulator::trace::trace_t &trace
+)
+{
+    trace.host_memory = GUESTS * MEMORY_LIMIT / 2;
+    trace.length      = 180;
+    for (std::size_t guest = 0; guest < GUESTS; ++guest)
+    {
+        trace.guests.push_back
+        (
+            {"test-" + std::to_string(guest), MEMORY_LIMIT, INITIAL_MEMORY}
+        );
+        trace.points.push_back({0, guest, IDLE_SET});
+    }
+    for (std::size_t guest = 0; guest < GUESTS; ++guest)
+    {
+        const bool barrier = flip && guest % 2 == 0;
+        trace.points.push_back
+        (
+            {10, guest, barrier ? IDLE_SET + INITIAL_MEMORY : GROWN_SET}
+        );
+    }
+    for (std::size_t guest = 0; flip && guest < GUESTS; guest += 2)
+        trace.points.push_back({60, guest, IDLE_SET});
+}
+
+
+int
+main(int argc, char *argv[])
+{
+    if (argc != 2)
+    {
+        util::log::record
+        (
+            "Usage follows as ./simulation_benchmark <trace>",
+            util::log::type::ERROR
+        );
+
+        return EXIT_FAILURE;
+    }
+
+    // Recorded, synthetic and testcase traces
+    std::vector<std::pair<std::string, simulator::trace::trace_t>> traces(4);
+    traces[0].first  = "recorded";
+    traces[1].first  = "synthetic";
+    traces[2].first  = "even_split";
+    traces[3].first  = "flip_exit";
+    testcase(false, traces[2].second);
+    testcase(true,  traces[3].second);
+    if (static_cast<bool>(simulator::trace::load(argv[1], traces[0].second))
+        || static_cast<bool>
+           (
+               simulator::trace::synthesize({}, traces[1].second)
+           ))
+        return EXIT_FAILURE;
+
+    // Policies to compare
+    std::vector<std::pair<std::string, manager::policy_t>> policies(5);
+    policies[0].first = "default";
+    policies[1].first = "fixed-step";
+    policies[1].second.controller.enabled = false;
+    policies[2].first = "no-pressure";
+    policies[2].second.pressure.enabled = false;
+    policies[3].first = "no-hysteresis";
+    policies[3].second.hysteresis.enabled = false;
+    policies[4].first = "tuned";
+    policies[4].second.tuner.enabled = true;
+    for (auto &[name, policy]: policies)
+        policy.reservation.metadata_uri.clear();
+
+    util::log::record
+    (
+        "trace/policy, converged/disturbances, mean convergence (s), "
+        "maximum convergence (s), peak guest swap (KiB), "
+        "peak host swap (KiB), overcommit ratio, balloon operations per hour"
+    );
+    std::vector<std::vector<simulator::model::report_t>> reports
+    (
+        traces.size(), std::vector<simulator::model::report_t>(policies.size())
+    );
+    for (std::size_t trace = 0; trace < traces.size(); ++trace)
+    {
+        for (std::size_t policy = 0; policy < policies.size(); ++policy)
+        {
+            const std::string name 
+                = traces[trace].first + "/" + policies[policy].first;
+            if (!simulate
+                 (
+                     name, traces[trace].second, policies[policy].second,
+                     reports[trace][policy]
+                 ))
+                return EXIT_FAILURE;
+        }
+    }
+
+    // Controller converges the testcases no slower than fixed steps
+    for (std::size_t trace = 2; trace < traces.size(); ++trace)
+    {
+        const simulator::model::report_t &controller = reports[trace][0];
+        const simulator::model::report_t &stepped    = reports[trace][1];
+        if (controller.convergences < stepped.convergences
+            || controller.mean_convergence > stepped.mean_convergence)
+        {
+            util::log::record
+            (
+                "Controller converges " + traces[trace].first 
+                    + " slower than fixed steps",
+                util::log::type::ERROR
+            );
+
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}